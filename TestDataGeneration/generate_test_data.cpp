@@ -0,0 +1,209 @@
+// generate_test_data.cpp: Entry point of the native test data generator.
+// This file parses the generator options, writes the input file with WordGenerator and
+// stores the exact unique count next to it for validating word_counter.
+
+#include "file_handle.hpp"
+#include "word_generator.hpp"
+#include <cctype>
+#include <cstdint>
+#include <cstdlib>
+#include <string>
+#include <string.h>
+#include <unistd.h>
+#include <vector>
+
+namespace {
+
+// Size suffixes, each 1024 times the previous one.
+constexpr char SIZE_SUFFIXES[] = "KMG";
+
+// Suffix of the file holding the expected unique count.
+constexpr char EXPECTED_SUFFIX[] = ".expected";
+
+// Case: Preset matching a generate_test.py scenario.
+struct Case {
+    size_t bytes;      // Output size (0 when words is set).
+    size_t words;      // Exact word count (0 to generate by size).
+    size_t vocabulary; // Distinct words to draw from.
+};
+
+// Presets of cases 1 to 5, indexed by case number.
+constexpr Case CASES[] = {{0, 0, 0},
+                          {0, 1000000, 1000},
+                          {1ULL << 30, 0, 100000},
+                          {10ULL << 30, 0, 1000000},
+                          {20ULL << 30, 0, 2000000},
+                          {32ULL << 30, 0, 5000000}};
+
+// parse_size: Parses a byte count with an optional K, M or G suffix (powers of 1024).
+// Parameters:
+//   text: Argument text, e.g. "512M".
+//   bytes: Receives the byte count.
+// Returns: True if the text is a positive size.
+bool parse_size(const char* text, size_t& bytes) noexcept {
+    char* end = nullptr;
+    unsigned long long value = strtoull(text, &end, 10);
+    if (end == text || value == 0) {
+        return false;
+    }
+    unsigned shift = 0;
+    const char* suffix = strchr(SIZE_SUFFIXES, toupper(static_cast<unsigned char>(*end)));
+    if (*end != '\0' && suffix != nullptr) {
+        shift = 10 * static_cast<unsigned>(suffix - SIZE_SUFFIXES + 1);
+        ++end;
+    }
+    if (*end != '\0' || value > (~0ULL >> shift)) {
+        return false;
+    }
+    bytes = static_cast<size_t>(value << shift);
+    return true;
+}
+
+// parse_number: Parses a decimal integer.
+// Parameters:
+//   text: Argument text.
+//   value: Receives the value.
+// Returns: True if the whole text is a number.
+bool parse_number(const char* text, uint64_t& value) noexcept {
+    char* end = nullptr;
+    value = strtoull(text, &end, 10);
+    return end != text && *end == '\0';
+}
+
+// parse_real: Parses a non-negative decimal fraction.
+bool parse_real(const char* text, double& value) noexcept {
+    char* end = nullptr;
+    value = strtod(text, &end);
+    return end != text && *end == '\0' && value >= 0.0;
+}
+
+// parse_weights: Parses a comma-separated list of non-negative weights.
+bool parse_weights(const char* text, std::vector<double>& weights) noexcept {
+    weights.clear();
+    std::string list(text);
+    size_t start = 0;
+    while (start <= list.size()) {
+        size_t end = list.find(',', start);
+        if (end == std::string::npos) {
+            end = list.size();
+        }
+        double weight;
+        if (!parse_real(list.substr(start, end - start).c_str(), weight)) {
+            return false;
+        }
+        weights.push_back(weight);
+        start = end + 1;
+    }
+    return true;
+}
+
+// print_usage: Writes the command-line synopsis to stderr.
+void print_usage(const char* program) noexcept {
+    ssize_t res = write(STDERR_FILENO, "Usage: ", 7);
+    res = write(STDERR_FILENO, program, strlen(program));
+    res = write(STDERR_FILENO, " [--case 1-5] [--size SIZE[K|M|G] | --words N] [--vocabulary N] [--zipf S]\n", 75);
+    res = write(STDERR_FILENO, "       [--min-length N] [--max-length N] [--length-weights W,...] [--seed N] [--threads N]\n", 91);
+    res = write(STDERR_FILENO, "       <output>\n", 16);
+    (void)res;
+}
+
+} // namespace
+
+// Main function: Generates one test input file and its expected unique count.
+// Parameters:
+//   argc: Number of command-line arguments.
+//   argv: Array of command-line argument strings (options, then the output file name).
+// Returns:
+//   0 on success, 1 on error (invalid arguments, unsatisfiable options, write errors).
+// --help and -h print the usage and return 1 without writing anything.
+// --case presets the size and vocabulary of a generate_test.py scenario; later options
+// override it. --zipf S writes the word of rank r with probability proportional to
+// 1 / r^S (0, the default, is uniform like generate_test.py). --length-weights gives one
+// weight per word length from --min-length to --max-length (uniform by default).
+// The same options and --seed always produce the same file, with any --threads.
+// "<output>.expected" receives the exact number of distinct words written, in the format
+// word_counter prints, so `word_counter <output> | cmp - <output>.expected` validates a count.
+int main(int argc, char* argv[]) {
+    WordGenerator::Options options;
+    int arg = 1;
+    while (arg + 1 < argc && strncmp(argv[arg], "--", 2) == 0) {
+        const char* value = argv[arg + 1];
+        uint64_t number = 0;
+        bool parsed;
+        if (strcmp(argv[arg], "--case") == 0) {
+            parsed = parse_number(value, number) && number >= 1 && number <= 5;
+            if (parsed) {
+                options.bytes = CASES[number].bytes;
+                options.words = CASES[number].words;
+                options.vocabulary = CASES[number].vocabulary;
+            }
+        } else if (strcmp(argv[arg], "--size") == 0) {
+            parsed = parse_size(value, options.bytes);
+            options.words = 0;
+        } else if (strcmp(argv[arg], "--words") == 0) {
+            parsed = parse_number(value, number) && number > 0;
+            options.words = static_cast<size_t>(number);
+        } else if (strcmp(argv[arg], "--vocabulary") == 0) {
+            parsed = parse_number(value, number) && number > 0;
+            options.vocabulary = static_cast<size_t>(number);
+        } else if (strcmp(argv[arg], "--zipf") == 0) {
+            parsed = parse_real(value, options.skew);
+        } else if (strcmp(argv[arg], "--min-length") == 0) {
+            parsed = parse_number(value, number);
+            options.min_length = static_cast<size_t>(number);
+        } else if (strcmp(argv[arg], "--max-length") == 0) {
+            parsed = parse_number(value, number);
+            options.max_length = static_cast<size_t>(number);
+        } else if (strcmp(argv[arg], "--length-weights") == 0) {
+            parsed = parse_weights(value, options.length_weights);
+        } else if (strcmp(argv[arg], "--seed") == 0) {
+            parsed = parse_number(value, options.seed);
+        } else if (strcmp(argv[arg], "--threads") == 0) {
+            parsed = parse_number(value, number);
+            options.threads = static_cast<size_t>(number);
+        } else {
+            parsed = false;
+        }
+        if (!parsed) {
+            print_usage(argv[0]);
+            return 1;
+        }
+        arg += 2;
+    }
+    // A lone trailing option (e.g. --help or -h) is not an output file name.
+    if (arg + 1 != argc || strncmp(argv[arg], "--", 2) == 0 || strcmp(argv[arg], "-h") == 0) {
+        print_usage(argv[0]);
+        return 1;
+    }
+
+    WordGenerator generator(options);
+    if (!generator.valid()) {
+        ssize_t res = write(STDERR_FILENO, "Error: Invalid lengths, weights or vocabulary size\n", 51);
+        (void)res;
+        return 1;
+    }
+    const std::string output_name = argv[arg];
+    SyscallFileHandle output(output_name.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (!output.is_open() || !generator.generate(output)) {
+        ssize_t res = write(STDERR_FILENO, "Error: Could not write output file\n", 35);
+        (void)res;
+        return 1;
+    }
+
+    const std::string expected_name = output_name + EXPECTED_SUFFIX;
+    const std::string expected = std::to_string(generator.unique_count()) + "\n";
+    SyscallFileHandle expected_file(expected_name.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (!expected_file.is_open() ||
+        expected_file.write(expected.data(), expected.size()) != static_cast<ssize_t>(expected.size())) {
+        ssize_t res = write(STDERR_FILENO, "Error: Could not write expected count\n", 38);
+        (void)res;
+        return 1;
+    }
+
+    std::string summary = output_name + ": " + std::to_string(generator.bytes_written()) + " bytes, " +
+                          std::to_string(generator.words_written()) + " words, " +
+                          std::to_string(generator.unique_count()) + " unique\n";
+    ssize_t res = write(STDOUT_FILENO, summary.c_str(), summary.size());
+    (void)res;
+    return 0;
+}
@@ -0,0 +1,276 @@
+// bench_merge.cpp: Benchmarks for the merge phase of WordCounter.
+// Compares the buffered RunReader merge against the former one-byte read() loop,
+// and the loser tree against a binary heap at high fan-in.
+
+#include "file_handle.hpp"
+#include "io_uring_file_handle.hpp"
+#include "run_reader.hpp"
+#include "run_writer.hpp"
+#include "temp_file.hpp"
+#include "word_counter.hpp"
+#include <benchmark/benchmark.h>
+#include <algorithm>
+#include <queue>
+#include <random>
+#include <string>
+#include <vector>
+
+// Helper function: writes `runs` sorted runs of `words_per_run` random a-z words,
+// front-coded through RunWriter or, with `text`, as the former newline-separated text.
+// Returns: Total number of text bytes (words plus separators) across all runs.
+static size_t write_runs(std::vector<TempFile>& temp_files, size_t runs, size_t words_per_run, bool text = false) {
+    std::mt19937 rng(42);
+    std::uniform_int_distribution<int> length(3, 10);
+    std::uniform_int_distribution<int> letter('a', 'z');
+    size_t total_bytes = 0;
+    for (size_t r = 0; r < runs; ++r) {
+        std::vector<std::string> words(words_per_run);
+        for (auto& word : words) {
+            word.resize(length(rng));
+            for (auto& c : word) {
+                c = static_cast<char>(letter(rng));
+            }
+        }
+        std::sort(words.begin(), words.end());
+        std::string data;
+        for (const auto& word : words) {
+            data += word;
+            data += '\n';
+        }
+        TempFile temp_file;
+        auto out = std::make_unique<SyscallFileHandle>(temp_file.name().c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0600);
+        if (text) {
+            out->write(data.data(), data.size());
+        } else {
+            RunWriter writer(std::move(out));
+            for (const auto& word : words) {
+                writer.append(word);
+            }
+        }
+        total_bytes += data.size();
+        temp_files.push_back(std::move(temp_file));
+    }
+    return total_bytes;
+}
+
+// Helper function: the pre-RunReader merge, pulling one byte per read() syscall.
+// Returns: Number of unique words across the runs.
+static size_t merge_with_byte_reads(const std::vector<TempFile>& temp_files) {
+    struct Entry {
+        std::string word;
+        size_t file;
+        bool operator>(const Entry& other) const { return word > other.word; }
+    };
+    std::vector<std::unique_ptr<SyscallFileHandle>> files;
+    std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> pq;
+    auto next_word = [&](size_t index, std::string& word) {
+        word.clear();
+        char c;
+        while (files[index]->read(&c, 1) == 1 && c != '\n') {
+            word += c;
+        }
+        return !word.empty();
+    };
+    for (const auto& temp_file : temp_files) {
+        files.push_back(std::make_unique<SyscallFileHandle>(temp_file.name().c_str(), O_RDONLY));
+        std::string word;
+        if (next_word(files.size() - 1, word)) {
+            pq.push({std::move(word), files.size() - 1});
+        }
+    }
+    size_t unique_count = 0;
+    std::string last_word;
+    while (!pq.empty()) {
+        Entry entry = pq.top();
+        pq.pop();
+        if (entry.word != last_word) {
+            ++unique_count;
+            last_word = entry.word;
+        }
+        if (next_word(entry.file, entry.word)) {
+            pq.push(std::move(entry));
+        }
+    }
+    return unique_count;
+}
+
+// BM_MergeByteReads: Baseline merge throughput with one read() per byte over text runs.
+static void BM_MergeByteReads(benchmark::State& state) {
+    std::vector<TempFile> temp_files;
+    size_t bytes = write_runs(temp_files, state.range(0), 20000, true);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(merge_with_byte_reads(temp_files));
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * bytes));
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * static_cast<size_t>(state.range(0)) * 20000));
+}
+BENCHMARK(BM_MergeByteReads)->Arg(4)->Arg(16)->Unit(benchmark::kMillisecond);
+
+// BM_MergeRunReader: WordCounter merge throughput with buffered run readers.
+static void BM_MergeRunReader(benchmark::State& state) {
+    std::vector<TempFile> temp_files;
+    size_t bytes = write_runs(temp_files, state.range(0), 20000);
+    WordCounter::Options options;
+    options.partitions = 1;
+    WordCounter counter(nullptr, options);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(counter.count_unique_words(temp_files));
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * bytes));
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * static_cast<size_t>(state.range(0)) * 20000));
+}
+BENCHMARK(BM_MergeRunReader)->Arg(4)->Arg(16)->Unit(benchmark::kMillisecond);
+
+// BM_MergeHeapRunReader: Buffered runs merged through std::priority_queue, as before the loser tree.
+static void BM_MergeHeapRunReader(benchmark::State& state) {
+    struct Entry {
+        std::string_view word;
+        RunReader* reader;
+        bool operator>(const Entry& other) const { return word > other.word; }
+    };
+    std::vector<TempFile> temp_files;
+    size_t bytes = write_runs(temp_files, state.range(0), 2000);
+    for (auto _ : state) {
+        std::vector<std::unique_ptr<RunReader>> readers;
+        std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> pq;
+        for (const auto& temp_file : temp_files) {
+            readers.push_back(std::make_unique<RunReader>(
+                std::make_unique<SyscallFileHandle>(temp_file.name().c_str(), O_RDONLY)));
+            std::string_view word;
+            if (readers.back()->next(word)) {
+                pq.push({word, readers.back().get()});
+            }
+        }
+        size_t unique_count = 0;
+        std::string last_word;
+        while (!pq.empty()) {
+            Entry entry = pq.top();
+            pq.pop();
+            if (last_word != entry.word) {
+                ++unique_count;
+                last_word.assign(entry.word.data(), entry.word.size());
+            }
+            if (entry.reader->next(entry.word)) {
+                pq.push(entry);
+            }
+        }
+        benchmark::DoNotOptimize(unique_count);
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * bytes));
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * static_cast<size_t>(state.range(0)) * 2000));
+}
+BENCHMARK(BM_MergeHeapRunReader)->Arg(64)->Arg(256)->Unit(benchmark::kMillisecond);
+
+// BM_MergeLoserTree: WordCounter's loser-tree merge at the same fan-in.
+static void BM_MergeLoserTree(benchmark::State& state) {
+    std::vector<TempFile> temp_files;
+    size_t bytes = write_runs(temp_files, state.range(0), 2000);
+    WordCounter::Options options;
+    options.partitions = 1;
+    WordCounter counter(nullptr, options);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(counter.count_unique_words(temp_files));
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * bytes));
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * static_cast<size_t>(state.range(0)) * 2000));
+}
+BENCHMARK(BM_MergeLoserTree)->Arg(64)->Arg(256)->Unit(benchmark::kMillisecond);
+
+// BM_MergePartitioned: 16 runs merged as the given number of parallel key ranges.
+static void BM_MergePartitioned(benchmark::State& state) {
+    std::vector<TempFile> temp_files;
+    size_t bytes = write_runs(temp_files, 16, 20000);
+    WordCounter::Options options;
+    options.partitions = static_cast<size_t>(state.range(0));
+    WordCounter counter(nullptr, options);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(counter.count_unique_words(temp_files));
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * bytes));
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * 16 * 20000));
+}
+BENCHMARK(BM_MergePartitioned)->Arg(1)->Arg(2)->Arg(4)->Arg(8)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+// BM_MergeCascade: 256 runs merged with the given maximum fan-in.
+// Fan-in 256 merges in one pass; smaller fan-ins add intermediate passes.
+static void BM_MergeCascade(benchmark::State& state) {
+    std::vector<TempFile> temp_files;
+    size_t bytes = write_runs(temp_files, 256, 2000);
+    WordCounter::Options options;
+    options.max_fan_in = static_cast<size_t>(state.range(0));
+    WordCounter counter(nullptr, options);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(counter.count_unique_words(temp_files));
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * bytes));
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * 256 * 2000));
+    state.counters["passes"] = static_cast<double>(counter.merge_stats().passes);
+    state.counters["bytes_rewritten"] = static_cast<double>(counter.merge_stats().bytes_rewritten);
+}
+BENCHMARK(BM_MergeCascade)->Arg(256)->Arg(16)->Arg(4)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+// BM_MergeIoBackend: Cascading merge of 256 runs with blocking reads and writes (arg 0)
+// or with run I/O overlapped through io_uring (arg 1).
+static void BM_MergeIoBackend(benchmark::State& state) {
+    if (state.range(0) == 1 && !IoUring::available()) {
+        state.SkipWithError("io_uring is not available");
+        return;
+    }
+    std::vector<TempFile> temp_files;
+    size_t bytes = write_runs(temp_files, 256, 2000);
+    WordCounter::Options options;
+    options.max_fan_in = 16;
+    WordCounter counter(nullptr, options);
+    IoUring::set_enabled(state.range(0) == 1);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(counter.count_unique_words(temp_files));
+    }
+    IoUring::set_enabled(true);
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * bytes));
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * 256 * 2000));
+}
+BENCHMARK(BM_MergeIoBackend)->Arg(0)->Arg(1)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+// BM_WriteRun: Spill throughput and on-disk size of one sorted run, as text or front-coded.
+// Arg 0 writes newline-separated text, arg 1 the binary run format.
+static void BM_WriteRun(benchmark::State& state) {
+    std::mt19937 rng(7);
+    std::uniform_int_distribution<int> length(3, 10);
+    std::uniform_int_distribution<int> letter('a', 'z');
+    std::vector<std::string> words(200000);
+    size_t text_bytes = 0;
+    for (auto& word : words) {
+        word.resize(length(rng));
+        for (auto& c : word) {
+            c = static_cast<char>(letter(rng));
+        }
+        text_bytes += word.size() + 1;
+    }
+    std::sort(words.begin(), words.end());
+    size_t disk_bytes = 0;
+    for (auto _ : state) {
+        TempFile temp_file;
+        auto out = std::make_unique<SyscallFileHandle>(temp_file.name().c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0600);
+        if (state.range(0) == 0) {
+            std::string data;
+            for (const auto& word : words) {
+                data += word;
+                data += '\n';
+            }
+            out->write(data.data(), data.size());
+            disk_bytes = data.size();
+        } else {
+            RunWriter writer(std::move(out));
+            for (const auto& word : words) {
+                writer.append(word);
+            }
+            writer.finish();
+            disk_bytes = writer.bytes_written();
+        }
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * text_bytes));
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * words.size()));
+    state.counters["disk_bytes"] = static_cast<double>(disk_bytes);
+    state.counters["text_ratio"] = static_cast<double>(text_bytes) / static_cast<double>(disk_bytes);
+}
+BENCHMARK(BM_WriteRun)->Arg(0)->Arg(1)->Unit(benchmark::kMillisecond);
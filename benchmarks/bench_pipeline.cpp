@@ -0,0 +1,146 @@
+// bench_pipeline.cpp: Benchmarks for the parse stage and for whole counts.
+// Runs the parser and the in-memory, external and approximate counts on inputs shaped
+// like the generate_test.py cases, reporting bytes/s and words/s.
+
+#include "approx_counter.hpp"
+#include "chunk_coordinator.hpp"
+#include "file_handle.hpp"
+#include "in_memory_counter.hpp"
+#include "parser.hpp"
+#include "temp_file.hpp"
+#include "word_counter.hpp"
+#include <benchmark/benchmark.h>
+#include <random>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+// Size of every benchmark input; the cases differ in vocabulary, not in size.
+static constexpr size_t INPUT_SIZE = 64ULL << 20;
+
+// Distinct words of generate_test.py cases 1 to 5, indexed by case number.
+static constexpr size_t CASE_UNIQUE_WORDS[] = {0, 1000, 100000, 1000000, 2000000, 5000000};
+
+// Path names in argument order.
+static const char* const PATH_NAMES[] = {"in_memory", "external", "approx"};
+
+// Corpus: One generated input and its shape.
+struct Corpus {
+    std::string text; // Space-separated words, INPUT_SIZE bytes long.
+    size_t words;     // Number of words in the text.
+    size_t unique;    // Number of distinct words in the text.
+};
+
+// Helper function: builds INPUT_SIZE bytes of words drawn uniformly from a pool of
+// distinct random a-z words (3-10 letters), like generate_test.py does for a case.
+// The last corpus is cached, so benchmarks over the same case share it.
+static const Corpus& case_corpus(size_t test_case) {
+    static Corpus corpus;
+    static size_t cached_case = 0;
+    if (cached_case == test_case) {
+        return corpus;
+    }
+    std::mt19937 rng(static_cast<unsigned>(test_case));
+    std::uniform_int_distribution<int> length(3, 10);
+    std::uniform_int_distribution<int> letter('a', 'z');
+    std::unordered_set<std::string> distinct;
+    while (distinct.size() < CASE_UNIQUE_WORDS[test_case]) {
+        std::string word(length(rng), 'a');
+        for (auto& c : word) {
+            c = static_cast<char>(letter(rng));
+        }
+        distinct.insert(std::move(word));
+    }
+    std::vector<std::string> pool(distinct.begin(), distinct.end());
+    distinct.clear();
+    std::uniform_int_distribution<size_t> pick(0, pool.size() - 1);
+    std::vector<bool> used(pool.size());
+    corpus.text.clear();
+    corpus.text.reserve(INPUT_SIZE + 16);
+    corpus.words = 0;
+    corpus.unique = 0;
+    while (corpus.text.size() < INPUT_SIZE) {
+        const size_t index = pick(rng);
+        corpus.text += pool[index];
+        corpus.text += ' ';
+        ++corpus.words;
+        corpus.unique += used[index] ? 0 : 1;
+        used[index] = true;
+    }
+    cached_case = test_case;
+    return corpus;
+}
+
+// Helper function: writes a case's corpus to a file once and returns its name.
+static const std::string& case_input(size_t test_case) {
+    static TempFile input;
+    static size_t cached_case = 0;
+    if (cached_case != test_case) {
+        const Corpus& corpus = case_corpus(test_case);
+        SyscallFileHandle out(input.name().c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0600);
+        out.write(corpus.text.data(), corpus.text.size());
+        cached_case = test_case;
+    }
+    return input.name();
+}
+
+// Helper function: reports input bytes and words per second.
+static void set_throughput(benchmark::State& state, const Corpus& corpus) {
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * corpus.text.size()));
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * corpus.words));
+    state.counters["unique"] = static_cast<double>(corpus.unique);
+}
+
+// BM_Parse: SpaceSeparatedParser splitting a case's input into word views.
+// The argument is the generate_test.py case number.
+static void BM_Parse(benchmark::State& state) {
+    const Corpus& corpus = case_corpus(static_cast<size_t>(state.range(0)));
+    SpaceSeparatedParser parser;
+    std::vector<std::string_view> words;
+    words.reserve(corpus.words);
+    for (auto _ : state) {
+        words.clear();
+        parser.parse(corpus.text.data(), corpus.text.size(), words);
+        benchmark::DoNotOptimize(words.data());
+    }
+    set_throughput(state, corpus);
+    state.SetLabel(SpaceSeparatedParser::scanner_name());
+}
+BENCHMARK(BM_Parse)->DenseRange(1, 5)->Unit(benchmark::kMillisecond);
+
+// BM_CountFile: A whole count of a case's input from a warm page cache.
+// Arguments: generate_test.py case number, then the path (0 in-memory set, 1 external
+// chunk pipeline and merge, 2 HyperLogLog estimate).
+static void BM_CountFile(benchmark::State& state) {
+    const size_t test_case = static_cast<size_t>(state.range(0));
+    const std::string& name = case_input(test_case);
+    const Corpus& corpus = case_corpus(test_case);
+    size_t unique_count = 0;
+    for (auto _ : state) {
+        auto input = std::make_unique<SyscallFileHandle>(name.c_str(), O_RDONLY);
+        if (state.range(1) == 0) {
+            InMemoryCounter counter(std::move(input), corpus.text.size(), ~size_t{0});
+            counter.count();
+            unique_count = counter.unique_count();
+        } else if (state.range(1) == 1) {
+            std::vector<TempFile> temp_files;
+            ChunkCoordinator(std::move(input), std::make_unique<SpaceSeparatedParser>(), corpus.text.size())
+                .process_chunks(temp_files);
+            WordCounter counter(nullptr);
+            unique_count = counter.count_unique_words(temp_files);
+        } else {
+            ApproxCounter counter(std::move(input), corpus.text.size());
+            unique_count = static_cast<size_t>(counter.count().estimate());
+        }
+        benchmark::DoNotOptimize(unique_count);
+    }
+    if (state.range(1) != 2 && unique_count != corpus.unique) {
+        state.SkipWithError("unique count does not match the corpus");
+    }
+    set_throughput(state, corpus);
+    state.SetLabel(PATH_NAMES[state.range(1)]);
+}
+BENCHMARK(BM_CountFile)
+    ->ArgsProduct({benchmark::CreateDenseRange(1, 5, 1), {0, 1, 2}})
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
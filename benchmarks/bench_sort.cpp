@@ -0,0 +1,81 @@
+// bench_sort.cpp: Benchmarks for the chunk sorting engines.
+// Compares std::sort with the MSD radix sort on generate_test.py word distributions.
+
+#include "string_sort.hpp"
+#include <benchmark/benchmark.h>
+#include <random>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+namespace {
+
+// Helper function: builds a generate_test.py-style pool of distinct random words (3-10 letters).
+std::vector<std::string> make_pool(size_t unique_count, std::mt19937& rng) {
+    std::uniform_int_distribution<int> length(3, 10);
+    std::uniform_int_distribution<int> letter('a', 'z');
+    std::unordered_set<std::string> pool;
+    while (pool.size() < unique_count) {
+        std::string word(length(rng), 'a');
+        for (auto& c : word) {
+            c = static_cast<char>(letter(rng));
+        }
+        pool.insert(std::move(word));
+    }
+    return std::vector<std::string>(pool.begin(), pool.end());
+}
+
+// Helper function: samples total_words uniformly from a pool of unique_count words.
+// The returned views point into the static pool, which lives for the whole benchmark.
+const std::vector<std::string_view>& sample_words(size_t total_words, size_t unique_count) {
+    static std::vector<std::string> pool;
+    static std::vector<std::string_view> words;
+    static size_t cached_total = 0, cached_unique = 0;
+    if (cached_total != total_words || cached_unique != unique_count) {
+        std::mt19937 rng(42);
+        pool = make_pool(unique_count, rng);
+        std::uniform_int_distribution<size_t> pick(0, pool.size() - 1);
+        words.clear();
+        for (size_t i = 0; i < total_words; ++i) {
+            words.emplace_back(pool[pick(rng)]);
+        }
+        cached_total = total_words;
+        cached_unique = unique_count;
+    }
+    return words;
+}
+
+// run_sort: Benchmarks one engine on a sampled word list.
+void run_sort(benchmark::State& state, SortAlgorithm algorithm) {
+    const auto& words = sample_words(static_cast<size_t>(state.range(0)), static_cast<size_t>(state.range(1)));
+    size_t bytes = 0;
+    for (const auto& word : words) {
+        bytes += word.size() + 1;
+    }
+    std::vector<std::string_view> copy;
+    for (auto _ : state) {
+        state.PauseTiming();
+        copy = words;
+        state.ResumeTiming();
+        sort_words(copy, algorithm);
+        benchmark::DoNotOptimize(copy.data());
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * bytes));
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * words.size()));
+}
+
+} // namespace
+
+// BM_SortStd: std::sort on word views.
+static void BM_SortStd(benchmark::State& state) {
+    run_sort(state, SortAlgorithm::Std);
+}
+
+// BM_SortMsdRadix: MSD radix sort on the same views.
+static void BM_SortMsdRadix(benchmark::State& state) {
+    run_sort(state, SortAlgorithm::MsdRadix);
+}
+
+// Shapes: (words, unique) for case 1 scale, case 2 vocabulary, and a distinct-only chunk.
+BENCHMARK(BM_SortStd)->Args({1000000, 1000})->Args({1000000, 100000})->Args({1000000, 1000000})->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_SortMsdRadix)->Args({1000000, 1000})->Args({1000000, 100000})->Args({1000000, 1000000})->Unit(benchmark::kMillisecond);
@@ -0,0 +1,58 @@
+#ifndef APPROX_COUNTER_HPP
+#define APPROX_COUNTER_HPP
+
+// approx_counter.hpp: Declaration of ApproxCounter class for the approximate counting mode.
+// Estimates the unique word count in one streaming pass with per-thread HyperLogLog sketches.
+
+#include "file_handle.hpp"
+#include "hyperloglog.hpp"
+#include "input_files.hpp"
+#include "thread_pool.hpp"
+#include <memory>
+
+// ApproxCounter: Estimates the number of unique words without storing any word.
+// Worker threads claim word-aligned chunks in file order, parse each chunk into views
+// and add them to their own HyperLogLog sketch, so the scan needs no locks, hash sets
+// or temporary files. The sketches are merged once every chunk is done. Several input
+// files are scanned file after file into the same sketches.
+class ApproxCounter final {
+public:
+    // Default chunk size: 4 MiB keeps each worker's view vector small and balances load.
+    static constexpr size_t DEFAULT_CHUNK_SIZE = 4ULL << 20;
+
+    // Constructor: Initializes with the input file and sketch precision.
+    // Parameters:
+    //   input_file: Unique pointer to the input file handle.
+    //   file_size: Total size of the input file.
+    //   precision: Register index bits of each sketch.
+    //   chunk_size: Nominal size of each chunk claimed by a worker.
+    //   pool: Worker pool that runs the scanning loops.
+    ApproxCounter(std::unique_ptr<FileHandle> input_file, size_t file_size,
+                  unsigned precision = HyperLogLog::DEFAULT_PRECISION, size_t chunk_size = DEFAULT_CHUNK_SIZE,
+                  ThreadPool& pool = ThreadPool::shared()) noexcept;
+
+    // Constructor: Initializes with several input files estimated as one.
+    // Parameters:
+    //   inputs: Input files and their sizes.
+    //   precision: Register index bits of each sketch.
+    //   chunk_size: Nominal size of each chunk claimed by a worker.
+    //   pool: Worker pool that runs the scanning loops.
+    explicit ApproxCounter(std::vector<InputFile> inputs, unsigned precision = HyperLogLog::DEFAULT_PRECISION,
+                           size_t chunk_size = DEFAULT_CHUNK_SIZE, ThreadPool& pool = ThreadPool::shared()) noexcept;
+
+    // count: Scans every input file into the sketch.
+    // Returns: The merged sketch of every word in the inputs.
+    HyperLogLog count() noexcept;
+
+    // count_stream: Reads the first input sequentially (pipe, stdin) into the sketch; its size is not used.
+    // Returns: The merged sketch of every word in the stream, or of the words read before a read error.
+    HyperLogLog count_stream() noexcept;
+
+private:
+    std::vector<InputFile> inputs_; // Input files, scanned in order.
+    unsigned precision_;            // Register index bits of each sketch.
+    size_t chunk_size_;             // Nominal chunk size.
+    ThreadPool& pool_;              // Pool running the scanning loops.
+};
+
+#endif // APPROX_COUNTER_HPP
@@ -0,0 +1,116 @@
+#ifndef BOUNDED_QUEUE_HPP
+#define BOUNDED_QUEUE_HPP
+
+// bounded_queue.hpp: Declaration of BoundedQueue class template for hand-offs between pipeline stages.
+// A fixed-capacity FIFO whose producers block while it is full, giving back-pressure.
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <utility>
+
+// BoundedQueue: Thread-safe FIFO holding at most capacity items.
+// push() blocks while the queue is full, so a fast stage is throttled to the pace of
+// the stage after it instead of buffering without limit. Once close() is called,
+// pop() drains the remaining items and then reports the end of the stream.
+template <typename T>
+class BoundedQueue final {
+public:
+    // Constructor: Creates an empty, open queue.
+    // Parameters:
+    //   capacity: Maximum number of queued items (at least one).
+    explicit BoundedQueue(size_t capacity) noexcept : capacity_(std::max<size_t>(capacity, 1)), closed_(false) {
+    }
+
+    // Copy constructor: Deleted; waiting threads are bound to this queue.
+    BoundedQueue(const BoundedQueue&) = delete;
+
+    // Copy assignment: Deleted; waiting threads are bound to this queue.
+    BoundedQueue& operator=(const BoundedQueue&) = delete;
+
+    // push: Appends an item, waiting while the queue is full.
+    // Parameters:
+    //   item: Item to move into the queue.
+    // Returns: True if queued, false if the queue was closed.
+    bool push(T item) noexcept {
+        std::unique_lock<std::mutex> lock(mutex_);
+        wait(not_full_, lock, [this]() { return closed_ || items_.size() < capacity_; });
+        if (closed_) {
+            return false;
+        }
+        items_.push_back(std::move(item));
+        lock.unlock();
+        not_empty_.notify_one();
+        return true;
+    }
+
+    // pop: Removes the oldest item, waiting while the queue is empty and open.
+    // Parameters:
+    //   item: Output receiving the item.
+    // Returns: True if an item was taken, false once the queue is closed and drained.
+    bool pop(T& item) noexcept {
+        std::unique_lock<std::mutex> lock(mutex_);
+        wait(not_empty_, lock, [this]() { return closed_ || !items_.empty(); });
+        if (items_.empty()) {
+            return false;
+        }
+        item = std::move(items_.front());
+        items_.pop_front();
+        lock.unlock();
+        not_full_.notify_one();
+        return true;
+    }
+
+    // close: Ends the stream; queued items can still be popped.
+    void close() noexcept {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            closed_ = true;
+        }
+        not_empty_.notify_all();
+        not_full_.notify_all();
+    }
+
+    // size: Number of queued items.
+    // Returns: Current item count.
+    size_t size() const noexcept {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return items_.size();
+    }
+
+    // capacity: Maximum number of queued items.
+    // Returns: Capacity given at construction.
+    size_t capacity() const noexcept {
+        return capacity_;
+    }
+
+private:
+    // Deadline of one sleep; waiters are woken by notifications, not by the deadline.
+    static constexpr std::chrono::hours WAIT_DEADLINE{24};
+
+    // wait: Sleeps on a condition until the predicate holds.
+    // Parameters:
+    //   condition: not_full_ or not_empty_.
+    //   lock: Held lock of mutex_.
+    //   predicate: Condition to wait for.
+    // Uses the inline deadline wait rather than the untimed wait(), whose libstdc++
+    // symbol (GLIBCXX_3.4.30) older runtimes lack.
+    template <typename Predicate>
+    static void wait(std::condition_variable& condition, std::unique_lock<std::mutex>& lock,
+                     Predicate predicate) noexcept {
+        while (!predicate()) {
+            condition.wait_until(lock, std::chrono::steady_clock::now() + WAIT_DEADLINE);
+        }
+    }
+
+    const size_t capacity_;             // Maximum number of queued items.
+    mutable std::mutex mutex_;          // Guards items_ and closed_.
+    std::condition_variable not_full_;  // Signals freed capacity or closing.
+    std::condition_variable not_empty_; // Signals a new item or closing.
+    std::deque<T> items_;               // Queued items, oldest at the front.
+    bool closed_;                       // True once close() was called.
+};
+
+#endif // BOUNDED_QUEUE_HPP
@@ -5,30 +5,134 @@
 // Coordinates parallel processing of file chunks and manages temporary files.
 
 #include "file_handle.hpp"
+#include "input_files.hpp"
 #include "parser.hpp"
 #include "temp_file.hpp"
+#include "chunk_pipeline.hpp"
+#include <chrono>
 #include <memory>
 #include <vector>
 
 // ChunkCoordinator: Manages multithreaded processing of file chunks.
-// Uses dependency injection for file handle and parser.
+// Uses dependency injection for file handle and parser; chunks run through a ChunkPipeline.
+// Several input files are chunked into one pipeline run: large files are cut into
+// chunks of their own, and small files and file tails are batched into shared chunks,
+// so every file does not cost its own run file.
 class ChunkCoordinator final {
 public:
+    // Default chunk size: 256 MiB keeps per-chunk overhead low while the pipeline overlaps stages.
+    static constexpr size_t DEFAULT_CHUNK_SIZE = 256ULL << 20;
+
+    // Smallest chunk a memory budget shrinks chunks to before it lowers the in-flight count.
+    static constexpr size_t MIN_CHUNK_SIZE = 8ULL << 20;
+
+    // Bytes held per distinct word of an in-flight chunk: its view plus the parse stage's hash set node.
+    static constexpr size_t WORD_OVERHEAD = 80;
+
+    // Bytes of input sampled to estimate the average word length.
+    static constexpr size_t SAMPLE_SIZE = 1ULL << 20;
+
+    // MemoryPlan: Chunk geometry derived from a memory budget.
+    struct MemoryPlan {
+        size_t chunk_size;     // Nominal chunk size.
+        size_t in_flight;      // Chunks loaded but not yet spilled.
+        double bytes_per_word; // Average input bytes per word (separator included) the plan assumed.
+    };
+
     // Constructor: Initializes with file handle, parser, and file size.
     // Parameters:
     //   input_file: Unique pointer to the input file handle.
     //   parser: Unique pointer to the parser.
     //   file_size: Total size of the input file.
-    ChunkCoordinator(std::unique_ptr<FileHandle> input_file, std::unique_ptr<Parser> parser, size_t file_size) noexcept;
+    //   chunk_size: Nominal chunk size; actual chunks end at the next space.
+    //   options: Stage parallelism and queue depth of the chunk pipeline.
+    ChunkCoordinator(std::unique_ptr<FileHandle> input_file, std::unique_ptr<Parser> parser, size_t file_size,
+                     size_t chunk_size = DEFAULT_CHUNK_SIZE,
+                     ChunkPipeline::Options options = ChunkPipeline::Options()) noexcept;
+
+    // Constructor: Initializes with several input files counted as one.
+    // Parameters:
+    //   inputs: Input files and their sizes (at least one).
+    //   parser: Unique pointer to the parser.
+    //   chunk_size: Nominal chunk size; actual chunks end at the next space.
+    //   options: Stage parallelism and queue depth of the chunk pipeline.
+    ChunkCoordinator(std::vector<InputFile> inputs, std::unique_ptr<Parser> parser,
+                     size_t chunk_size = DEFAULT_CHUNK_SIZE,
+                     ChunkPipeline::Options options = ChunkPipeline::Options()) noexcept;
+
+    // process_chunks: Splits the inputs into word-aligned chunks and processes them in parallel.
+    // Parameters:
+    //   temp_files: Receives the TempFile objects of the sorted chunks.
+    //   start_offset: Word-aligned offset to start from in input start_input (bytes before it are skipped).
+    //   start_input: Index of the input to start in; earlier inputs are skipped.
+    // Returns: True if every chunk was read and spilled; the runs are incomplete otherwise.
+    bool process_chunks(std::vector<TempFile>& temp_files, off_t start_offset = 0, size_t start_input = 0) noexcept;
+
+    // process_stream: Reads the first input sequentially (pipe, stdin) and processes it in
+    // word-aligned chunks, without stat() or seeking; the file size is not used.
+    // Parameters:
+    //   temp_files: Receives the TempFile objects of the sorted chunks.
+    // Returns: True if the whole stream was read and spilled; the runs are incomplete otherwise.
+    bool process_stream(std::vector<TempFile>& temp_files) noexcept;
+
+    // set_memory_limit: Bounds the memory of later process_chunks() and process_stream() calls.
+    // Parameters:
+    //   memory_limit: Bytes the in-flight chunks may use; 0 restores the fixed chunk size.
+    void set_memory_limit(size_t memory_limit) noexcept;
+
+    // memory_plan: Chunk geometry chosen by the last memory-limited processing call.
+    // Returns: The plan, or all zeros if no memory limit was applied.
+    MemoryPlan memory_plan() const noexcept;
+
+    // plan_memory: Derives chunk size and in-flight count from a memory budget.
+    // Parameters:
+    //   memory_limit: Bytes the in-flight chunks may use.
+    //   bytes_per_word: Average input bytes per word.
+    //   workers: Parse threads that can work on chunks at once.
+    // Returns: A plan whose in_flight * chunk_size * cost per byte stays within the
+    //          budget, using the largest chunks (up to DEFAULT_CHUNK_SIZE) that still
+    //          keep every worker busy, or fewer chunks if they would drop below MIN_CHUNK_SIZE.
+    static MemoryPlan plan_memory(size_t memory_limit, double bytes_per_word, size_t workers) noexcept;
+
+    // sample_bytes_per_word: Estimates the average word length from a prefix of the input.
+    // Parameters:
+    //   file: Handle to read the input through (its offset is moved).
+    //   start: Offset where the sample starts.
+    //   file_size: Total size of the input file.
+    // Returns: Sampled bytes per space-separated word, or the sampled size if it holds no word.
+    static double sample_bytes_per_word(FileHandle& file, off_t start, size_t file_size) noexcept;
 
-    // process_chunks: Splits file into chunks and processes them in parallel.
-    // Returns: Vector of TempFile objects for sorted chunks.
-    std::vector<TempFile> process_chunks() noexcept;
+    // stage_stats: Per-stage counters of the pipeline runs so far.
+    // Returns: One StageStats per stage, in pipeline order.
+    std::vector<ChunkPipeline::StageStats> stage_stats() const noexcept;
+
+    // planning_time: Time spent before the pipeline runs so far: sampling and chunk boundary search.
+    // Returns: Wall time summed over the processing calls.
+    std::chrono::nanoseconds planning_time() const noexcept;
+
+    // find_chunk_end: Snaps a nominal chunk boundary forward to the next space.
+    // Parameters:
+    //   file: Handle to read the input through (its offset is moved).
+    //   nominal: Offset where the chunk would end at exactly its nominal size.
+    //   file_size: Total size of the input file.
+    // Returns: Offset of the first space at or after nominal, or file_size if none.
+    static off_t find_chunk_end(FileHandle& file, off_t nominal, size_t file_size) noexcept;
 
 private:
-    std::unique_ptr<FileHandle> input_file_; // File handle for input file.
+    // apply_memory_plan: Plans chunks for the memory limit and configures the pipeline.
+    // Parameters:
+    //   bytes_per_word: Sampled average word length.
+    // Returns: Nominal chunk size of the plan.
+    size_t apply_memory_plan(double bytes_per_word) noexcept;
+
+    std::vector<InputFile> inputs_;          // Input files and their sizes.
     std::unique_ptr<Parser> parser_;         // Parser for word extraction.
-    size_t file_size_;                       // Total size of the input file.
+    size_t chunk_size_;                      // Nominal size of each chunk.
+    ChunkPipeline::Options options_;         // Pipeline options before any memory limit.
+    size_t memory_limit_;                    // Budget of the in-flight chunks (0 = none).
+    MemoryPlan plan_;                        // Plan of the last memory-limited run.
+    std::chrono::nanoseconds planning_time_; // Sampling and chunk boundary search time.
+    ChunkPipeline pipeline_;                 // Stages the chunks run through.
 };
 
 #endif // CHUNK_COORDINATOR_HPP
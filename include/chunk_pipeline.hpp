@@ -0,0 +1,149 @@
+#ifndef CHUNK_PIPELINE_HPP
+#define CHUNK_PIPELINE_HPP
+
+// chunk_pipeline.hpp: Declaration of ChunkPipeline class for staged chunk processing.
+// Overlaps reading, parsing, sorting and spilling of consecutive chunks.
+
+#include "file_handle.hpp"
+#include "stream_chunker.hpp"
+#include "temp_file.hpp"
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <string>
+#include <sys/types.h>
+#include <utility>
+#include <vector>
+
+// ChunkPipeline: Runs chunks through read -> parse -> sort -> spill stages.
+// Each stage has its own threads and hands chunks to the next stage through a
+// BoundedQueue, so chunk N+1 is read while chunk N is parsed and chunk N-1 is
+// written. Full queues block the stage feeding them, which bounds the number of
+// chunks in memory; per-stage counters show which stage limits throughput.
+class ChunkPipeline final {
+public:
+    // Piece: A word-aligned range of one input file.
+    struct Piece {
+        int fd;      // Descriptor of the input file; not owned.
+        off_t start; // Starting offset in that file.
+        size_t size; // Number of bytes.
+    };
+
+    // Chunk: One word-aligned range of the input and the run file it spills to, or a
+    // batch of small ranges from several input files that share one run.
+    struct Chunk {
+        off_t start;               // Starting offset in the input file.
+        size_t size;               // Number of bytes in the chunk (summed over a batch).
+        std::string temp_filename; // Run file receiving the sorted distinct words.
+        int fd;                    // Descriptor of the range's input; -1 selects the pipeline's input.
+        std::vector<Piece> batch;  // Ranges read together instead of (fd, start, size) when not empty.
+
+        // Constructor: Describes a range of the pipeline's input, of another input, or a batch.
+        Chunk(off_t start, size_t size, std::string temp_filename, int fd = -1,
+              std::vector<Piece> batch = std::vector<Piece>()) noexcept
+            : start(start), size(size), temp_filename(std::move(temp_filename)), fd(fd), batch(std::move(batch)) {
+        }
+    };
+
+    // Options: Stage parallelism, queue depth and in-flight limit.
+    struct Options {
+        size_t parse_workers;  // Parse threads; 0 selects the hardware concurrency.
+        size_t sort_workers;   // Sort threads; 0 selects half the hardware concurrency.
+        size_t queue_capacity; // Chunks each inter-stage queue may hold.
+        size_t max_in_flight;  // Chunks loaded but not yet spilled; 0 leaves only the queues to limit it.
+        bool word_counts;      // Spill counting runs of (word, count) pairs instead of distinct words.
+        CacheMode cache_mode;  // Page cache use of chunk reads and run writes; must match the input handle.
+
+        // Constructor: Defaults to hardware-sized stages, two-chunk queues, no in-flight
+        // limit, plain runs and buffered I/O.
+        Options() noexcept
+            : parse_workers(0), sort_workers(0), queue_capacity(2), max_in_flight(0), word_counts(false),
+              cache_mode(CacheMode::BUFFERED) {
+        }
+    };
+
+    // Stage indices into the counters and into stats().
+    enum StageIndex { READ = 0, PARSE = 1, SORT = 2, SPILL = 3, STAGE_COUNT = 4 };
+
+    // StageStats: Throughput counters of one stage, summed over its threads.
+    struct StageStats {
+        const char* name;                     // Stage name: read, parse, sort or spill.
+        size_t workers;                       // Threads running the stage.
+        size_t chunks;                        // Chunks completed.
+        size_t bytes;                         // Input bytes of the completed chunks.
+        size_t words;                         // Words leaving the stage.
+        size_t words_parsed;                  // Words parsed, duplicates included (parse stage only).
+        size_t bytes_written;                 // Run file bytes written (spill stage only).
+        std::chrono::nanoseconds busy_time;   // Time spent doing the stage's work.
+        std::chrono::nanoseconds input_wait;  // Time spent waiting for input (starved).
+        std::chrono::nanoseconds output_wait; // Time spent blocked on a full queue (back-pressure).
+    };
+
+    // Constructor: Configures the pipeline for one input file.
+    // Parameters:
+    //   input_fd: Descriptor of the input file used by chunks without their own; not owned,
+    //             must outlive run().
+    //   options: Stage parallelism and queue depth.
+    explicit ChunkPipeline(int input_fd, Options options = Options()) noexcept;
+
+    // Copy constructor: Deleted; counters are bound to this pipeline.
+    ChunkPipeline(const ChunkPipeline&) = delete;
+
+    // Copy assignment: Deleted; counters are bound to this pipeline.
+    ChunkPipeline& operator=(const ChunkPipeline&) = delete;
+
+    // configure: Replaces the stage parallelism, queue depth and in-flight limit for later runs.
+    // Parameters:
+    //   options: New options (zero worker counts pick defaults).
+    void configure(Options options) noexcept;
+
+    // run: Processes every chunk and blocks until all runs are written.
+    // Parameters:
+    //   chunks: Chunks to process, read in the given order.
+    // Returns: True if every run was written, false if a chunk could not be read or spilled.
+    bool run(const std::vector<Chunk>& chunks) noexcept;
+
+    // run_stream: Processes a non-seekable input and blocks until all runs are written.
+    // Parameters:
+    //   chunker: Source of word-aligned chunks; its memory is bounded like the file's.
+    //   temp_files: Receives the run files of the chunks, in stream order.
+    // Returns: True if every run was written, false if a run could not be spilled.
+    bool run_stream(StreamChunker& chunker, std::vector<TempFile>& temp_files) noexcept;
+
+    // stats: Counters accumulated over all runs.
+    // Returns: One StageStats per stage, in pipeline order.
+    std::vector<StageStats> stats() const noexcept;
+
+    // ChunkWork: A chunk travelling through the stages (defined in the implementation).
+    struct ChunkWork;
+
+private:
+    // Counters: Atomic counters of one stage.
+    struct Counters {
+        std::atomic<size_t> chunks{0};
+        std::atomic<size_t> bytes{0};
+        std::atomic<size_t> words{0};
+        std::atomic<size_t> words_parsed{0};
+        std::atomic<size_t> bytes_written{0};
+        std::atomic<int64_t> busy_ns{0};
+        std::atomic<int64_t> input_wait_ns{0};
+        std::atomic<int64_t> output_wait_ns{0};
+    };
+
+    // run_stages: Runs the stages over the chunks produced by a read stage body.
+    // Parameters:
+    //   load: Fills the next chunk's work; returns false when no chunks are left.
+    // Returns: False if a chunk failed to load or spill; the remaining chunks are dropped.
+    bool run_stages(const std::function<bool(ChunkWork&)>& load) noexcept;
+
+    int input_fd_;                     // Input descriptor shared by the read stage.
+    size_t parse_workers_;             // Parse threads per run.
+    size_t sort_workers_;              // Sort threads per run.
+    size_t queue_capacity_;            // Depth of each inter-stage queue.
+    size_t max_in_flight_;             // Chunks loaded but not yet spilled (0 = unlimited).
+    bool word_counts_;                 // True to spill counting runs.
+    CacheMode cache_mode_;             // Page cache use of chunk reads and run writes.
+    Counters counters_[STAGE_COUNT];   // Per-stage counters.
+};
+
+#endif // CHUNK_PIPELINE_HPP
@@ -2,33 +2,116 @@
 #define CHUNK_PROCESSOR_HPP
 
 // chunk_processor.hpp: Declaration of ChunkProcessor class for processing file chunks.
-// Reads, parses, sorts, and writes a chunk to a temporary file.
+// Reads, parses, deduplicates, sorts, and writes a chunk to a temporary file.
 
 #include "file_handle.hpp"
 #include "parser.hpp"
+#include "string_sort.hpp"
+#include "word_arena.hpp"
 #include <memory>
 #include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
 
 // ChunkProcessor: Processes a single file chunk in a thread-safe manner.
 // Uses dependency injection for file handle and parser.
 class ChunkProcessor final {
 public:
-    // Constructor: Initializes with file handle and parser.
+    // WordCounts: Occurrences of each distinct word of a chunk, keyed by views into the chunk.
+    using WordCounts = std::unordered_map<std::string_view, uint64_t>;
+
+    // Constructor: Initializes with file handle, parser, and sorting engine.
     // Parameters:
     //   input_file: Unique pointer to the input file handle.
     //   parser: Unique pointer to the parser.
-    ChunkProcessor(std::unique_ptr<FileHandle> input_file, std::unique_ptr<Parser> parser) noexcept;
+    //   sort_algorithm: Engine used to sort the chunk's words.
+    ChunkProcessor(std::unique_ptr<FileHandle> input_file, std::unique_ptr<Parser> parser,
+                   SortAlgorithm sort_algorithm = SortAlgorithm::MsdRadix) noexcept;
 
-    // process: Processes a chunk and writes sorted words to a temporary file.
+    // process: Processes a chunk and writes its sorted distinct words to a temporary file.
+    // Runs the load, parse, sort and spill stages back to back on the calling thread.
     // Parameters:
     //   start_offset: Starting offset in the input file.
     //   chunk_size: Size of the chunk.
     //   temp_filename: Name of the temporary file.
     void process(off_t start_offset, size_t chunk_size, const std::string& temp_filename) noexcept;
 
+    // collect_distinct: Parses a chunk and reduces it to its distinct words.
+    // Parameters:
+    //   start_offset: Starting offset in the input file.
+    //   chunk_size: Size of the chunk.
+    //   arena: Arena owning the chunk's bytes when it cannot be mapped.
+    //   words: Output vector of unsorted distinct word views; valid while the
+    //          processor (for mapped chunks) and the arena are alive.
+    // Returns: True on success, false on I/O error.
+    bool collect_distinct(off_t start_offset, size_t chunk_size, WordArena& arena,
+                          std::vector<std::string_view>& words) noexcept;
+
+    // load: Read stage. Makes a chunk's bytes addressable in memory.
+    // Parameters:
+    //   start_offset: Starting offset in the input file.
+    //   chunk_size: Size of the chunk.
+    //   arena: Arena receiving the bytes when the chunk cannot be mapped.
+    //   loaded_size: Output number of bytes available (short at end of file).
+    // Returns: Pointer to the chunk's bytes, or nullptr on I/O error.
+    const char* load(off_t start_offset, size_t chunk_size, WordArena& arena, size_t& loaded_size) noexcept;
+
+    // parse_distinct: Parse stage. Extracts the distinct words of loaded bytes.
+    // Parameters:
+    //   data: Chunk bytes returned by load().
+    //   size: Number of bytes.
+    //   words: Output vector of unsorted distinct word views into data.
+    void parse_distinct(const char* data, size_t size, std::vector<std::string_view>& words) noexcept;
+
+    // parse_counts: Parse stage for frequency runs. Extracts the distinct words and their counts.
+    // Parameters:
+    //   data: Chunk bytes returned by load().
+    //   size: Number of bytes.
+    //   words: Output vector of unsorted distinct word views into data.
+    //   counts: Output occurrences of every distinct word.
+    void parse_counts(const char* data, size_t size, std::vector<std::string_view>& words,
+                      WordCounts& counts) noexcept;
+
+    // sort: Sort stage. Orders words with the processor's sorting engine.
+    // Parameters:
+    //   words: Word views to sort in place.
+    void sort(std::vector<std::string_view>& words) noexcept;
+
+    // spill: Write stage. Writes sorted words to a run file.
+    // Parameters:
+    //   words: Sorted distinct words.
+    //   temp_filename: Name of the run file to create.
+    //   counts: Occurrences of the words to store in a counting run, or nullptr for a plain run.
+    //   cache_mode: Page cache use of the run file (falls back to BUFFERED if unsupported).
+    //   bytes_written: Receives the size of the run file; may be nullptr.
+    // Returns: True on success, false on I/O error.
+    static bool spill(const std::vector<std::string_view>& words, const std::string& temp_filename,
+                      const WordCounts* counts = nullptr, CacheMode cache_mode = CacheMode::BUFFERED,
+                      size_t* bytes_written = nullptr) noexcept;
+
+    // words_parsed: Words the parse stage has seen, duplicates included.
+    // Returns: Total over every parse_distinct() and parse_counts() call of this processor.
+    size_t words_parsed() const noexcept {
+        return words_parsed_;
+    }
+
+    // open_chunk: Opens a handle over one chunk of the input.
+    // Parameters:
+    //   input_fd: Descriptor of the input file; not owned, must outlive the handle.
+    //   start_offset: Starting offset of the chunk.
+    //   chunk_size: Size of the chunk.
+    //   cache_mode: Cache mode of the input handle.
+    // Returns: A mapping of the chunk, or overlapped reads through a duplicate descriptor
+    //          when the chunk cannot be mapped or DIRECT mode bypasses the page cache.
+    static std::unique_ptr<FileHandle> open_chunk(int input_fd, off_t start_offset, size_t chunk_size,
+                                                  CacheMode cache_mode) noexcept;
+
 private:
     std::unique_ptr<FileHandle> input_file_; // File handle for reading input.
     std::unique_ptr<Parser> parser_;         // Parser for word extraction.
+    SortAlgorithm sort_algorithm_;           // Engine used to sort chunk words.
+    size_t words_parsed_;                    // Words parsed so far, duplicates included.
 };
 
 #endif // CHUNK_PROCESSOR_HPP
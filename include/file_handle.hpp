@@ -4,10 +4,35 @@
 // file_handle.hpp: Declarations for FileHandle interface and SyscallFileHandle class.
 // Provides an abstract interface for file operations and a syscall-based implementation.
 
+#include <memory>
 #include <string>
 #include <unistd.h>
 #include <fcntl.h>
 
+// CacheMode: How a handle's transfers use the page cache.
+enum class CacheMode {
+    BUFFERED, // Kernel defaults.
+    STREAM,   // Sequential advice and explicit readahead; transferred ranges are dropped from the cache.
+    DIRECT    // O_DIRECT transfers through aligned buffers, bypassing the cache.
+};
+
+// Alignment of O_DIRECT buffers, file offsets and transfer sizes.
+constexpr size_t DIRECT_ALIGNMENT = 4096;
+
+// AlignedFree: Deleter for memory returned by allocate_aligned().
+struct AlignedFree {
+    void operator()(char* data) const noexcept;
+};
+
+// AlignedBuffer: Owning pointer to DIRECT_ALIGNMENT-aligned bytes.
+using AlignedBuffer = std::unique_ptr<char[], AlignedFree>;
+
+// allocate_aligned: Allocates a buffer usable for O_DIRECT transfers.
+// Parameters:
+//   size: Number of bytes.
+// Returns: Buffer aligned to DIRECT_ALIGNMENT, or nullptr if allocation fails.
+AlignedBuffer allocate_aligned(size_t size) noexcept;
+
 // FileHandle: Abstract interface for file operations.
 // Defines methods for checking file status, seeking, reading, and writing.
 class FileHandle {
@@ -34,6 +59,15 @@ public:
     // Returns: Number of bytes read, or -1 on error.
     virtual ssize_t read(char* buffer, size_t size) = 0;
 
+    // pread: Reads data at an absolute offset without using the file offset.
+    // Parameters:
+    //   buffer: Destination buffer.
+    //   size: Number of bytes to read.
+    //   offset: Absolute file offset of the first byte.
+    // Returns: Number of bytes read, or -1 on error.
+    // Threads sharing one descriptor can read through it concurrently.
+    virtual ssize_t pread(char* buffer, size_t size, off_t offset) = 0;
+
     // write: Writes data to the file.
     // Parameters:
     //   buffer: Source buffer.
@@ -41,12 +75,52 @@ public:
     // Returns: Number of bytes written, or -1 on error.
     virtual ssize_t write(const char* buffer, size_t size) = 0;
 
+    // view: Provides zero-copy access to a byte range of the file.
+    // Parameters:
+    //   offset: Absolute file offset of the first byte.
+    //   size: Number of bytes requested.
+    // Returns: Pointer to the bytes if the range is memory-mapped, nullptr otherwise.
+    // Handles without a mapping keep this default and are read through read().
+    virtual const char* view(off_t offset, size_t size) const noexcept {
+        (void)offset;
+        (void)size;
+        return nullptr;
+    }
+
+    // flush: Waits until every accepted write has reached the file.
+    // Returns: True on success, false if a deferred write failed.
+    // Handles that write synchronously keep this default.
+    virtual bool flush() noexcept {
+        return true;
+    }
+
+    // set_cache_mode: Chooses how later transfers use the page cache.
+    // Parameters:
+    //   mode: Cache mode; call before the first transfer.
+    // Returns: True if the mode is in effect, false if the handle or file system does not support it.
+    virtual bool set_cache_mode(CacheMode mode) noexcept {
+        return mode == CacheMode::BUFFERED;
+    }
+
+    // cache_mode: Reports the mode in effect.
+    // Returns: The cache mode.
+    virtual CacheMode cache_mode() const noexcept {
+        return CacheMode::BUFFERED;
+    }
+
     // Destructor: Virtual to ensure proper cleanup in derived classes.
     virtual ~FileHandle() noexcept = default;
 };
 
 // SyscallFileHandle: RAII-compliant implementation of FileHandle using Linux syscalls.
 // Manages file descriptors with automatic closure on destruction.
+// In STREAM mode reads issue readahead() ahead of the offset, and every few megabytes of
+// transferred data are dropped from the page cache (writes are flushed first, and flush()
+// releases the rest). In DIRECT
+// mode the descriptor is reopened with O_DIRECT: unaligned reads go through an aligned bounce buffer,
+// and writes are staged into aligned blocks, with the unaligned tail written through a second
+// descriptor opened without O_DIRECT.
+// The bounce buffer is per handle, so a DIRECT handle must not be read by several threads at once.
 class SyscallFileHandle : public FileHandle {
 public:
     // Default constructor: Initializes with invalid file descriptor.
@@ -90,10 +164,110 @@ public:
     int get() const noexcept override;
     off_t seek(off_t offset, int whence) noexcept override;
     ssize_t read(char* buffer, size_t size) noexcept override;
+    ssize_t pread(char* buffer, size_t size, off_t offset) noexcept override;
+    ssize_t write(const char* buffer, size_t size) noexcept override;
+    bool flush() noexcept override;
+    bool set_cache_mode(CacheMode mode) noexcept override;
+    CacheMode cache_mode() const noexcept override;
+
+protected:
+    // release: Drops transferred data from the page cache in STREAM mode.
+    // Parameters:
+    //   offset: File offset of the transferred range.
+    //   size: Number of bytes transferred.
+    //   written: True for writes, whose pages must be written back before they can be dropped.
+    void release(off_t offset, size_t size, bool written) noexcept;
+
+    // pwrite_cached: Writes at an offset through the page cache, even if O_DIRECT is set.
+    // Returns: True if every byte was written.
+    bool pwrite_cached(const char* buffer, size_t size, off_t offset) noexcept;
+
+private:
+    // prefetch: Starts readahead of the STREAM window when a read reaches past it.
+    void prefetch(off_t offset, size_t size) noexcept;
+
+    // direct_pread: Reads through the bounce buffer when the request is not aligned.
+    // Returns: Bytes read (possibly fewer than requested), or -1 on error.
+    ssize_t direct_pread(char* buffer, size_t size, off_t offset) noexcept;
+
+    // flush_stage: Writes staged DIRECT bytes.
+    // Parameters:
+    //   all: True to write the unaligned tail as well and move the file offset past it.
+    // Returns: True on success.
+    bool flush_stage(bool all) noexcept;
+
+    // reset_cache: Returns the cache state to BUFFERED without touching the descriptor.
+    void reset_cache() noexcept;
+
+    int fd_;                                  // File descriptor managed by the class.
+    CacheMode cache_mode_ = CacheMode::BUFFERED; // Page cache policy.
+    off_t readahead_end_ = 0;                 // End of the range readahead() was last issued for.
+    off_t release_start_ = 0;                 // Start of the transferred range not yet released.
+    off_t release_end_ = 0;                   // End of that range.
+    off_t writeback_start_ = 0;               // Start of the written window whose writeback was started.
+    off_t writeback_end_ = 0;                 // End of that window.
+    AlignedBuffer direct_buffer_;             // Bounce and staging buffer of DIRECT mode.
+    size_t staged_ = 0;                       // Bytes staged in direct_buffer_.
+    off_t stage_offset_ = 0;                  // File offset of the first staged byte.
+    int cached_fd_ = -1;                      // Description without O_DIRECT for unaligned writes.
+};
+
+// MappedFileHandle: Read-only FileHandle backed by an mmap of a file window.
+// Maps [offset, offset + length) of a descriptor it does not own and advises the kernel
+// of sequential access, so parsers can scan the page cache without copying.
+// Offsets passed to seek() and view() are absolute file offsets. In STREAM mode the
+// window is read ahead at once and dropped from the page cache when it is unmapped.
+class MappedFileHandle : public FileHandle {
+public:
+    // Default constructor: Initializes with no mapping.
+    MappedFileHandle() noexcept;
+
+    // Constructor: Maps a window of an open file.
+    // Parameters:
+    //   fd: Open file descriptor (not owned, must outlive the handle).
+    //   offset: Absolute file offset of the window start (need not be page-aligned).
+    //   length: Number of bytes to map.
+    // The handle is not open if the window is empty or mmap fails.
+    MappedFileHandle(int fd, off_t offset, size_t length) noexcept;
+
+    // Copy constructor: Deleted to prevent double unmapping.
+    MappedFileHandle(const MappedFileHandle&) = delete;
+
+    // Copy assignment: Deleted to prevent double unmapping.
+    MappedFileHandle& operator=(const MappedFileHandle&) = delete;
+
+    // Move constructor: Transfers mapping ownership.
+    MappedFileHandle(MappedFileHandle&& other) noexcept;
+
+    // Move assignment: Transfers mapping ownership.
+    MappedFileHandle& operator=(MappedFileHandle&& other) noexcept;
+
+    // Destructor: Unmaps the window if mapped.
+    ~MappedFileHandle() noexcept;
+
+    // Implement FileHandle interface methods.
+    bool is_open() const noexcept override;
+    int get() const noexcept override;
+    off_t seek(off_t offset, int whence) noexcept override;
+    ssize_t read(char* buffer, size_t size) noexcept override;
+    ssize_t pread(char* buffer, size_t size, off_t offset) noexcept override;
     ssize_t write(const char* buffer, size_t size) noexcept override;
+    const char* view(off_t offset, size_t size) const noexcept override;
+    bool set_cache_mode(CacheMode mode) noexcept override;
+    CacheMode cache_mode() const noexcept override;
 
 private:
-    int fd_; // File descriptor managed by the class.
+    // unmap: Releases the current mapping, if any.
+    void unmap() noexcept;
+
+    int fd_;             // Borrowed file descriptor the window was mapped from.
+    void* map_base_;     // Page-aligned base address returned by mmap.
+    size_t map_length_;  // Length of the mapping starting at map_base_.
+    const char* data_;   // Pointer to the byte at file offset offset_.
+    off_t offset_;       // Absolute file offset of the window start.
+    size_t length_;      // Number of bytes in the window.
+    off_t position_;     // Current absolute offset for read().
+    bool stream_;        // True to drop the window from the page cache on unmap.
 };
 
 #endif // FILE_HANDLE_HPP
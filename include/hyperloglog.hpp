@@ -0,0 +1,80 @@
+#ifndef HYPERLOGLOG_HPP
+#define HYPERLOGLOG_HPP
+
+// hyperloglog.hpp: Declaration of HyperLogLog class for approximate distinct counting.
+// Estimates the number of distinct words in fixed memory, with mergeable sketches.
+
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+// HyperLogLog: Cardinality sketch of 2^precision one-byte registers.
+// Each word is hashed to 64 bits; the top precision bits pick a register and the
+// register keeps the longest run of leading zeros seen in the remaining bits.
+// Sketches built on different threads merge by taking register-wise maxima, and the
+// estimate uses Ertl's improved estimator, which is unbiased from tiny to huge
+// cardinalities without the empirical bias tables of HLL++.
+class HyperLogLog final {
+public:
+    // Default precision: 2^14 registers (16 KiB) for a standard error of about 0.81%.
+    static constexpr unsigned DEFAULT_PRECISION = 14;
+
+    // Supported precision range.
+    static constexpr unsigned MIN_PRECISION = 4;
+    static constexpr unsigned MAX_PRECISION = 18;
+
+    // Constructor: Creates an empty sketch.
+    // Parameters:
+    //   precision: Number of register index bits, clamped to [MIN_PRECISION, MAX_PRECISION].
+    explicit HyperLogLog(unsigned precision = DEFAULT_PRECISION) noexcept;
+
+    // add: Records one word.
+    // Parameters:
+    //   word: Word to record; duplicates do not change the sketch.
+    void add(std::string_view word) noexcept {
+        add_hash(hash(word));
+    }
+
+    // add_hash: Records one 64-bit word hash.
+    // Parameters:
+    //   value: Hash of the word.
+    void add_hash(uint64_t value) noexcept {
+        const uint64_t rest = value << precision_;
+        const uint8_t rank =
+            rest == 0 ? static_cast<uint8_t>(65 - precision_) : static_cast<uint8_t>(__builtin_clzll(rest) + 1);
+        uint8_t& reg = registers_[value >> (64 - precision_)];
+        if (rank > reg) {
+            reg = rank;
+        }
+    }
+
+    // merge: Folds another sketch into this one, as if its words were added here.
+    // Parameters:
+    //   other: Sketch of the same precision.
+    // Returns: False (leaving this sketch unchanged) if the precisions differ.
+    bool merge(const HyperLogLog& other) noexcept;
+
+    // estimate: Estimates the number of distinct words added.
+    // Returns: Cardinality estimate.
+    double estimate() const noexcept;
+
+    // standard_error: Relative standard error of estimate().
+    // Returns: 1.04 / sqrt(2^precision).
+    double standard_error() const noexcept;
+
+    // precision: Number of register index bits.
+    // Returns: The clamped precision.
+    unsigned precision() const noexcept;
+
+    // hash: Hashes a word to 64 well-mixed bits.
+    // Parameters:
+    //   word: Word to hash.
+    // Returns: Hash whose bits are all usable for register selection and ranks.
+    static uint64_t hash(std::string_view word) noexcept;
+
+private:
+    unsigned precision_;             // Register index bits.
+    std::vector<uint8_t> registers_; // Longest leading-zero run + 1 per register.
+};
+
+#endif // HYPERLOGLOG_HPP
@@ -0,0 +1,98 @@
+#ifndef IN_MEMORY_COUNTER_HPP
+#define IN_MEMORY_COUNTER_HPP
+
+// in_memory_counter.hpp: Declaration of InMemoryCounter class for the exact in-RAM fast path.
+// Counts unique words with a shared hash set and hands off to external sorting on overflow.
+
+#include "file_handle.hpp"
+#include "input_files.hpp"
+#include "sharded_word_set.hpp"
+#include "temp_file.hpp"
+#include "thread_pool.hpp"
+#include <atomic>
+#include <memory>
+
+// InMemoryCounter: Counts unique words without temporary files while they fit in memory.
+// Worker threads claim word-aligned chunks in file order, deduplicate each chunk locally,
+// and insert it into a ShardedWordSet. Once the set's memory estimate crosses the
+// threshold, no further chunks are claimed; the caller spills the set as one sorted run
+// and processes the rest of the file from resume_offset() with ChunkCoordinator.
+// Several input files are scanned as one: chunks are claimed file after file, and the
+// resume position names the input as well as the offset within it.
+class InMemoryCounter final {
+public:
+    // Default chunk size: 16 MiB keeps per-thread word views small and balances load.
+    static constexpr size_t DEFAULT_CHUNK_SIZE = 16ULL << 20;
+
+    // Constructor: Initializes with the input file and spill threshold.
+    // Parameters:
+    //   input_file: Unique pointer to the input file handle.
+    //   file_size: Total size of the input file.
+    //   memory_threshold: Set size (estimated bytes) above which counting stops.
+    //   chunk_size: Nominal size of each chunk claimed by a worker.
+    //   pool: Worker pool that runs the scanning loops.
+    InMemoryCounter(std::unique_ptr<FileHandle> input_file, size_t file_size, size_t memory_threshold,
+                    size_t chunk_size = DEFAULT_CHUNK_SIZE, ThreadPool& pool = ThreadPool::shared()) noexcept;
+
+    // Constructor: Initializes with several input files counted as one.
+    // Parameters:
+    //   inputs: Input files and their sizes, scanned in order.
+    //   memory_threshold: Set size (estimated bytes) above which counting stops.
+    //   chunk_size: Nominal size of each chunk claimed by a worker.
+    //   pool: Worker pool that runs the scanning loops.
+    InMemoryCounter(std::vector<InputFile> inputs, size_t memory_threshold, size_t chunk_size = DEFAULT_CHUNK_SIZE,
+                    ThreadPool& pool = ThreadPool::shared()) noexcept;
+
+    // count: Inserts chunk words into the set until the file ends or memory runs short.
+    // Returns: True if the whole file was counted, false if the threshold was crossed or a
+    //          chunk could not be read; the external pass continues from resume_offset().
+    bool count() noexcept;
+
+    // unique_count: Number of distinct words inserted so far.
+    // Returns: Exact unique count when count() returned true.
+    size_t unique_count() const noexcept;
+
+    // words_scanned: Words parsed by count() so far, duplicates included.
+    // Returns: Word count over every counted chunk.
+    size_t words_scanned() const noexcept;
+
+    // bytes_scanned: Input bytes counted by count() so far.
+    // Returns: Byte count over every counted chunk.
+    size_t bytes_scanned() const noexcept;
+
+    // resume_offset: First byte of resume_input() not yet counted.
+    // Returns: Word-aligned offset where external processing must continue.
+    off_t resume_offset() const noexcept;
+
+    // resume_input: Input that resume_offset() refers to; earlier inputs are fully counted.
+    // Returns: Index into the inputs.
+    size_t resume_input() const noexcept;
+
+    // release_inputs: Hands the input files over to the external pass; count() cannot run afterwards.
+    // Returns: The input files and their sizes, in order.
+    std::vector<InputFile> release_inputs() noexcept;
+
+    // spill: Writes the set's words as one sorted run for the external merge and
+    // releases the set's memory (unique_count() is zero afterwards).
+    // Parameters:
+    //   temp_file: Receives the TempFile holding the run.
+    // Returns: True on success, false if the run could not be opened or written.
+    bool spill(TempFile& temp_file) noexcept;
+
+    // default_memory_threshold: Derives a threshold from the machine's physical memory.
+    // Returns: A quarter of physical RAM, leaving room for mapped input and word views.
+    static size_t default_memory_threshold() noexcept;
+
+private:
+    std::vector<InputFile> inputs_;     // Input files, scanned in order.
+    size_t memory_threshold_;           // Spill threshold in bytes.
+    size_t chunk_size_;                 // Nominal chunk size.
+    ThreadPool& pool_;                  // Pool running the scanning loops.
+    size_t resume_input_;               // Input of the first byte not yet counted.
+    off_t resume_offset_;               // First byte of that input not yet counted.
+    ShardedWordSet words_;              // Distinct words seen so far.
+    std::atomic<size_t> words_scanned_; // Words parsed, duplicates included.
+    std::atomic<size_t> bytes_scanned_; // Input bytes of the counted chunks.
+};
+
+#endif // IN_MEMORY_COUNTER_HPP
@@ -0,0 +1,84 @@
+#ifndef INCREMENTAL_COUNTER_HPP
+#define INCREMENTAL_COUNTER_HPP
+
+// incremental_counter.hpp: Declaration of IncrementalCounter class for append-only inputs.
+// Counts unique words against a persisted sorted dictionary, parsing only the appended bytes.
+
+#include "file_handle.hpp"
+#include "word_counter.hpp"
+#include <cstdint>
+#include <memory>
+#include <string>
+
+// IncrementalCounter: Counts the unique words of an append-only file against a dictionary.
+// The dictionary is a plain run (see run_format.hpp) of the distinct words in the file's
+// first processed bytes; its footer records that offset, the word count and a fingerprint
+// of the bytes before the offset. A count parses only the bytes after the offset into
+// sorted runs, merges them with the dictionary into a new dictionary, and replaces the
+// old one by rename. A missing dictionary, or one whose fingerprint no longer matches the
+// file (truncated or rewritten), makes the count start from offset 0.
+// The processed offset always ends at a space: a last word without a space behind it may
+// still grow, so it is counted but left out of the dictionary and parsed again next time.
+class IncrementalCounter final {
+public:
+    // Bytes before the processed offset that the fingerprint covers.
+    static constexpr size_t FINGERPRINT_SIZE = 4096;
+
+    // Size of the dictionary footer: "WCDI", processed offset, word count, fingerprint.
+    static constexpr size_t STATE_SIZE = 28;
+
+    // State: What a dictionary covers.
+    struct State {
+        uint64_t processed;   // Input bytes whose words the dictionary holds.
+        uint64_t words;       // Distinct words in the dictionary.
+        uint64_t fingerprint; // fingerprint() of the input at processed.
+    };
+
+    // Constructor: Initializes with the input file and the dictionary's path.
+    // Parameters:
+    //   input_file: Unique pointer to the input file handle.
+    //   file_size: Total size of the input file.
+    //   dictionary_path: Dictionary to read and replace; created if it does not exist.
+    //   options: Merge options (buffer memory, cache mode) of the dictionary update.
+    //   memory_limit: Budget of the chunks parsed from the appended bytes; 0 for none.
+    IncrementalCounter(std::unique_ptr<FileHandle> input_file, size_t file_size, std::string dictionary_path,
+                       WordCounter::Options options = WordCounter::Options(), size_t memory_limit = 0) noexcept;
+
+    // count: Counts the file's unique words and updates the dictionary.
+    // Returns: True on success, false if the input, a run or the dictionary could not be read
+    //          or the dictionary written; the old dictionary is then kept.
+    bool count() noexcept;
+
+    // unique_count: Number of distinct words in the whole file.
+    // Returns: The count of the last successful count().
+    size_t unique_count() const noexcept;
+
+    // resume_offset: Offset the last count() started parsing at.
+    // Returns: The dictionary's processed offset, or 0 if it was missing or did not match.
+    off_t resume_offset() const noexcept;
+
+    // read_state: Loads the footer of a dictionary.
+    // Parameters:
+    //   path: Dictionary file.
+    //   state: Receives the recorded state.
+    // Returns: True if the file is a finished run with a dictionary footer.
+    static bool read_state(const std::string& path, State& state) noexcept;
+
+    // fingerprint: Hashes the end of the input's first bytes.
+    // Parameters:
+    //   input: Input file.
+    //   offset: Length of the prefix.
+    // Returns: Hash of the offset and the last FINGERPRINT_SIZE bytes before it, or 0 on a read error.
+    static uint64_t fingerprint(FileHandle& input, uint64_t offset) noexcept;
+
+private:
+    std::unique_ptr<FileHandle> input_file_; // File handle for the input file.
+    size_t file_size_;                       // Total size of the input file.
+    std::string dictionary_path_;            // Dictionary to read and replace.
+    WordCounter::Options options_;           // Merge options of the update.
+    size_t memory_limit_;                    // Budget of the parsed chunks.
+    size_t unique_count_;                    // Result of the last count.
+    off_t resume_offset_;                    // Start of the last parse.
+};
+
+#endif // INCREMENTAL_COUNTER_HPP
@@ -0,0 +1,73 @@
+#ifndef INPUT_FILES_HPP
+#define INPUT_FILES_HPP
+
+// input_files.hpp: Declarations for multi-file input: the InputFile list and InputCursor class.
+// Resolves glob patterns and manifest files, and hands out chunks across a list of inputs.
+
+#include "file_handle.hpp"
+#include <memory>
+#include <string>
+#include <sys/types.h>
+#include <vector>
+
+// InputFile: One input file of a run and its size.
+struct InputFile {
+    std::unique_ptr<FileHandle> file; // Handle on the file.
+    size_t size;                      // Size of the file in bytes.
+};
+
+// InputCursor: Claims word-aligned chunks across a list of inputs, in input order.
+// The inputs are treated as one sequence of words: chunks never span two files, and
+// the end of every file is a word boundary. Not thread-safe; workers claim under a lock.
+class InputCursor final {
+public:
+    // Constructor: Starts at a position in the list.
+    // Parameters:
+    //   inputs: Inputs to hand out; not owned, must outlive the cursor.
+    //   chunk_size: Nominal chunk size; actual chunks end at the next space.
+    //   input: Index of the input to start in.
+    //   offset: Word-aligned offset to start from within that input.
+    InputCursor(const std::vector<InputFile>& inputs, size_t chunk_size, size_t input = 0, off_t offset = 0) noexcept;
+
+    // claim: Takes the next chunk.
+    // Parameters:
+    //   input: Output index of the chunk's input.
+    //   start: Output offset of the chunk within that input.
+    //   size: Output number of bytes in the chunk.
+    // Returns: True if a chunk was claimed, false once every input is exhausted.
+    bool claim(size_t& input, off_t& start, size_t& size) noexcept;
+
+    // done: Checks if every input has been handed out.
+    // Returns: True if no bytes are left.
+    bool done() const noexcept;
+
+    // input: Index of the input the next chunk comes from.
+    // Returns: Input index (the last input once all are exhausted).
+    size_t input() const noexcept;
+
+    // offset: Offset of the next chunk within input().
+    // Returns: Word-aligned offset.
+    off_t offset() const noexcept;
+
+private:
+    const std::vector<InputFile>& inputs_; // Inputs in claim order.
+    size_t chunk_size_;                    // Nominal chunk size.
+    size_t input_;                         // Input of the next chunk.
+    off_t offset_;                         // Offset of the next chunk within it.
+};
+
+// expand_input_name: Adds the files an input argument names.
+// Parameters:
+//   name: File name, "-", or a glob pattern (containing *, ? or [).
+//   names: Receives the file names; a pattern adds its matches in sorted order.
+// Returns: True on success, false if a pattern matches no file.
+bool expand_input_name(const char* name, std::vector<std::string>& names) noexcept;
+
+// read_manifest: Adds the inputs listed in a manifest file.
+// Parameters:
+//   filename: Manifest with one file name or glob pattern per line; blank lines are skipped.
+//   names: Receives the expanded file names.
+// Returns: True on success, false if the manifest cannot be read or a pattern matches nothing.
+bool read_manifest(const char* filename, std::vector<std::string>& names) noexcept;
+
+#endif // INPUT_FILES_HPP
@@ -0,0 +1,215 @@
+#ifndef IO_URING_FILE_HANDLE_HPP
+#define IO_URING_FILE_HANDLE_HPP
+
+// io_uring_file_handle.hpp: Declarations for IoUring and IoUringFileHandle classes.
+// Keeps several large reads or writes in flight through a per-thread io_uring submission queue.
+
+#include "file_handle.hpp"
+#include <memory>
+#include <mutex>
+#include <vector>
+
+struct io_uring_sqe;
+struct io_uring_cqe;
+
+// IoUring: Minimal io_uring instance driven through the raw setup/enter syscalls.
+// Requests are plain reads and writes at explicit offsets; each one is tied to a
+// caller-owned Request that receives the completion result. One ring is shared by
+// every handle of a thread (see for_thread()), so the run readers of a merge and the
+// run writer it feeds all submit through the same queue and are reaped together.
+class IoUring final {
+public:
+    // Default number of submission queue entries.
+    static constexpr unsigned DEFAULT_ENTRIES = 64;
+
+    // Request: Completion slot of one submitted operation.
+    struct Request {
+        ssize_t result = 0; // Bytes transferred, or -errno.
+        bool done = true;   // False while the operation is in flight.
+    };
+
+    // Constructor: Sets up the ring and maps its queues.
+    // Parameters:
+    //   entries: Submission queue size (rounded up to a power of two by the kernel).
+    // The ring is not open if the kernel does not support io_uring or setup fails.
+    explicit IoUring(unsigned entries = DEFAULT_ENTRIES) noexcept;
+
+    // Copy constructor: Deleted; the ring owns its descriptor and mappings.
+    IoUring(const IoUring&) = delete;
+
+    // Copy assignment: Deleted; the ring owns its descriptor and mappings.
+    IoUring& operator=(const IoUring&) = delete;
+
+    // Destructor: Waits for in-flight operations, then unmaps the queues and closes the ring.
+    ~IoUring() noexcept;
+
+    // is_open: Checks if the ring was set up.
+    // Returns: True if operations can be submitted.
+    bool is_open() const noexcept;
+
+    // submit_read: Starts a positional read.
+    // Parameters:
+    //   fd: Descriptor to read from.
+    //   buffer: Destination; must stay valid until the request is done.
+    //   size: Number of bytes to read.
+    //   offset: Absolute file offset.
+    //   request: Completion slot; must stay valid until the request is done.
+    // Returns: True if the read was queued, false if it could not be submitted.
+    bool submit_read(int fd, char* buffer, size_t size, off_t offset, Request& request) noexcept;
+
+    // submit_write: Starts a positional write.
+    // Parameters:
+    //   fd: Descriptor to write to.
+    //   buffer: Source; must stay valid until the request is done.
+    //   size: Number of bytes to write.
+    //   offset: Absolute file offset.
+    //   request: Completion slot; must stay valid until the request is done.
+    // Returns: True if the write was queued, false if it could not be submitted.
+    bool submit_write(int fd, const char* buffer, size_t size, off_t offset, Request& request) noexcept;
+
+    // wait: Blocks until a request has completed, reaping any other completions on the way.
+    // Parameters:
+    //   request: Submitted request.
+    void wait(Request& request) noexcept;
+
+    // for_thread: Returns the calling thread's shared ring.
+    // Returns: The ring, or nullptr if io_uring is unavailable or disabled.
+    static std::shared_ptr<IoUring> for_thread() noexcept;
+
+    // set_enabled: Switches new handles between io_uring and the blocking syscalls.
+    // Parameters:
+    //   enabled: False to make for_thread() return nullptr (used by tests and benchmarks).
+    static void set_enabled(bool enabled) noexcept;
+
+    // available: Checks once whether the kernel supports io_uring.
+    // Returns: True if a ring can be set up and supports the read and write opcodes.
+    static bool available() noexcept;
+
+private:
+    // submit: Fills one submission entry and hands it to the kernel.
+    // Returns: True on success, false if io_uring_enter failed.
+    bool submit(unsigned char opcode, int fd, unsigned long long address, size_t size, off_t offset,
+                Request& request) noexcept;
+
+    // reap: Moves completions into their requests; requires mutex_.
+    // Parameters:
+    //   block: True to wait for at least one completion if none is ready.
+    void reap(bool block) noexcept;
+
+    std::mutex mutex_;          // Serializes queue updates.
+    int ring_fd_;               // Ring descriptor, or -1.
+    void* sq_ring_;             // Mapped submission ring.
+    size_t sq_ring_size_;       // Length of the submission ring mapping.
+    void* cq_ring_;             // Mapped completion ring (may alias sq_ring_).
+    size_t cq_ring_size_;       // Length of the completion ring mapping.
+    io_uring_sqe* sqes_;        // Mapped submission entries.
+    size_t sqes_size_;          // Length of the submission entry mapping.
+    unsigned* sq_tail_;         // Submission ring tail (written by us).
+    unsigned* sq_mask_;         // Submission ring index mask.
+    unsigned* sq_array_;        // Submission ring slot-to-entry array.
+    unsigned* cq_head_;         // Completion ring head (written by us).
+    unsigned* cq_tail_;         // Completion ring tail (written by the kernel).
+    unsigned* cq_mask_;         // Completion ring index mask.
+    io_uring_cqe* cqes_;        // Completion entries.
+    unsigned cq_entries_;       // Completion ring size.
+    unsigned in_flight_;        // Submitted requests not yet reaped.
+};
+
+// IoUringFileHandle: FileHandle that overlaps sequential I/O through io_uring.
+// Reads keep up to queue_depth block-sized reads in flight ahead of the logical file
+// position; writes are copied into blocks and submitted without waiting, so the caller
+// formats the next block while earlier ones reach the page cache. seek() and flush()
+// wait for everything in flight. Without a ring every call goes to the blocking syscalls.
+// Blocks are DIRECT_ALIGNMENT-aligned: in DIRECT mode the read window starts at the aligned
+// offset below the position, and write blocks that are not aligned (usually only the last
+// one) are written synchronously through the page cache.
+class IoUringFileHandle final : public SyscallFileHandle {
+public:
+    // Default number of blocks in flight.
+    static constexpr size_t DEFAULT_QUEUE_DEPTH = 4;
+
+    // Default block size: 1 MiB per request.
+    static constexpr size_t DEFAULT_BLOCK_SIZE = 1ULL << 20;
+
+    // Blocks in flight per run file: one transfers while the next is formatted or
+    // parsed, and a merge may hold hundreds of runs open at once.
+    static constexpr size_t RUN_QUEUE_DEPTH = 2;
+
+    // Constructor: Opens a file.
+    // Parameters:
+    //   filename: Path to the file.
+    //   flags: Open flags (e.g., O_RDONLY, O_WRONLY | O_CREAT).
+    //   mode: File permissions for created files.
+    //   queue_depth: Number of blocks kept in flight (at least one).
+    //   block_size: Size of every request.
+    IoUringFileHandle(const char* filename, int flags, mode_t mode = 0600, size_t queue_depth = DEFAULT_QUEUE_DEPTH,
+                      size_t block_size = DEFAULT_BLOCK_SIZE) noexcept;
+
+    // Constructor: Takes ownership of an existing file descriptor.
+    // Parameters:
+    //   fd: Existing file descriptor; I/O starts at its current offset.
+    //   queue_depth: Number of blocks kept in flight (at least one).
+    //   block_size: Size of every request.
+    IoUringFileHandle(int fd, size_t queue_depth, size_t block_size) noexcept;
+
+    // Destructor: Waits for in-flight operations before the descriptor is closed.
+    ~IoUringFileHandle() noexcept;
+
+    // async: Checks if the handle submits through io_uring.
+    // Returns: True if a ring is in use, false if calls fall back to blocking syscalls.
+    bool async() const noexcept;
+
+    // Override FileHandle methods.
+    off_t seek(off_t offset, int whence) noexcept override;
+    ssize_t read(char* buffer, size_t size) noexcept override;
+    ssize_t pread(char* buffer, size_t size, off_t offset) noexcept override;
+    ssize_t write(const char* buffer, size_t size) noexcept override;
+    bool flush() noexcept override;
+    bool set_cache_mode(CacheMode mode) noexcept override;
+
+private:
+    // Slot: One block-sized buffer and its request.
+    struct Slot {
+        AlignedBuffer data;       // Block buffer.
+        size_t size = 0;          // Bytes requested (writes: bytes filled).
+        off_t offset = 0;         // File offset of the block.
+        IoUring::Request request; // Completion of the block's request.
+    };
+
+    // Mode: Direction of the operations in flight.
+    enum class Mode { IDLE, READING, WRITING };
+
+    // init: Sizes the slots and picks the ring.
+    void init(size_t queue_depth, size_t block_size) noexcept;
+
+    // allocate: Gives a slot its block buffer on first use.
+    // Returns: False if the allocation failed.
+    bool allocate(Slot& slot) noexcept;
+
+    // submit_reads: Tops up the read-ahead window.
+    void submit_reads() noexcept;
+
+    // submit_fill: Submits the partially filled write block, if any.
+    void submit_fill() noexcept;
+
+    // complete_write: Checks a finished write, completing short writes synchronously.
+    void complete_write(Slot& slot) noexcept;
+
+    // drain: Waits for every block in flight and discards read-ahead.
+    // Returns: False if a write failed.
+    bool drain() noexcept;
+
+    std::shared_ptr<IoUring> ring_; // Shared ring of the creating thread, or nullptr.
+    std::vector<Slot> slots_;       // Circular queue of blocks.
+    size_t head_;                   // Oldest block in the queue.
+    size_t count_;                  // Blocks in the queue.
+    size_t fill_;                   // Write block being filled, or slots_.size().
+    size_t block_size_;             // Size of every request.
+    off_t position_;                // Logical file offset.
+    off_t next_read_;               // File offset of the next read-ahead block.
+    bool read_eof_;                 // True once a read came back short.
+    bool failed_;                   // True after a write error.
+    Mode mode_;                     // Direction of the queued blocks.
+};
+
+#endif // IO_URING_FILE_HANDLE_HPP
@@ -0,0 +1,103 @@
+#ifndef LOSER_TREE_HPP
+#define LOSER_TREE_HPP
+
+// loser_tree.hpp: Declaration of LoserTree class template for k-way merging of sorted word streams.
+// Replaces a binary heap with a tournament tree that replays a single leaf-to-root path per word.
+
+#include <string_view>
+#include <utility>
+#include <vector>
+
+// LoserTree: Tournament (loser) tree merging k sorted sources of words.
+// Source must provide `bool next(std::string_view& word) noexcept`, returning a view that
+// stays valid until its next call (e.g. RunReader). Each internal node stores the index of
+// the source that lost the match there, so advancing the winner costs about log2(k)
+// comparisons of string views and never moves or copies a word.
+template <typename Source>
+class LoserTree final {
+public:
+    // Constructor: Reads the first word of every source and plays the initial tournament.
+    // Parameters:
+    //   sources: Non-owning pointers to the sources; they must outlive the tree.
+    explicit LoserTree(std::vector<Source*> sources) noexcept
+        : sources_(std::move(sources)), words_(sources_.size()), exhausted_(sources_.size(), 0),
+          tree_(sources_.size() == 0 ? 1 : sources_.size(), 0) {
+        for (size_t i = 0; i < sources_.size(); ++i) {
+            exhausted_[i] = !sources_[i]->next(words_[i]);
+        }
+        if (!sources_.empty()) {
+            tree_[0] = build(1);
+        }
+    }
+
+    // empty: Checks whether every source is exhausted.
+    // Returns: True if no words remain.
+    bool empty() const noexcept {
+        return sources_.empty() || exhausted_[tree_[0]];
+    }
+
+    // top: Retrieves the smallest remaining word.
+    // Returns: View of the word, valid until the next call to pop(). Requires !empty().
+    std::string_view top() const noexcept {
+        return words_[tree_[0]];
+    }
+
+    // top_source: Retrieves the index of the source holding the smallest word.
+    // Returns: Index into the sources vector passed at construction. Requires !empty().
+    size_t top_source() const noexcept {
+        return tree_[0];
+    }
+
+    // pop: Advances the winning source and replays its path to the root.
+    void pop() noexcept {
+        const size_t winner = tree_[0];
+        exhausted_[winner] = !sources_[winner]->next(words_[winner]);
+        replay(winner);
+    }
+
+private:
+    // less: Orders two sources by their current word; exhausted sources sort last.
+    bool less(size_t a, size_t b) const noexcept {
+        if (exhausted_[a]) {
+            return false;
+        }
+        if (exhausted_[b]) {
+            return true;
+        }
+        return words_[a] < words_[b];
+    }
+
+    // build: Plays the initial tournament for the subtree rooted at node.
+    // Leaves live at positions k..2k-1; returns the winning source of the subtree.
+    size_t build(size_t node) noexcept {
+        const size_t k = sources_.size();
+        if (node >= k) {
+            return node - k;
+        }
+        size_t left = build(2 * node);
+        size_t right = build(2 * node + 1);
+        if (less(right, left)) {
+            std::swap(left, right);
+        }
+        tree_[node] = right;
+        return left;
+    }
+
+    // replay: Re-runs the matches from a leaf to the root after its source advanced.
+    void replay(size_t source) noexcept {
+        size_t winner = source;
+        for (size_t node = (source + sources_.size()) / 2; node > 0; node /= 2) {
+            if (less(tree_[node], winner)) {
+                std::swap(tree_[node], winner);
+            }
+        }
+        tree_[0] = winner;
+    }
+
+    std::vector<Source*> sources_;        // Sources being merged (not owned).
+    std::vector<std::string_view> words_; // Current word of each source.
+    std::vector<char> exhausted_;         // Non-zero once a source has no more words.
+    std::vector<size_t> tree_;            // tree_[0] is the winner; tree_[1..k-1] hold losers.
+};
+
+#endif // LOSER_TREE_HPP
@@ -4,8 +4,12 @@
 // parser.hpp: Declarations for Parser interface and SpaceSeparatedParser class.
 // Provides an abstract interface for parsing input into words and a space-separated implementation.
 
+#include <cstdint>
 #include <vector>
 #include <string>
+#include <string_view>
+#include <unordered_map>
+#include <unordered_set>
 
 // Parser: Abstract interface for parsing input buffers into words.
 class Parser {
@@ -17,16 +21,55 @@ public:
     //   words: Output vector to store parsed words.
     virtual void parse(const char* buffer, size_t size, std::vector<std::string>& words) = 0;
 
+    // parse: Splits a buffer into words without copying them.
+    // Parameters:
+    //   buffer: Input buffer to parse; must outlive the returned views (e.g. a mapping or arena).
+    //   size: Size of the buffer.
+    //   words: Output vector to store views of parsed words.
+    virtual void parse(const char* buffer, size_t size, std::vector<std::string_view>& words) = 0;
+
+    // parse: Adds the views of a buffer's words to a set as they are found, so repeated
+    // words are never stored.
+    // Parameters:
+    //   buffer: Input buffer to parse; must outlive the views.
+    //   size: Size of the buffer.
+    //   words: Set receiving the distinct words.
+    // Returns: Number of words parsed, duplicates included.
+    virtual size_t parse(const char* buffer, size_t size, std::unordered_set<std::string_view>& words) = 0;
+
+    // parse: Adds one to the count of each of a buffer's words as it is found.
+    // Parameters:
+    //   buffer: Input buffer to parse; must outlive the views.
+    //   size: Size of the buffer.
+    //   counts: Occurrences of every distinct word.
+    // Returns: Number of words parsed, duplicates included.
+    virtual size_t parse(const char* buffer, size_t size, std::unordered_map<std::string_view, uint64_t>& counts) = 0;
+
     // Destructor: Virtual to ensure proper cleanup in derived classes.
     virtual ~Parser() noexcept = default;
 };
 
 // SpaceSeparatedParser: Implementation of Parser for space-separated words.
-// Parses input assuming lowercase letters and spaces.
+// Parses input assuming lowercase letters and spaces, locating spaces with SIMD
+// compares selected once, on first use, from the CPU's capabilities.
 class SpaceSeparatedParser : public Parser {
 public:
     // parse: Splits buffer into words based on spaces.
     void parse(const char* buffer, size_t size, std::vector<std::string>& words) noexcept override;
+
+    // parse: Splits buffer into views of space-separated words.
+    void parse(const char* buffer, size_t size, std::vector<std::string_view>& words) noexcept override;
+
+    // parse: Inserts views of space-separated words into a set.
+    size_t parse(const char* buffer, size_t size, std::unordered_set<std::string_view>& words) noexcept override;
+
+    // parse: Counts the occurrences of space-separated words.
+    size_t parse(const char* buffer, size_t size,
+                 std::unordered_map<std::string_view, uint64_t>& counts) noexcept override;
+
+    // scanner_name: Reports the delimiter scanning kernel selected for this CPU.
+    // Returns: "avx512", "avx2", "sse2" or "scalar".
+    static const char* scanner_name() noexcept;
 };
 
 #endif // PARSER_HPP
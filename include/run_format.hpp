@@ -0,0 +1,151 @@
+#ifndef RUN_FORMAT_HPP
+#define RUN_FORMAT_HPP
+
+// run_format.hpp: Definitions of the binary on-disk format of sorted runs.
+// Shared by RunWriter, RunReader and the merge partitioner.
+
+#include "file_handle.hpp"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Run file layout, version 1 (integers little-endian):
+//   file header  "WCRN", u8 version, u8 flags, 2 zero bytes               (8 bytes)
+//   blocks       u32 payload size, u32 word count, payload                 (repeated)
+//                payload: per word varint shared-prefix length, varint suffix
+//                length, suffix bytes, and with FLAG_COUNTS a varint occurrence
+//                count. The first word of every block has no shared prefix, so
+//                each block decodes on its own.
+//   end marker   an empty block header                                     (8 zero bytes)
+//   index        varint block count, then per block varint offset,
+//                varint first-word length, first word
+//   footer       optional bytes of the run's owner, skipped by readers
+//                (a persisted dictionary keeps its state record here)
+//   trailer      u64 index offset, "WCIX"                                  (12 bytes)
+// Sorted neighbours share long prefixes, so front coding stores most words in a
+// few bytes; the block index lets the merge split runs by key without scanning them.
+namespace run_format {
+
+constexpr char FILE_MAGIC[4] = {'W', 'C', 'R', 'N'};  // First bytes of every run.
+constexpr char INDEX_MAGIC[4] = {'W', 'C', 'I', 'X'}; // Last bytes of every finished run.
+constexpr uint8_t VERSION = 1;                        // Current layout version.
+constexpr size_t FILE_HEADER_SIZE = 8;                // Magic, version and padding.
+constexpr size_t BLOCK_HEADER_SIZE = 8;               // Payload size and word count.
+constexpr size_t TRAILER_SIZE = 12;                   // Index offset and index magic.
+constexpr size_t MAX_VARINT_SIZE = 10;                // Longest encoding of a 64-bit value.
+constexpr size_t BLOCK_PAYLOAD_SIZE = 64ULL << 10;    // Target payload bytes per block.
+constexpr uint8_t FLAG_COUNTS = 1;                    // Every word carries its occurrence count.
+
+// RunBlock: Index entry of one block.
+struct RunBlock {
+    off_t offset;           // File offset of the block header.
+    std::string first_word; // First word stored in the block.
+};
+
+// RunIndex: Block index of a finished run.
+struct RunIndex {
+    std::vector<RunBlock> blocks; // Blocks in file order.
+    off_t data_end;               // File offset of the end marker.
+    off_t footer_offset;          // File offset just past the index, where the footer starts.
+    uint8_t flags;                // Header flags (FLAG_COUNTS).
+};
+
+// put_varint: Encodes a value as a LEB128 varint.
+// Parameters:
+//   out: Destination with room for MAX_VARINT_SIZE bytes.
+//   value: Value to encode.
+// Returns: Pointer past the last written byte.
+inline char* put_varint(char* out, uint64_t value) noexcept {
+    while (value >= 0x80) {
+        *out++ = static_cast<char>(value | 0x80);
+        value >>= 7;
+    }
+    *out++ = static_cast<char>(value);
+    return out;
+}
+
+// get_varint: Decodes a LEB128 varint.
+// Parameters:
+//   in: First byte of the encoding.
+//   end: End of the readable bytes.
+//   value: Receives the decoded value.
+// Returns: Pointer past the encoding, or nullptr if it is truncated or too long.
+inline const char* get_varint(const char* in, const char* end, uint64_t& value) noexcept {
+    value = 0;
+    for (unsigned shift = 0; in < end && shift < 64; shift += 7) {
+        const uint8_t byte = static_cast<uint8_t>(*in++);
+        value |= static_cast<uint64_t>(byte & 0x7f) << shift;
+        if ((byte & 0x80) == 0) {
+            return in;
+        }
+    }
+    return nullptr;
+}
+
+// put_u32: Stores a 32-bit value little-endian.
+inline void put_u32(char* out, uint32_t value) noexcept {
+    for (int i = 0; i < 4; ++i) {
+        out[i] = static_cast<char>(value >> (8 * i));
+    }
+}
+
+// get_u32: Loads a little-endian 32-bit value.
+inline uint32_t get_u32(const char* in) noexcept {
+    uint32_t value = 0;
+    for (int i = 0; i < 4; ++i) {
+        value |= static_cast<uint32_t>(static_cast<uint8_t>(in[i])) << (8 * i);
+    }
+    return value;
+}
+
+// put_u64: Stores a 64-bit value little-endian.
+inline void put_u64(char* out, uint64_t value) noexcept {
+    for (int i = 0; i < 8; ++i) {
+        out[i] = static_cast<char>(value >> (8 * i));
+    }
+}
+
+// get_u64: Loads a little-endian 64-bit value.
+inline uint64_t get_u64(const char* in) noexcept {
+    uint64_t value = 0;
+    for (int i = 0; i < 8; ++i) {
+        value |= static_cast<uint64_t>(static_cast<uint8_t>(in[i])) << (8 * i);
+    }
+    return value;
+}
+
+// write_file_header: Fills in the file header of the current version.
+// Parameters:
+//   out: Destination with room for FILE_HEADER_SIZE bytes.
+//   flags: Layout flags of the run (FLAG_COUNTS).
+void write_file_header(char* out, uint8_t flags = 0) noexcept;
+
+// check_file_header: Validates a file header.
+// Parameters:
+//   header: FILE_HEADER_SIZE bytes read from the start of a run.
+// Returns: True if the magic matches and the version and flags are supported.
+bool check_file_header(const char* header) noexcept;
+
+// file_flags: Reads the layout flags of a validated file header.
+inline uint8_t file_flags(const char* header) noexcept {
+    return static_cast<uint8_t>(header[5]);
+}
+
+// read_run_index: Loads the block index of a finished run.
+// Parameters:
+//   run: Handle to the run (its offset is moved).
+//   index: Receives the index.
+// Returns: True on success, false if the run is empty, unfinished or corrupt.
+bool read_run_index(FileHandle& run, RunIndex& index) noexcept;
+
+// read_run_footer: Loads the footer of a finished run.
+// Parameters:
+//   run: Handle to the run.
+//   index: Index loaded by read_run_index().
+//   footer: Receives the bytes between the index and the trailer.
+// Returns: True on success, false on a read error.
+bool read_run_footer(FileHandle& run, const RunIndex& index, std::string& footer) noexcept;
+
+} // namespace run_format
+
+#endif // RUN_FORMAT_HPP
@@ -0,0 +1,36 @@
+#ifndef RUN_PARTITION_HPP
+#define RUN_PARTITION_HPP
+
+// run_partition.hpp: Declarations for splitting sorted runs into disjoint key ranges.
+// Chooses splitter words from the runs' block indexes and maps them to block offsets.
+
+#include "run_format.hpp"
+#include <string>
+#include <string_view>
+#include <vector>
+
+// slice_begin: Finds where the words not less than a key start in a run.
+// Parameters:
+//   index: Block index of the run.
+//   key: Lower bound of the key range.
+// Returns: Offset of the block that may hold the first word >= key (the block before
+//          the first block starting at or above key), or the run's data end.
+off_t slice_begin(const run_format::RunIndex& index, std::string_view key) noexcept;
+
+// slice_end: Finds where the words less than a key end in a run.
+// Parameters:
+//   index: Block index of the run.
+//   key: Upper bound (exclusive) of the key range.
+// Returns: Offset of the first block whose first word is >= key, or the run's data end.
+off_t slice_end(const run_format::RunIndex& index, std::string_view key) noexcept;
+
+// sample_splitters: Chooses words that cut the union of sorted runs into similar slices.
+// Parameters:
+//   indexes: Block indexes of the runs.
+//   partitions: Number of slices wanted.
+// Returns: Strictly increasing splitters (at most partitions - 1; fewer when the runs
+//          have too few blocks). Slice i holds the words w with splitter[i-1] <= w < splitter[i].
+std::vector<std::string> sample_splitters(const std::vector<run_format::RunIndex>& indexes,
+                                          size_t partitions) noexcept;
+
+#endif // RUN_PARTITION_HPP
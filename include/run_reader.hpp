@@ -0,0 +1,83 @@
+#ifndef RUN_READER_HPP
+#define RUN_READER_HPP
+
+// run_reader.hpp: Declaration of RunReader class for buffered reading of sorted runs.
+// Streams front-coded words out of a binary run file in large blocks.
+
+#include "file_handle.hpp"
+#include <limits>
+#include <memory>
+#include <string>
+#include <string_view>
+
+// RunReader: Buffered word reader over one sorted run written by RunWriter.
+// Refills a large block with a single read() and rebuilds each word from the prefix
+// it shares with the previous word, so only the suffix bytes are copied per word.
+// Counting runs also yield each word's occurrence count; other runs report a count of 1.
+class RunReader final {
+public:
+    // Default block size: 1 MiB per run keeps syscalls rare without exhausting memory
+    // when hundreds of runs are merged at once.
+    static constexpr size_t DEFAULT_BLOCK_SIZE = 1ULL << 20;
+
+    // Constructor: Initializes with the run's file handle.
+    // Parameters:
+    //   file: Unique pointer to the run's file handle, positioned at the start of the
+    //         file (the header is validated) or at a block boundary.
+    //   block_size: Size of the refillable read buffer.
+    //   length: Number of bytes to read from the current position (a slice of whole blocks).
+    //   counts: True if a slice comes from a counting run (read from the header otherwise).
+    explicit RunReader(std::unique_ptr<FileHandle> file, size_t block_size = DEFAULT_BLOCK_SIZE,
+                       size_t length = std::numeric_limits<size_t>::max(), bool counts = false) noexcept;
+
+    // next: Advances to the next word in the run.
+    // Parameters:
+    //   word: Receives a view of the word, valid until the next call to next().
+    // Returns: True if a word was read, false at the end of the run or on error (see failed()).
+    bool next(std::string_view& word) noexcept;
+
+    // count: Occurrence count of the word returned by the last next().
+    // Returns: The stored count, or 1 if the run does not store counts.
+    uint64_t count() const noexcept {
+        return count_;
+    }
+
+    // failed: Whether reading stopped at an error rather than at the end of the run or slice.
+    // Returns: True after a read error, a run or slice that ends inside a block or before
+    //          the end marker, or a corrupt entry or header.
+    bool failed() const noexcept {
+        return failed_;
+    }
+
+private:
+    // start_block: Validates the file header if needed and loads the next whole block.
+    // Returns: True if a block with words is ready, false at the end marker or on error.
+    bool start_block() noexcept;
+
+    // ensure: Makes at least size unconsumed bytes available in the buffer.
+    // Returns: True on success, false if the file or slice ends first.
+    bool ensure(size_t size) noexcept;
+
+    // refill: Moves unconsumed bytes to the front of the buffer and reads more data.
+    // Parameters:
+    //   needed: Unconsumed bytes the buffer must be able to hold.
+    // Returns: True if new bytes were read, false at the end of the slice, or on a read error
+    //          or an early end of file (both set failed_).
+    bool refill(size_t needed) noexcept;
+
+    std::unique_ptr<FileHandle> file_; // File handle for the run.
+    std::unique_ptr<char[]> buffer_;   // Block buffer holding raw run bytes (left uninitialized).
+    size_t capacity_;                  // Size of the block buffer.
+    size_t begin_;                     // Offset of the first unconsumed byte.
+    size_t end_;                       // Offset one past the last valid byte.
+    size_t block_end_;                 // Offset one past the current block's payload.
+    size_t unread_;                    // Bytes of the slice not yet read from the file.
+    std::string word_;                 // Current word, rebuilt from shared prefix and suffix.
+    uint64_t count_;                   // Occurrence count of the current word.
+    bool counts_;                      // True if entries carry a count.
+    bool check_header_;                // True until the file header has been validated.
+    bool done_;                        // True once the end marker, slice end or an error is reached.
+    bool failed_;                      // True if reading stopped at an error.
+};
+
+#endif // RUN_READER_HPP
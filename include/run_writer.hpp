@@ -0,0 +1,96 @@
+#ifndef RUN_WRITER_HPP
+#define RUN_WRITER_HPP
+
+// run_writer.hpp: Declaration of RunWriter class for buffered writing of sorted runs.
+// Front-codes words into indexed blocks and batches them so spilling costs few write() calls.
+
+#include "file_handle.hpp"
+#include "run_format.hpp"
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// RunWriter: Buffered writer producing binary runs (see run_format.hpp) readable by RunReader.
+// Each word is stored as the length of the prefix it shares with the previous word plus
+// the remaining suffix. Words must be appended in sorted order for the coding to pay off
+// and for the merge to be correct; the writer does not check this. A counting run also
+// stores each word's occurrence count, so a run holds (word, count) pairs.
+class RunWriter final {
+public:
+    // Default block size: 1 MiB per flush.
+    static constexpr size_t DEFAULT_BLOCK_SIZE = 1ULL << 20;
+
+    // Constructor: Initializes with the run's file handle.
+    // Parameters:
+    //   file: Unique pointer to a file handle opened for writing.
+    //   block_size: Size of the write buffer; run blocks are at most this large
+    //               (and at most run_format::BLOCK_PAYLOAD_SIZE).
+    //   counts: True to store an occurrence count with every word.
+    explicit RunWriter(std::unique_ptr<FileHandle> file, size_t block_size = DEFAULT_BLOCK_SIZE,
+                       bool counts = false) noexcept;
+
+    // Copy constructor: Deleted; a run has a single writer.
+    RunWriter(const RunWriter&) = delete;
+
+    // Copy assignment: Deleted; a run has a single writer.
+    RunWriter& operator=(const RunWriter&) = delete;
+
+    // Destructor: Finishes the run if finish() was not called.
+    ~RunWriter() noexcept;
+
+    // append: Buffers one word of the run.
+    // Parameters:
+    //   word: Word to append.
+    //   count: Occurrences of the word; ignored unless the run stores counts.
+    // Returns: True on success, false if a write failed or the run is finished.
+    bool append(std::string_view word, uint64_t count = 1) noexcept;
+
+    // flush: Closes the current block and writes buffered bytes to the file.
+    // Returns: True on success, false on a write error.
+    bool flush() noexcept;
+
+    // finish: Flushes, then writes the end marker, block index, footer and trailer.
+    // Parameters:
+    //   footer: Bytes stored after the index for the run's owner (see run_format.hpp); may be empty.
+    // Returns: True on success, false on a write error. Later calls return the same result.
+    bool finish(std::string_view footer = std::string_view()) noexcept;
+
+    // bytes_written: Reports the number of bytes written to the file so far.
+    // Returns: Bytes flushed to the file.
+    size_t bytes_written() const noexcept;
+
+    // words_written: Reports the number of words appended.
+    // Returns: Word count.
+    size_t words_written() const noexcept;
+
+private:
+    // reserve: Makes room for size more bytes, writing out or growing the buffer.
+    // Returns: True on success, false on a write error.
+    bool reserve(size_t size) noexcept;
+
+    // close_block: Fills in the open block's header.
+    void close_block() noexcept;
+
+    // write_out: Writes every buffered byte before the open block, if any.
+    // Returns: True on success, false on a write error.
+    bool write_out() noexcept;
+
+    std::unique_ptr<FileHandle> file_;          // File handle for the run.
+    std::unique_ptr<char[]> buffer_;            // Pending bytes not yet written.
+    size_t capacity_;                           // Size of the buffer.
+    size_t used_;                               // Bytes currently buffered.
+    size_t written_;                            // Bytes written to the file.
+    size_t block_limit_;                        // Payload size at which a block is closed.
+    size_t block_start_;                        // Buffer offset of the open block's header.
+    bool block_open_;                           // True while a block is accepting words.
+    bool counts_;                               // True if every word carries a count.
+    uint32_t block_words_;                      // Words in the open block.
+    size_t words_;                              // Words appended to the run.
+    std::string previous_;                      // Last word of the open block.
+    std::vector<run_format::RunBlock> index_;   // Offset and first word of every block.
+    bool failed_;                               // True after a write error.
+    bool finished_;                             // True once finish() has run.
+};
+
+#endif // RUN_WRITER_HPP
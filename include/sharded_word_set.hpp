@@ -0,0 +1,65 @@
+#ifndef SHARDED_WORD_SET_HPP
+#define SHARDED_WORD_SET_HPP
+
+// sharded_word_set.hpp: Declaration of ShardedWordSet class for concurrent exact deduplication.
+// Lets many threads insert words into one set with low lock contention.
+
+#include "word_arena.hpp"
+#include <array>
+#include <atomic>
+#include <mutex>
+#include <string_view>
+#include <unordered_set>
+#include <vector>
+
+// ShardedWordSet: Thread-safe set of distinct words split into independently locked shards.
+// Words are hashed to a shard, copied into that shard's arena, and indexed by view, so a
+// stored word costs its bytes plus one hash node. Memory use is tracked for spill decisions.
+class ShardedWordSet final {
+public:
+    // Number of shards; a power of two well above typical core counts.
+    static constexpr size_t SHARD_COUNT = 64;
+
+    // Constructor: Initializes an empty set.
+    ShardedWordSet() noexcept;
+
+    // Copy constructor: Deleted; shards own mutexes and arenas.
+    ShardedWordSet(const ShardedWordSet&) = delete;
+
+    // Copy assignment: Deleted; shards own mutexes and arenas.
+    ShardedWordSet& operator=(const ShardedWordSet&) = delete;
+
+    // insert_batch: Inserts a batch of words, locking each shard at most once.
+    // Parameters:
+    //   words: Words to insert (duplicates are allowed); the views need not outlive the call.
+    void insert_batch(const std::vector<std::string_view>& words) noexcept;
+
+    // size: Counts the distinct words stored.
+    // Returns: Number of distinct words.
+    size_t size() const noexcept;
+
+    // memory_usage: Estimates the bytes held by all shards.
+    // Returns: Approximate memory footprint in bytes.
+    size_t memory_usage() const noexcept;
+
+    // words: Collects views of every stored word, in no particular order.
+    // Returns: Views valid for the lifetime of the set. Not safe during concurrent inserts.
+    std::vector<std::string_view> words() const noexcept;
+
+    // clear: Removes every word and releases the shards' memory.
+    // Not safe during concurrent inserts.
+    void clear() noexcept;
+
+private:
+    // Shard: One independently locked partition of the set.
+    struct Shard {
+        mutable std::mutex mutex;                   // Guards words and arena.
+        std::unordered_set<std::string_view> words; // Views into arena.
+        WordArena arena{1ULL << 20};                // Owns the stored word bytes.
+    };
+
+    std::array<Shard, SHARD_COUNT> shards_; // Partitions selected by word hash.
+    std::atomic<size_t> memory_usage_;      // Running estimate of bytes held.
+};
+
+#endif // SHARDED_WORD_SET_HPP
@@ -0,0 +1,108 @@
+#ifndef STATS_REPORT_HPP
+#define STATS_REPORT_HPP
+
+// stats_report.hpp: Declaration of StatsReport class for per-phase run statistics.
+// Collects phase timings and component counters and renders them as one JSON object.
+
+#include "chunk_pipeline.hpp"
+#include "temp_file.hpp"
+#include "thread_pool.hpp"
+#include "word_counter.hpp"
+#include <chrono>
+#include <string>
+#include <vector>
+
+// StatsReport: Where the time of one word_counter run went.
+// Phases are timed in wall and process CPU time (all threads), so CPU / wall shows how
+// parallel a phase ran. The counters of the components a phase used are credited to the
+// open phase when they are added: the pipeline's input bytes, parsed words and run bytes,
+// and the merge's bytes read and rewritten. Collecting costs a few clock reads per phase;
+// the components keep their own counters whether or not a report is printed.
+class StatsReport final {
+public:
+    // Phase: One timed step of a run.
+    struct Phase {
+        std::string name;              // Phase name, e.g. in_memory, chunks or merge.
+        std::chrono::nanoseconds wall; // Elapsed time.
+        std::chrono::nanoseconds cpu;  // CPU time of all threads of the process.
+        size_t bytes_read;             // Input or run bytes read.
+        size_t bytes_written;          // Run bytes written.
+        size_t words;                  // Words parsed or counted, duplicates included.
+    };
+
+    // RunStats: Sizes of the runs handed to the merge.
+    struct RunStats {
+        size_t count;       // Number of runs.
+        size_t total_bytes; // Sum of their sizes.
+        size_t min_bytes;   // Smallest run.
+        size_t max_bytes;   // Largest run.
+    };
+
+    // Constructor: Starts the total wall and CPU clocks.
+    StatsReport() noexcept;
+
+    // begin_phase: Ends the open phase, if any, and starts timing a new one.
+    // Parameters:
+    //   name: Phase name.
+    // Returns: The new phase; valid until the next begin_phase() call.
+    Phase& begin_phase(const std::string& name) noexcept;
+
+    // end_phase: Stops timing the open phase.
+    void end_phase() noexcept;
+
+    // add_pipeline: Adds the stage counters of a chunk pipeline run.
+    // Parameters:
+    //   stages: Stage statistics, in pipeline order.
+    //   planning_time: Time the coordinator spent before the pipeline ran.
+    void add_pipeline(const std::vector<ChunkPipeline::StageStats>& stages,
+                      std::chrono::nanoseconds planning_time) noexcept;
+
+    // add_runs: Records the sizes of runs handed to the merge.
+    // Parameters:
+    //   runs: Run files; their sizes are read with stat().
+    void add_runs(const std::vector<TempFile>& runs) noexcept;
+
+    // set_merge: Records what the merge did.
+    // Parameters:
+    //   merge: Merge statistics of the count.
+    void set_merge(const WordCounter::MergeStats& merge) noexcept;
+
+    // phases: Phases recorded so far.
+    // Returns: Phases in start order.
+    const std::vector<Phase>& phases() const noexcept;
+
+    // runs: Run sizes recorded so far.
+    // Returns: Count and size range of the runs.
+    RunStats runs() const noexcept;
+
+    // to_json: Renders the report.
+    // Parameters:
+    //   threads: Per-worker counters of the thread pool that ran the work.
+    // Returns: One JSON object, newline-terminated, with totals, phases, pipeline stages,
+    //          runs, merge and per-thread utilization.
+    std::string to_json(const std::vector<ThreadPool::WorkerStats>& threads) const noexcept;
+
+    // peak_rss: Peak resident set size of the process.
+    // Returns: Bytes, or 0 if unknown.
+    static size_t peak_rss() noexcept;
+
+    // cpu_time: CPU time of all threads of the process so far.
+    // Returns: User plus system time.
+    static std::chrono::nanoseconds cpu_time() noexcept;
+
+private:
+    using clock_type = std::chrono::steady_clock;
+
+    clock_type::time_point start_;                     // Start of the run.
+    std::chrono::nanoseconds start_cpu_;               // Process CPU time at the start.
+    std::vector<Phase> phases_;                        // Phases in start order.
+    bool phase_open_;                                  // Whether the last phase is still timed.
+    clock_type::time_point phase_start_;               // Start of the open phase.
+    std::chrono::nanoseconds phase_start_cpu_;         // Process CPU time at its start.
+    std::vector<ChunkPipeline::StageStats> stages_;    // Summed pipeline stage counters.
+    std::chrono::nanoseconds planning_time_;           // Summed coordinator planning time.
+    RunStats runs_;                                    // Runs handed to the merge.
+    WordCounter::MergeStats merge_;                    // Last merge.
+};
+
+#endif // STATS_REPORT_HPP
@@ -0,0 +1,72 @@
+#ifndef STREAM_CHUNKER_HPP
+#define STREAM_CHUNKER_HPP
+
+// stream_chunker.hpp: Declaration of StreamChunker class for chunking non-seekable input.
+// Cuts a pipe or stdin into word-aligned chunks using only sequential reads.
+
+#include "file_handle.hpp"
+#include "word_arena.hpp"
+#include <string>
+
+// StreamChunker: Carves a sequential stream into word-aligned chunks.
+// Each chunk is read into the caller's arena and ends after its last space; the
+// partial word behind it is carried into the next chunk, so no word is split and
+// only one chunk's worth of carried bytes is held between calls. The handle is only
+// read(), never seeked, so pipes and terminals work.
+class StreamChunker final {
+public:
+    // Bytes requested per read() while a word longer than a chunk is completed.
+    static constexpr size_t READ_SIZE = 64ULL << 10;
+
+    // Constructor: Chunks a stream.
+    // Parameters:
+    //   input: Handle to read from; not owned, must outlive the chunker.
+    //   chunk_size: Nominal chunk size (at least one byte).
+    StreamChunker(FileHandle& input, size_t chunk_size) noexcept;
+
+    // Copy constructor: Deleted; the carried bytes belong to one reader.
+    StreamChunker(const StreamChunker&) = delete;
+
+    // Copy assignment: Deleted; the carried bytes belong to one reader.
+    StreamChunker& operator=(const StreamChunker&) = delete;
+
+    // set_chunk_size: Changes the nominal size of later chunks.
+    // Parameters:
+    //   chunk_size: Nominal chunk size (at least one byte).
+    void set_chunk_size(size_t chunk_size) noexcept;
+
+    // peek: Reads ahead without consuming, e.g. to sample the input.
+    // Parameters:
+    //   size: Number of bytes wanted.
+    // Returns: The first min(size, remaining) bytes of the stream not yet returned by next().
+    const std::string& peek(size_t size) noexcept;
+
+    // next: Reads the next chunk.
+    // Parameters:
+    //   arena: Arena receiving the chunk's bytes.
+    //   size: Output number of bytes in the chunk.
+    // Returns: Pointer to the chunk's bytes, or nullptr at the end of the stream or on a read error.
+    const char* next(WordArena& arena, size_t& size) noexcept;
+
+    // failed: Checks if a read failed.
+    // Returns: True after a read error; next() returns nullptr from then on.
+    bool failed() const noexcept;
+
+    // bytes_consumed: Bytes returned in chunks so far.
+    // Returns: Stream offset of the next chunk.
+    size_t bytes_consumed() const noexcept;
+
+private:
+    // fill: Reads until a buffer is full or the stream ends.
+    // Returns: Bytes read; sets eof_ or failed_ when the stream stops.
+    size_t fill(char* buffer, size_t size) noexcept;
+
+    FileHandle& input_;     // Stream being chunked.
+    size_t chunk_size_;     // Nominal chunk size.
+    std::string carry_;     // Bytes read but not yet returned in a chunk.
+    size_t consumed_;       // Bytes returned in chunks so far.
+    bool eof_;              // True once read() returned 0.
+    bool failed_;           // True once read() failed.
+};
+
+#endif // STREAM_CHUNKER_HPP
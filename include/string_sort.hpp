@@ -0,0 +1,31 @@
+#ifndef STRING_SORT_HPP
+#define STRING_SORT_HPP
+
+// string_sort.hpp: Declarations of string sorting engines for chunk words.
+// Provides a 26-letter MSD radix sort alongside std::sort behind one entry point.
+
+#include <string_view>
+#include <vector>
+
+// SortAlgorithm: Selects the engine used to sort a chunk's words.
+enum class SortAlgorithm {
+    Std,      // std::sort with lexicographic comparisons.
+    MsdRadix  // Most-significant-digit radix sort over the 'a'-'z' alphabet.
+};
+
+// sort_words: Sorts word views lexicographically.
+// Parameters:
+//   words: Views to sort in place.
+//   algorithm: Sorting engine to use.
+void sort_words(std::vector<std::string_view>& words, SortAlgorithm algorithm) noexcept;
+
+// msd_radix_sort: Sorts word views with an MSD radix sort.
+// Parameters:
+//   words: Views to sort in place.
+// Distributes words into 27 buckets (end of word plus 'a'-'z') one character
+// position at a time, reading each word's character once per level into a
+// contiguous key array. Ranges containing bytes outside 'a'-'z' fall back to
+// comparison sorting, so the result is always correct.
+void msd_radix_sort(std::vector<std::string_view>& words) noexcept;
+
+#endif // STRING_SORT_HPP
@@ -0,0 +1,94 @@
+#ifndef THREAD_POOL_HPP
+#define THREAD_POOL_HPP
+
+// thread_pool.hpp: Declaration of ThreadPool class for persistent work-stealing task execution.
+// Keeps one long-lived thread per core and balances tasks between per-worker deques.
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// ThreadPool: Fixed set of worker threads, each owning a task deque.
+// Workers take tasks from the front of their own deque and, when it is empty, steal
+// from the back of other workers' deques, so cores stay busy until all work is drained
+// instead of waiting for the slowest task of a batch.
+class ThreadPool final {
+public:
+    // WorkerStats: Per-worker counters for diagnosing load balance.
+    struct WorkerStats {
+        size_t tasks_executed;            // Tasks run by the worker, including stolen ones.
+        size_t tasks_stolen;              // Tasks taken from another worker's deque.
+        std::chrono::nanoseconds busy_time; // Time spent running tasks.
+        std::chrono::nanoseconds idle_time; // Time spent waiting for tasks.
+    };
+
+    // Constructor: Starts the worker threads.
+    // Parameters:
+    //   thread_count: Number of workers; 0 selects the hardware concurrency.
+    explicit ThreadPool(size_t thread_count = 0) noexcept;
+
+    // Copy constructor: Deleted; workers are bound to this pool.
+    ThreadPool(const ThreadPool&) = delete;
+
+    // Copy assignment: Deleted; workers are bound to this pool.
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    // Destructor: Finishes queued tasks, then stops and joins the workers.
+    ~ThreadPool() noexcept;
+
+    // submit: Queues a task for asynchronous execution.
+    // Parameters:
+    //   task: Callable to run on a worker thread.
+    void submit(std::function<void()> task) noexcept;
+
+    // run_all: Runs a batch of tasks and blocks until every one has finished.
+    // Parameters:
+    //   tasks: Callables to run. Must not be called from inside a pool task.
+    void run_all(std::vector<std::function<void()>> tasks) noexcept;
+
+    // size: Number of worker threads.
+    // Returns: Worker count.
+    size_t size() const noexcept;
+
+    // stats: Snapshot of every worker's counters.
+    // Returns: One WorkerStats per worker, in worker order.
+    std::vector<WorkerStats> stats() const noexcept;
+
+    // shared: Process-wide pool sized to the hardware concurrency, created on first use.
+    // Returns: Reference to the shared pool.
+    static ThreadPool& shared() noexcept;
+
+private:
+    // Worker: Deque, counters and thread of one worker.
+    struct Worker {
+        std::mutex mutex;                          // Guards tasks.
+        std::deque<std::function<void()>> tasks;   // Pending tasks, oldest at the front.
+        std::atomic<size_t> executed{0};           // Tasks run.
+        std::atomic<size_t> stolen{0};             // Tasks stolen from others.
+        std::atomic<int64_t> busy_ns{0};           // Nanoseconds spent in tasks.
+        std::atomic<int64_t> idle_ns{0};           // Nanoseconds spent waiting.
+        std::thread thread;                        // The worker thread.
+    };
+
+    // worker_loop: Runs tasks until the pool is stopped and drained.
+    void worker_loop(size_t index) noexcept;
+
+    // try_take: Pops from the worker's own deque or steals from another one.
+    // Returns: True if a task was taken; stolen reports where it came from.
+    bool try_take(size_t index, std::function<void()>& task, bool& stolen) noexcept;
+
+    std::vector<std::unique_ptr<Worker>> workers_; // One entry per worker thread.
+    std::mutex wake_mutex_;                        // Guards pending_ and stopping_.
+    std::condition_variable wake_;                 // Signals new tasks or shutdown.
+    size_t pending_;                               // Queued tasks not yet taken.
+    bool stopping_;                                // True once shutdown has begun.
+    std::atomic<size_t> next_queue_;               // Round-robin target for submit().
+};
+
+#endif // THREAD_POOL_HPP
@@ -0,0 +1,57 @@
+#ifndef WORD_ARENA_HPP
+#define WORD_ARENA_HPP
+
+// word_arena.hpp: Declaration of WordArena class for per-chunk bump allocation.
+// Holds the raw bytes that parsed word views point into for the lifetime of a chunk.
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+// WordArena: Bump allocator that owns large blocks and frees them all at once.
+// Allocations are never released individually, so storing a chunk's text costs
+// one heap allocation per block instead of one per word.
+class WordArena final {
+public:
+    // Default block size: 64 MiB keeps the number of blocks small for 1 GiB chunks.
+    static constexpr size_t DEFAULT_BLOCK_SIZE = 64ULL << 20;
+
+    // Constructor: Initializes an empty arena.
+    // Parameters:
+    //   block_size: Size of each block; larger requests get a dedicated block.
+    explicit WordArena(size_t block_size = DEFAULT_BLOCK_SIZE) noexcept;
+
+    // Copy constructor: Deleted so views into the arena have a single owner.
+    WordArena(const WordArena&) = delete;
+
+    // Copy assignment: Deleted so views into the arena have a single owner.
+    WordArena& operator=(const WordArena&) = delete;
+
+    // Move constructor: Transfers block ownership; existing views stay valid.
+    WordArena(WordArena&& other) noexcept = default;
+
+    // Move assignment: Transfers block ownership; existing views stay valid.
+    WordArena& operator=(WordArena&& other) noexcept = default;
+
+    // Destructor: Releases every block.
+    ~WordArena() noexcept = default;
+
+    // allocate: Reserves uninitialized bytes that live as long as the arena.
+    // Parameters:
+    //   size: Number of bytes requested.
+    // Returns: Pointer to the reserved bytes.
+    char* allocate(size_t size) noexcept;
+
+    // bytes_reserved: Reports the total size of all blocks owned by the arena.
+    // Returns: Number of bytes held.
+    size_t bytes_reserved() const noexcept;
+
+private:
+    std::vector<std::unique_ptr<char[]>> blocks_; // Owned blocks, oldest first.
+    size_t block_size_;                           // Size of regular blocks.
+    char* cursor_;                                // Next free byte in the current block.
+    size_t remaining_;                            // Free bytes left in the current block.
+    size_t reserved_;                             // Total bytes across all blocks.
+};
+
+#endif // WORD_ARENA_HPP
@@ -5,18 +5,80 @@
 // Merges sorted temporary files to count unique words.
 
 #include "file_handle.hpp"
+#include "run_writer.hpp"
 #include "temp_file.hpp"
-#include <vector>
+#include "thread_pool.hpp"
+#include <cstdint>
+#include <functional>
 #include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
 
 // WordCounter: Counts unique words by merging sorted temporary files.
-// Uses a priority queue for efficient merging.
+// Uses a loser tree for efficient k-way merging. When there are more runs than the
+// fan-in and descriptor budget allow, intermediate passes merge groups of runs into
+// larger runs, in parallel, until the rest fit in one final pass. The final pass
+// splits the key space into disjoint ranges by sampled splitter words, and each
+// range of every run is merged by its own pool task, so the merge scales with cores.
+// Runs that carry word counts can also be merged into per-word totals and a top-K list.
 class WordCounter final {
 public:
+    // Smallest amount of run data worth giving its own merge partition.
+    static constexpr size_t MIN_PARTITION_BYTES = 4ULL << 20;
+
+    // Default fan-in: 512 runs per merge keeps per-run read buffers large.
+    static constexpr size_t DEFAULT_MAX_FAN_IN = 512;
+
+    // Default read buffer memory of one merge pass.
+    static constexpr size_t DEFAULT_BUFFER_MEMORY = 256ULL << 20;
+
+    // Options: Merge parallelism and resource limits.
+    struct Options {
+        size_t partitions;    // Key ranges in the final pass; 0 picks one per pool worker,
+                              // limited by the run volume and the descriptor budget.
+        size_t max_fan_in;    // Most runs read by one merge; 0 means only the budget limits it.
+        size_t fd_budget;     // Run descriptors open at once; 0 derives it from RLIMIT_NOFILE.
+        size_t buffer_memory; // Read buffer bytes shared by the runs of a pass; 0 selects DEFAULT_BUFFER_MEMORY.
+        CacheMode cache_mode; // Page cache use of run reads and merge outputs.
+
+        // Constructor: Defaults to automatic partitions and budget with DEFAULT_MAX_FAN_IN
+        // and buffered I/O.
+        Options() noexcept
+            : partitions(0), max_fan_in(DEFAULT_MAX_FAN_IN), fd_budget(0), buffer_memory(0),
+              cache_mode(CacheMode::BUFFERED) {
+        }
+    };
+
+    // MergeStats: What the last count_unique_words() call did.
+    struct MergeStats {
+        size_t runs;              // Runs the count started from.
+        size_t passes;            // Merge passes, including the final counting pass.
+        size_t intermediate_runs; // Runs written by intermediate passes.
+        size_t bytes_rewritten;   // Bytes written by intermediate passes.
+        size_t bytes_read;        // Run bytes read by all passes, the final one included.
+    };
+
+    // WordFrequency: A word and its number of occurrences.
+    struct WordFrequency {
+        std::string word; // The word.
+        uint64_t count;   // Occurrences in the input.
+    };
+
+    // FrequencyReport: Result of count_frequencies().
+    struct FrequencyReport {
+        size_t unique_words;            // Distinct words.
+        uint64_t total_words;           // Word occurrences.
+        std::vector<WordFrequency> top; // Most frequent words, most frequent first.
+    };
+
     // Constructor: Initializes with a file handle.
     // Parameters:
     //   file_handle: Unique pointer to the file handle.
-    explicit WordCounter(std::unique_ptr<FileHandle> file_handle) noexcept;
+    //   options: Merge parallelism and resource limits.
+    //   pool: Worker pool that runs the merges.
+    explicit WordCounter(std::unique_ptr<FileHandle> file_handle, Options options = Options(),
+                         ThreadPool& pool = ThreadPool::shared()) noexcept;
 
     // count_unique_words: Counts unique words from temporary files.
     // Parameters:
@@ -24,8 +86,98 @@ public:
     // Returns: Number of unique words.
     size_t count_unique_words(const std::vector<TempFile>& temp_files) noexcept;
 
+    // merge_into: Merges runs into one sorted run of their distinct words, e.g. to persist them.
+    // Parameters:
+    //   run_names: Paths of the runs; they are not deleted.
+    //   writer: Plain-run writer receiving the words in order; the caller finishes it.
+    //   words: Receives the number of distinct words appended.
+    // Returns: True on success, false if a run could not be read to its end.
+    bool merge_into(const std::vector<std::string>& run_names, RunWriter& writer, size_t& words) noexcept;
+
+    // count_frequencies: Counts every word's occurrences and finds the most frequent words.
+    // Parameters:
+    //   temp_files: Runs written with counts (words in plain runs count once per run).
+    //   top_k: Number of most frequent words to keep.
+    //   visit: Called with every distinct word and its total count, in word order; may be empty.
+    // Returns: Unique and total word counts and the top_k words, most frequent first
+    //          (ties in word order).
+    FrequencyReport count_frequencies(const std::vector<TempFile>& temp_files, size_t top_k,
+                                      const std::function<void(std::string_view, uint64_t)>& visit = {}) noexcept;
+
+    // merge_stats: Reports the passes of the last count.
+    // Returns: Pass count and intermediate output volume.
+    MergeStats merge_stats() const noexcept;
+
 private:
+    // fd_budget: Number of run descriptors that may be open at once.
+    // Returns: The configured budget, or the descriptor limit minus a reserve (at least 2).
+    size_t fd_budget() const noexcept;
+
+    // plan_partitions: Chooses how many key ranges to merge in parallel.
+    // Parameters:
+    //   run_count: Number of runs.
+    //   total_bytes: Combined size of the runs.
+    //   budget: Run descriptors that may be open at once.
+    // Returns: Partition count (at least one).
+    size_t plan_partitions(size_t run_count, size_t total_bytes, size_t budget) const noexcept;
+
+    // merge_pass: Merges groups of at most fan_in runs into larger runs, in parallel.
+    // Parameters:
+    //   run_names: Paths of the runs to merge.
+    //   fan_in: Most runs per group.
+    //   budget: Run descriptors that may be open at once.
+    //   counts: True to keep summed word counts in the merged runs.
+    // Returns: The merged runs, one per group.
+    std::vector<TempFile> merge_pass(const std::vector<std::string>& run_names, size_t fan_in, size_t budget,
+                                     bool counts) noexcept;
+
+    // reduce_runs: Runs intermediate passes until the runs fit in one merge.
+    // Parameters:
+    //   run_names: Paths of the initial runs.
+    //   counts: True to keep summed word counts in the merged runs.
+    //   intermediate: Receives the last generation of merged runs (kept alive for the caller).
+    //   budget: Receives the run descriptor budget.
+    // Returns: Paths of the runs for the final pass.
+    std::vector<std::string> reduce_runs(std::vector<std::string> run_names, bool counts,
+                                         std::vector<TempFile>& intermediate, size_t& budget) noexcept;
+
+    // count_final: Counts the unique words of runs that fit in one pass.
+    // Parameters:
+    //   run_names: Paths of the runs.
+    //   budget: Run descriptors that may be open at once.
+    // Returns: Number of unique words.
+    size_t count_final(const std::vector<std::string>& run_names, size_t budget) noexcept;
+
+    // merge_to_run: Merges whole runs into one run of their distinct words.
+    // Parameters:
+    //   run_names: Paths of the runs.
+    //   output_name: Path of the run to write.
+    //   block_size: Read buffer size per run.
+    //   counts: True to write a counting run with the summed counts of each word.
+    //   cache_mode: Page cache use of the runs.
+    // Returns: Bytes written.
+    static size_t merge_to_run(const std::vector<std::string>& run_names, const std::string& output_name,
+                               size_t block_size, bool counts, CacheMode cache_mode) noexcept;
+
+    // merge_range: Counts the unique words of one key range in a slice of every run.
+    // Parameters:
+    //   run_names: Paths of the runs.
+    //   begins: Offset of the slice start in each run (0 reads the whole run).
+    //   ends: Offset of the slice end in each run.
+    //   counted: Whether each run stores word counts (needed to decode slices).
+    //   block_size: Read buffer size per run.
+    //   lower: Smallest word counted; smaller words at the slice heads are skipped.
+    //   upper: Words at or above it end the range; nullptr for no upper bound.
+    //   cache_mode: Page cache use of the runs.
+    // Returns: Number of unique words in the range.
+    static size_t merge_range(const std::vector<std::string>& run_names, const std::vector<off_t>& begins,
+                              const std::vector<off_t>& ends, const std::vector<bool>& counted, size_t block_size,
+                              std::string_view lower, const std::string* upper, CacheMode cache_mode) noexcept;
+
     std::unique_ptr<FileHandle> file_handle_; // File handle for validation.
+    Options options_;                         // Merge parallelism and resource limits.
+    ThreadPool& pool_;                        // Pool running the merges.
+    MergeStats stats_;                        // Passes of the last count.
 };
 
 #endif // WORD_COUNTER_HPP
@@ -0,0 +1,106 @@
+#ifndef WORD_GENERATOR_HPP
+#define WORD_GENERATOR_HPP
+
+// word_generator.hpp: Declaration of WordGenerator class for synthetic test inputs.
+// Writes seeded, reproducible space-separated words with a Zipf-distributed vocabulary.
+
+#include "file_handle.hpp"
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+// WordGenerator: Writes test inputs of random a-z words in parallel.
+// The vocabulary is drawn once from the seed, with word lengths following the
+// configured weights; word i of the vocabulary has Zipf rank i + 1 and is written with
+// probability proportional to 1 / (i + 1)^skew (skew 0 is uniform). The output is cut
+// into blocks that are generated on all workers from their own seeds and written in
+// order, so the same options produce the same bytes whatever the thread count.
+// Every written vocabulary word is marked, which gives the exact unique count.
+class WordGenerator final {
+public:
+    // Default block size: bytes generated per task.
+    static constexpr size_t DEFAULT_BLOCK_SIZE = 4ULL << 20;
+
+    // Options: What to generate.
+    struct Options {
+        uint64_t seed;                      // Seed of the vocabulary and of every block.
+        size_t vocabulary;                  // Distinct words to draw from.
+        size_t min_length;                  // Shortest word (at least 1).
+        size_t max_length;                  // Longest word.
+        std::vector<double> length_weights; // Weight of each length from min_length; empty for uniform.
+        double skew;                        // Zipf exponent; 0 writes every word equally often.
+        size_t bytes;                       // Output size to reach (used when words is 0).
+        size_t words;                       // Exact number of words to write; 0 to generate by size.
+        size_t threads;                     // Worker count; 0 for the hardware concurrency.
+        size_t block_size;                  // Bytes per block (word targets use block_size / 8 words).
+
+        Options() noexcept
+            : seed(1), vocabulary(100000), min_length(3), max_length(10), skew(0.0), bytes(1ULL << 30), words(0),
+              threads(0), block_size(DEFAULT_BLOCK_SIZE) {
+        }
+    };
+
+    // Constructor: Draws the vocabulary and prepares the samplers.
+    // Parameters:
+    //   options: What to generate; check valid() before generate().
+    explicit WordGenerator(Options options) noexcept;
+
+    // valid: Checks that the options can be satisfied.
+    // Returns: False if the lengths are out of range, the weights do not match them, or
+    //          the lengths allow fewer than twice the requested distinct words.
+    bool valid() const noexcept;
+
+    // generate: Writes the words.
+    // Parameters:
+    //   output: File to append the words to; every word is followed by one space.
+    // Returns: True on success, false on a write error or invalid options.
+    bool generate(FileHandle& output) noexcept;
+
+    // unique_count: Distinct words in the written output.
+    // Returns: Exact count after generate(), at most the vocabulary size.
+    size_t unique_count() const noexcept;
+
+    // words_written: Words in the written output.
+    // Returns: Word count after generate().
+    size_t words_written() const noexcept;
+
+    // bytes_written: Bytes in the written output.
+    // Returns: Byte count after generate().
+    size_t bytes_written() const noexcept;
+
+    // vocabulary: Words by Zipf rank, most frequent first.
+    // Returns: The drawn vocabulary (empty if the options are invalid).
+    const std::vector<std::string>& vocabulary() const noexcept;
+
+private:
+    // AliasTable: Constant-time sampler of a discrete distribution (Vose's alias method).
+    struct AliasTable {
+        std::vector<double> probability; // Chance of keeping the drawn slot.
+        std::vector<uint32_t> alias;     // Slot taken otherwise.
+    };
+
+    // build_alias: Prepares a sampler for weights that need not be normalized.
+    static AliasTable build_alias(const std::vector<double>& weights) noexcept;
+
+    // sample: Draws a slot from a sampler.
+    static size_t sample(const AliasTable& table, uint64_t& state) noexcept;
+
+    // block_count: Number of blocks of the output.
+    size_t block_count() const noexcept;
+
+    // generate_block: Fills a buffer with one block's words.
+    // Returns: Number of words written to the buffer.
+    size_t generate_block(size_t block, std::string& out) noexcept;
+
+    Options options_;                                 // What to generate.
+    bool valid_;                                      // Result of the option checks.
+    std::vector<std::string> words_;                  // Vocabulary by Zipf rank.
+    AliasTable ranks_;                                // Sampler of Zipf ranks (empty for skew 0).
+    std::unique_ptr<std::atomic<uint64_t>[]> marks_;  // Bit per vocabulary word, set once written.
+    size_t words_written_;                            // Words in the output.
+    size_t bytes_written_;                            // Bytes in the output.
+};
+
+#endif // WORD_GENERATOR_HPP
@@ -0,0 +1,139 @@
+// approx_counter.cpp: Implementation of ApproxCounter for the approximate counting mode.
+// This file scans word-aligned chunks in parallel into per-worker HyperLogLog sketches.
+
+#include "approx_counter.hpp"
+#include "chunk_processor.hpp"
+#include "stream_chunker.hpp"
+#include "word_arena.hpp"
+#include <functional>
+#include <mutex>
+#include <vector>
+
+// Constructor: Initializes ApproxCounter with the input file and sketch precision.
+// Parameters:
+//   input_file: Unique pointer to the input file handle.
+//   file_size: Total size of the input file.
+//   precision: Register index bits of each sketch.
+//   chunk_size: Nominal chunk size (a zero value falls back to the default).
+//   pool: Worker pool that runs the scanning loops.
+ApproxCounter::ApproxCounter(std::unique_ptr<FileHandle> input_file, size_t file_size, unsigned precision,
+                             size_t chunk_size, ThreadPool& pool) noexcept
+    : ApproxCounter(std::vector<InputFile>(), precision, chunk_size, pool) {
+    inputs_.push_back({std::move(input_file), file_size});
+}
+
+// Constructor: Initializes ApproxCounter with several input files estimated as one.
+// Parameters:
+//   inputs: Input files and their sizes.
+//   precision: Register index bits of each sketch.
+//   chunk_size: Nominal chunk size (a zero value falls back to the default).
+//   pool: Worker pool that runs the scanning loops.
+ApproxCounter::ApproxCounter(std::vector<InputFile> inputs, unsigned precision, size_t chunk_size,
+                             ThreadPool& pool) noexcept
+    : inputs_(std::move(inputs)), precision_(precision), chunk_size_(chunk_size == 0 ? DEFAULT_CHUNK_SIZE : chunk_size),
+      pool_(pool) {
+}
+
+// count: Scans every input file into the sketch.
+// Returns:
+//   The merged sketch of every word in the inputs.
+// Each pool worker owns one sketch and one reusable view vector, claims chunks under a
+// mutex (boundaries are snapped to spaces, files are taken in order), and adds every
+// parsed word to its sketch.
+// Duplicates are not filtered first: adding a word twice leaves the registers as they were.
+HyperLogLog ApproxCounter::count() noexcept {
+    std::mutex claim_mutex;
+    InputCursor cursor(inputs_, chunk_size_);
+    std::vector<HyperLogLog> sketches(pool_.size(), HyperLogLog(precision_));
+
+    std::vector<std::function<void()>> tasks;
+    for (size_t w = 0; w < sketches.size(); ++w) {
+        tasks.emplace_back([&, w]() {
+            HyperLogLog& sketch = sketches[w];
+            SpaceSeparatedParser parser;
+            std::vector<std::string_view> words;
+            for (;;) {
+                size_t input;
+                off_t chunk_start;
+                size_t chunk_size;
+                {
+                    std::lock_guard<std::mutex> lock(claim_mutex);
+                    if (!cursor.claim(input, chunk_start, chunk_size)) {
+                        return;
+                    }
+                }
+
+                // Only load() is used, so the processor needs no parser.
+                const FileHandle& file = *inputs_[input].file;
+                ChunkProcessor processor(
+                    ChunkProcessor::open_chunk(file.get(), chunk_start, chunk_size, file.cache_mode()), nullptr);
+                WordArena arena;
+                size_t loaded_size = 0;
+                const char* data = processor.load(chunk_start, chunk_size, arena, loaded_size);
+                if (data == nullptr) {
+                    continue;
+                }
+                words.clear();
+                parser.parse(data, loaded_size, words);
+                for (const auto& word : words) {
+                    sketch.add(word);
+                }
+            }
+        });
+    }
+    pool_.run_all(std::move(tasks));
+
+    HyperLogLog merged(precision_);
+    for (const auto& sketch : sketches) {
+        merged.merge(sketch);
+    }
+    return merged;
+}
+
+// count_stream: Reads the input sequentially into the sketch.
+// Returns:
+//   The merged sketch of every word in the stream.
+// A stream has no offsets to hand out, so workers take turns reading the next
+// word-aligned chunk under the mutex and parse it into their own sketch outside it.
+HyperLogLog ApproxCounter::count_stream() noexcept {
+    std::mutex read_mutex;
+    StreamChunker chunker(*inputs_.front().file, chunk_size_);
+    std::vector<HyperLogLog> sketches(pool_.size(), HyperLogLog(precision_));
+
+    std::vector<std::function<void()>> tasks;
+    for (size_t w = 0; w < sketches.size(); ++w) {
+        tasks.emplace_back([&, w]() {
+            HyperLogLog& sketch = sketches[w];
+            SpaceSeparatedParser parser;
+            std::vector<std::string_view> words;
+            for (;;) {
+                WordArena arena(chunk_size_);
+                size_t size = 0;
+                const char* data;
+                {
+                    std::lock_guard<std::mutex> lock(read_mutex);
+                    data = chunker.next(arena, size);
+                }
+                if (data == nullptr) {
+                    return;
+                }
+                words.clear();
+                parser.parse(data, size, words);
+                for (const auto& word : words) {
+                    sketch.add(word);
+                }
+            }
+        });
+    }
+    pool_.run_all(std::move(tasks));
+
+    if (chunker.failed()) {
+        ssize_t res = write(STDERR_FILENO, "Error: Could not read input stream\n", 35);
+        (void)res;
+    }
+    HyperLogLog merged(precision_);
+    for (const auto& sketch : sketches) {
+        merged.merge(sketch);
+    }
+    return merged;
+}
@@ -2,77 +2,309 @@
 // This file splits the input file into chunks, processes them in parallel, and manages temporary files.
 
 #include "chunk_coordinator.hpp"
-#include "chunk_processor.hpp"
+#include "stream_chunker.hpp"
+#include <algorithm>
 #include <thread>
-#include <mutex>
 
-// Global mutex and offset for thread-safe chunk assignment.
-static std::mutex offset_mutex;
-static off_t global_offset = 0;
+namespace {
+
+// count_words: Counts the space-separated words that start in a buffer.
+// Parameters:
+//   data: Sampled bytes.
+//   size: Number of bytes.
+//   in_word: Whether the previous buffer ended inside a word; updated for the next one.
+size_t count_words(const char* data, size_t size, bool& in_word) noexcept {
+    size_t words = 0;
+    for (size_t i = 0; i < size; ++i) {
+        const bool space = data[i] == ' ';
+        words += !space && !in_word;
+        in_word = !space;
+    }
+    return words;
+}
+
+// bytes_per_word: Average word length of a sample, or its size if it holds no word.
+double bytes_per_word(size_t sampled, size_t words) noexcept {
+    return words == 0 ? static_cast<double>(std::max<size_t>(sampled, 1))
+                      : static_cast<double>(sampled) / static_cast<double>(words);
+}
+
+// single_input: Wraps one input file in an input list.
+std::vector<InputFile> single_input(std::unique_ptr<FileHandle> input_file, size_t file_size) noexcept {
+    std::vector<InputFile> inputs;
+    inputs.push_back({std::move(input_file), file_size});
+    return inputs;
+}
+
+} // namespace
 
 // Constructor: Initializes ChunkCoordinator with file handle, parser, and file size.
 // Parameters:
 //   input_file: Unique pointer to the input file handle.
 //   parser: Unique pointer to the parser for word extraction.
 //   file_size: Total size of the input file.
+//   chunk_size: Nominal chunk size (a zero value falls back to the default).
+//   options: Stage parallelism and queue depth of the chunk pipeline.
 // Uses dependency injection for flexibility.
-ChunkCoordinator::ChunkCoordinator(std::unique_ptr<FileHandle> input_file, std::unique_ptr<Parser> parser, size_t file_size) noexcept
-    : input_file_(std::move(input_file)), parser_(std::move(parser)), file_size_(file_size) {
+ChunkCoordinator::ChunkCoordinator(std::unique_ptr<FileHandle> input_file, std::unique_ptr<Parser> parser, size_t file_size,
+                                   size_t chunk_size, ChunkPipeline::Options options) noexcept
+    : ChunkCoordinator(single_input(std::move(input_file), file_size), std::move(parser), chunk_size, options) {
+}
+
+// Constructor: Initializes ChunkCoordinator with several input files counted as one.
+// Parameters:
+//   inputs: Input files and their sizes (at least one).
+//   parser: Unique pointer to the parser for word extraction.
+//   chunk_size: Nominal chunk size (a zero value falls back to the default).
+//   options: Stage parallelism and queue depth of the chunk pipeline.
+// Chunk handles share their input's open file description, so the pipeline takes its
+// cache mode from the first input handle; all inputs are opened in the same mode.
+ChunkCoordinator::ChunkCoordinator(std::vector<InputFile> inputs, std::unique_ptr<Parser> parser, size_t chunk_size,
+                                   ChunkPipeline::Options options) noexcept
+    : inputs_(std::move(inputs)), parser_(std::move(parser)),
+      chunk_size_(chunk_size == 0 ? DEFAULT_CHUNK_SIZE : chunk_size), options_(options), memory_limit_(0),
+      plan_{0, 0, 0.0}, planning_time_(0), pipeline_(inputs_.front().file->get(), options) {
+    options_.cache_mode = inputs_.front().file->cache_mode();
+    pipeline_.configure(options_);
+}
+
+// set_memory_limit: Bounds the memory of later process_chunks() and process_stream() calls.
+// Parameters:
+//   memory_limit: Bytes the in-flight chunks may use; 0 restores the fixed chunk size.
+void ChunkCoordinator::set_memory_limit(size_t memory_limit) noexcept {
+    memory_limit_ = memory_limit;
+    if (memory_limit_ == 0) {
+        plan_ = {0, 0, 0.0};
+        pipeline_.configure(options_);
+    }
+}
+
+// memory_plan: Chunk geometry chosen by the last memory-limited processing call.
+// Returns:
+//   The plan, or all zeros if no memory limit was applied.
+ChunkCoordinator::MemoryPlan ChunkCoordinator::memory_plan() const noexcept {
+    return plan_;
+}
+
+// plan_memory: Derives chunk size and in-flight count from a memory budget.
+// Parameters:
+//   memory_limit: Bytes the in-flight chunks may use.
+//   bytes_per_word: Average input bytes per word.
+//   workers: Parse threads that can work on chunks at once.
+// Returns:
+//   The chunk size and in-flight count to run with.
+// In the worst case every word of a chunk is distinct, so a resident chunk costs its
+// bytes plus WORD_OVERHEAD per word. Throughput needs one chunk per parser plus one
+// being read and one being spilled; the budget is spread over that many chunks while
+// they stay at least MIN_CHUNK_SIZE, and fewer, larger chunks are used below that.
+ChunkCoordinator::MemoryPlan ChunkCoordinator::plan_memory(size_t memory_limit, double bytes_per_word,
+                                                           size_t workers) noexcept {
+    bytes_per_word = std::max(bytes_per_word, 1.0);
+    const double cost_per_byte = 1.0 + static_cast<double>(WORD_OVERHEAD) / bytes_per_word;
+    const size_t chunk_bytes = static_cast<size_t>(static_cast<double>(memory_limit) / cost_per_byte);
+    const size_t in_flight = std::clamp<size_t>(chunk_bytes / MIN_CHUNK_SIZE, 1, std::max<size_t>(workers, 1) + 2);
+    const size_t chunk_size = std::clamp<size_t>(chunk_bytes / in_flight, 1, DEFAULT_CHUNK_SIZE);
+    return {chunk_size, in_flight, bytes_per_word};
 }
 
-// process_chunks: Splits the file into chunks and processes them in parallel.
+// sample_bytes_per_word: Estimates the average word length from a prefix of the input.
+// Parameters:
+//   file: Handle to read the input through.
+//   start: Offset where the sample starts.
+//   file_size: Total size of the input file.
 // Returns:
-//   Vector of TempFile objects representing sorted chunk files.
-// Uses a thread pool to parallelize chunk processing, ensuring thread safety.
-std::vector<TempFile> ChunkCoordinator::process_chunks() noexcept {
-    std::vector<TempFile> temp_files;
-    std::vector<std::thread> threads;
-    // Chunk size is 1 GiB to balance memory usage and parallelism.
-    constexpr size_t CHUNK_SIZE = 1ULL << 30;
-    size_t num_chunks = (file_size_ + CHUNK_SIZE - 1) / CHUNK_SIZE;
-
-    // Reset global offset for chunk assignment.
-    global_offset = 0;
-
-    // Create threads up to hardware concurrency for optimal performance.
-    size_t max_threads = std::thread::hardware_concurrency();
-    for (size_t i = 0; i < num_chunks; ++i) {
-        // Create a new temporary file for the chunk.
+//   Bytes per space-separated word in the first SAMPLE_SIZE bytes from start.
+double ChunkCoordinator::sample_bytes_per_word(FileHandle& file, off_t start, size_t file_size) noexcept {
+    const off_t file_end = static_cast<off_t>(file_size);
+    if (start >= file_end) {
+        return 1.0;
+    }
+    const size_t sample_size = std::min(SAMPLE_SIZE, static_cast<size_t>(file_end - start));
+    char buffer[4096];
+    size_t sampled = 0;
+    size_t words = 0;
+    bool in_word = false;
+    ssize_t bytes_read;
+    while (sampled < sample_size &&
+           (bytes_read = file.pread(buffer, std::min(sizeof(buffer), sample_size - sampled),
+                                    start + static_cast<off_t>(sampled))) > 0) {
+        words += count_words(buffer, static_cast<size_t>(bytes_read), in_word);
+        sampled += static_cast<size_t>(bytes_read);
+    }
+    return bytes_per_word(sampled, words);
+}
+
+// find_chunk_end: Snaps a nominal chunk boundary forward to the next space.
+// Parameters:
+//   file: Handle to read the input through.
+//   nominal: Offset where the chunk would end at exactly its nominal size.
+//   file_size: Total size of the input file.
+// Returns:
+//   Offset of the first space at or after nominal, or file_size if none is found.
+// Cutting only at spaces guarantees no word is split between two chunks. Reads are
+// positional, so threads may snap boundaries through one shared handle.
+off_t ChunkCoordinator::find_chunk_end(FileHandle& file, off_t nominal, size_t file_size) noexcept {
+    const off_t file_end = static_cast<off_t>(file_size);
+    if (nominal >= file_end) {
+        return file_end;
+    }
+    char buffer[4096];
+    off_t position = nominal;
+    ssize_t bytes_read;
+    while (position < file_end && (bytes_read = file.pread(buffer, sizeof(buffer), position)) > 0) {
+        for (ssize_t i = 0; i < bytes_read; ++i) {
+            if (buffer[i] == ' ') {
+                return position + i;
+            }
+        }
+        position += bytes_read;
+    }
+    return file_end;
+}
+
+// process_chunks: Splits the inputs into chunks and processes them in parallel.
+// Parameters:
+//   temp_files: Receives the TempFile objects representing sorted chunk files.
+//   start_offset: Word-aligned offset to start from in input start_input.
+//   start_input: Index of the input to start in; earlier inputs are skipped.
+// Returns:
+//   True if every chunk was read and spilled.
+// Chunk boundaries are snapped to spaces so every word lands in exactly one chunk.
+// Ranges shorter than a chunk (small files and the tails of large ones) are collected
+// into batches of up to the nominal size that share a chunk and its run, so thousands
+// of shard files cost a handful of runs; a batch of one range is an ordinary chunk.
+// The chunks then stream through the read -> parse -> sort -> spill pipeline, which
+// keeps the disk and the cores busy at the same time.
+// With a memory limit, the average word length is sampled at the start position first,
+// and the chunk size, stage widths and in-flight limit are set from plan_memory().
+bool ChunkCoordinator::process_chunks(std::vector<TempFile>& temp_files, off_t start_offset,
+                                      size_t start_input) noexcept {
+    const auto planning_start = std::chrono::steady_clock::now();
+    size_t nominal_size = chunk_size_;
+    if (memory_limit_ != 0) {
+        InputCursor cursor(inputs_, SAMPLE_SIZE, start_input, start_offset);
+        size_t input = 0;
+        off_t start = 0;
+        size_t size = 0;
+        double sampled = 1.0;
+        if (cursor.claim(input, start, size)) {
+            sampled = sample_bytes_per_word(*inputs_[input].file, start, inputs_[input].size);
+        }
+        nominal_size = apply_memory_plan(sampled);
+    }
+
+    temp_files.clear();
+    std::vector<ChunkPipeline::Chunk> chunks;
+    std::vector<ChunkPipeline::Piece> batch;
+    size_t batch_size = 0;
+
+    // add_chunk: Creates a new temporary file for a chunk and queues it.
+    auto add_chunk = [&](ChunkPipeline::Chunk chunk) {
         TempFile temp_file;
         temp_files.push_back(std::move(temp_file));
+        chunk.temp_filename = temp_files.back().name();
+        chunks.push_back(std::move(chunk));
+    };
+
+    // flush_batch: Turns the collected short ranges into one chunk.
+    auto flush_batch = [&]() {
+        if (batch.size() == 1) {
+            add_chunk({batch.front().start, batch.front().size, std::string(), batch.front().fd});
+        } else if (!batch.empty()) {
+            add_chunk({0, batch_size, std::string(), -1, std::move(batch)});
+        }
+        batch.clear();
+        batch_size = 0;
+    };
+
+    for (size_t i = start_input; i < inputs_.size(); ++i) {
+        FileHandle& file = *inputs_[i].file;
+        const size_t file_size = inputs_[i].size;
+        off_t chunk_start = i == start_input ? start_offset : 0;
 
-        // Assign chunk offset in a thread-safe manner.
-        off_t start_offset;
-        {
-            std::lock_guard<std::mutex> lock(offset_mutex);
-            start_offset = global_offset;
-            global_offset += CHUNK_SIZE;
+        // Assign word-aligned chunk ranges while a full chunk is left.
+        while (static_cast<size_t>(chunk_start) < file_size &&
+               file_size - static_cast<size_t>(chunk_start) >= nominal_size) {
+            off_t chunk_end = find_chunk_end(file, chunk_start + static_cast<off_t>(nominal_size), file_size);
+            add_chunk({chunk_start, static_cast<size_t>(chunk_end - chunk_start), std::string(), file.get()});
+            chunk_start = chunk_end;
         }
 
-        // Create a new processor for the chunk, sharing the file descriptor.
-        auto processor = std::make_unique<ChunkProcessor>(
-            // Use existing file descriptor to avoid reopening the file.
-            std::make_unique<SyscallFileHandle>(input_file_->get()),
-            std::make_unique<SpaceSeparatedParser>()
-        );
-
-        // Launch thread to process the chunk.
-        threads.emplace_back([processor = std::move(processor), start_offset, chunk_size = CHUNK_SIZE, temp_filename = temp_files.back().name()]() {
-            processor->process(start_offset, chunk_size, temp_filename);
-        });
-
-        // Limit active threads to avoid resource exhaustion.
-        if (threads.size() >= max_threads) {
-            for (auto& t : threads) {
-                t.join();
+        // Batch the rest with other short ranges.
+        if (static_cast<size_t>(chunk_start) < file_size) {
+            const size_t size = file_size - static_cast<size_t>(chunk_start);
+            if (batch_size + size > nominal_size) {
+                flush_batch();
             }
-            threads.clear();
+            batch.push_back({file.get(), chunk_start, size});
+            batch_size += size;
         }
     }
-    // Join remaining threads to ensure all chunks are processed.
-    for (auto& t : threads) {
-        t.join();
+    flush_batch();
+
+    planning_time_ += std::chrono::steady_clock::now() - planning_start;
+    return pipeline_.run(chunks);
+}
+
+// process_stream: Reads the input as a stream and processes it in word-aligned chunks.
+// Parameters:
+//   temp_files: Receives the TempFile objects representing sorted chunk files, in stream order.
+// Returns:
+//   True if the stream was read to its end and every chunk spilled.
+// The input is only read sequentially, so pipes and stdin work and nothing is landed
+// on disk first. With a memory limit, the word length is sampled from the first
+// SAMPLE_SIZE bytes, which stay buffered in the chunker and start the first chunk.
+bool ChunkCoordinator::process_stream(std::vector<TempFile>& temp_files) noexcept {
+    StreamChunker chunker(*inputs_.front().file, chunk_size_);
+    if (memory_limit_ != 0) {
+        const auto planning_start = std::chrono::steady_clock::now();
+        const std::string& sample = chunker.peek(SAMPLE_SIZE);
+        bool in_word = false;
+        chunker.set_chunk_size(
+            apply_memory_plan(bytes_per_word(sample.size(), count_words(sample.data(), sample.size(), in_word))));
+        planning_time_ += std::chrono::steady_clock::now() - planning_start;
+    }
+    temp_files.clear();
+    const bool spilled = pipeline_.run_stream(chunker, temp_files);
+    if (chunker.failed()) {
+        ssize_t res = write(STDERR_FILENO, "Error: Could not read input stream\n", 35);
+        (void)res;
+        return false;
     }
+    return spilled;
+}
 
-    return temp_files;
+// apply_memory_plan: Plans chunks for the memory limit and configures the pipeline.
+// Parameters:
+//   bytes_per_word: Sampled average word length.
+// Returns:
+//   Nominal chunk size of the plan.
+size_t ChunkCoordinator::apply_memory_plan(double bytes_per_word) noexcept {
+    const size_t hardware = std::max<size_t>(std::thread::hardware_concurrency(), 1);
+    const size_t parse_workers = options_.parse_workers != 0 ? options_.parse_workers : hardware;
+    plan_ = plan_memory(memory_limit_, bytes_per_word, parse_workers);
+    ChunkPipeline::Options options = options_;
+    options.parse_workers = std::min(parse_workers, plan_.in_flight);
+    options.sort_workers = std::min(options_.sort_workers != 0 ? options_.sort_workers
+                                                               : std::max<size_t>(hardware / 2, 1),
+                                    plan_.in_flight);
+    options.queue_capacity = 1;
+    options.max_in_flight = plan_.in_flight;
+    pipeline_.configure(options);
+    return plan_.chunk_size;
+}
+
+// stage_stats: Per-stage counters of the pipeline runs so far.
+// Returns:
+//   One StageStats per stage, in pipeline order.
+std::vector<ChunkPipeline::StageStats> ChunkCoordinator::stage_stats() const noexcept {
+    return pipeline_.stats();
+}
+
+// planning_time: Time spent before the pipeline runs so far.
+// Returns:
+//   Wall time of sampling, memory planning and chunk boundary search, summed over the
+//   processing calls. Pipeline stage times are in stage_stats().
+std::chrono::nanoseconds ChunkCoordinator::planning_time() const noexcept {
+    return planning_time_;
 }
@@ -0,0 +1,332 @@
+// chunk_pipeline.cpp: Implementation of ChunkPipeline for staged chunk processing.
+// This file wires the read, parse, sort and spill stages together with bounded queues.
+
+#include "chunk_pipeline.hpp"
+#include "bounded_queue.hpp"
+#include "chunk_processor.hpp"
+#include "word_arena.hpp"
+#include <algorithm>
+#include <cstring>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <string_view>
+#include <thread>
+
+namespace {
+
+using clock_type = std::chrono::steady_clock;
+
+// Distance between touched bytes when faulting a mapped chunk in.
+constexpr size_t PAGE_STRIDE = 4096;
+
+// elapsed_ns: Nanoseconds since start.
+int64_t elapsed_ns(clock_type::time_point start) noexcept {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(clock_type::now() - start).count();
+}
+
+// fault_in: Touches one byte per page so a mapped chunk is read from disk now,
+// by the read stage, rather than page by page inside the parse stage.
+void fault_in(const char* data, size_t size) noexcept {
+    volatile char sink = 0;
+    for (size_t i = 0; i < size; i += PAGE_STRIDE) {
+        sink = sink + data[i];
+    }
+    (void)sink;
+}
+
+// load_batch: Reads the ranges of a batched chunk into one buffer, separated by spaces
+// so the last word of one file does not run into the first word of the next.
+// Parameters:
+//   chunk: Chunk whose batch is read.
+//   cache_mode: Page cache use of the reads.
+//   arena: Arena receiving the bytes.
+//   loaded_size: Output number of bytes in the buffer.
+// Returns: Pointer to the bytes, or nullptr on I/O error.
+const char* load_batch(const ChunkPipeline::Chunk& chunk, CacheMode cache_mode, WordArena& arena,
+                       size_t& loaded_size) noexcept {
+    char* data = arena.allocate(chunk.size + chunk.batch.size());
+    loaded_size = 0;
+    for (const auto& piece : chunk.batch) {
+        // Only load() is used, so the reader needs no parser.
+        ChunkProcessor reader(ChunkProcessor::open_chunk(piece.fd, piece.start, piece.size, cache_mode), nullptr);
+        WordArena piece_arena(piece.size);
+        size_t piece_size = 0;
+        const char* piece_data = reader.load(piece.start, piece.size, piece_arena, piece_size);
+        if (piece_data == nullptr) {
+            return nullptr;
+        }
+        if (loaded_size != 0) {
+            data[loaded_size++] = ' ';
+        }
+        std::memcpy(data + loaded_size, piece_data, piece_size);
+        loaded_size += piece_size;
+    }
+    return data;
+}
+
+} // namespace
+
+// ChunkWork: A chunk travelling through the stages with everything its views point into.
+struct ChunkPipeline::ChunkWork {
+    const Chunk* chunk = nullptr;              // Range and run file of the chunk.
+    std::unique_ptr<ChunkProcessor> processor; // Owns the chunk's mapping or file handle.
+    WordArena arena;                           // Owns the chunk's bytes when not mapped.
+    const char* data = nullptr;                // Loaded chunk bytes.
+    size_t loaded_size = 0;                    // Number of loaded bytes.
+    std::vector<std::string_view> words;       // Distinct words, sorted after the sort stage.
+    ChunkProcessor::WordCounts counts;         // Occurrences of the words when spilling counting runs.
+};
+
+namespace {
+
+using WorkQueue = BoundedQueue<std::unique_ptr<ChunkPipeline::ChunkWork>>;
+
+} // namespace
+
+// Constructor: Configures the pipeline for one input file.
+// Parameters:
+//   input_fd: Descriptor of the input file; not owned.
+//   options: Stage parallelism, queue depth and in-flight limit.
+ChunkPipeline::ChunkPipeline(int input_fd, Options options) noexcept : input_fd_(input_fd) {
+    configure(options);
+}
+
+// configure: Replaces the stage parallelism, queue depth and in-flight limit for later runs.
+// Parameters:
+//   options: New options (zero worker counts pick defaults).
+void ChunkPipeline::configure(Options options) noexcept {
+    const size_t hardware = std::max<size_t>(std::thread::hardware_concurrency(), 1);
+    parse_workers_ = options.parse_workers != 0 ? options.parse_workers : hardware;
+    sort_workers_ = options.sort_workers != 0 ? options.sort_workers : std::max<size_t>(hardware / 2, 1);
+    queue_capacity_ = std::max<size_t>(options.queue_capacity, 1);
+    max_in_flight_ = options.max_in_flight;
+    word_counts_ = options.word_counts;
+    cache_mode_ = options.cache_mode;
+}
+
+// run: Processes every chunk and blocks until all runs are written.
+// Parameters:
+//   chunks: Chunks to process, read in the given order.
+// Returns:
+//   True if every run was written, false after the first chunk that could not be
+//   loaded or spilled.
+// The read stage maps (or reads) each chunk of the file and faults it into memory.
+// Batched chunks are copied range by range into the chunk's arena.
+bool ChunkPipeline::run(const std::vector<Chunk>& chunks) noexcept {
+    size_t next = 0;
+    return run_stages([&](ChunkWork& work) {
+        if (next == chunks.size()) {
+            return false;
+        }
+        const Chunk& chunk = chunks[next++];
+        work.chunk = &chunk;
+        if (!chunk.batch.empty()) {
+            work.processor = std::make_unique<ChunkProcessor>(nullptr, std::make_unique<SpaceSeparatedParser>());
+            work.data = load_batch(chunk, cache_mode_, work.arena, work.loaded_size);
+            return true;
+        }
+        std::unique_ptr<FileHandle> chunk_file =
+            ChunkProcessor::open_chunk(chunk.fd != -1 ? chunk.fd : input_fd_, chunk.start, chunk.size, cache_mode_);
+        const bool mapped = chunk_file->view(chunk.start, chunk.size) != nullptr;
+        work.processor = std::make_unique<ChunkProcessor>(std::move(chunk_file), std::make_unique<SpaceSeparatedParser>());
+        work.data = work.processor->load(chunk.start, chunk.size, work.arena, work.loaded_size);
+        if (work.data != nullptr && mapped) {
+            fault_in(work.data, work.loaded_size);
+        }
+        return true;
+    });
+}
+
+// run_stream: Processes a non-seekable input and blocks until all runs are written.
+// Parameters:
+//   chunker: Source of the word-aligned chunks, read in stream order.
+//   temp_files: Receives one run file per chunk, in stream order.
+// Returns:
+//   True if every run was written. The end of the stream and a read error both end
+//   the chunks; the chunker's failed() tells them apart.
+// The read stage pulls chunks from the chunker into their arenas and creates their run
+// files as it goes; the chunks live in a deque so earlier ones stay put while it grows.
+bool ChunkPipeline::run_stream(StreamChunker& chunker, std::vector<TempFile>& temp_files) noexcept {
+    std::deque<Chunk> chunks;
+    return run_stages([&](ChunkWork& work) {
+        const off_t start = static_cast<off_t>(chunker.bytes_consumed());
+        work.data = chunker.next(work.arena, work.loaded_size);
+        if (work.data == nullptr) {
+            return false;
+        }
+        temp_files.emplace_back();
+        chunks.push_back({start, work.loaded_size, temp_files.back().name()});
+        work.chunk = &chunks.back();
+        // The bytes are already loaded, so the processor only parses and sorts.
+        work.processor = std::make_unique<ChunkProcessor>(nullptr, std::make_unique<SpaceSeparatedParser>());
+        return true;
+    });
+}
+
+// run_stages: Runs the read, parse, sort and spill stages until the source is exhausted.
+// Parameters:
+//   load: Read stage body. Fills the next chunk's work and returns true, or returns false
+//         when there are no more chunks; work left without data is a read error.
+// Returns:
+//   True if every chunk was loaded and spilled.
+// One reader thread loads chunks, a group of parse threads collects each chunk's
+// distinct words, a group of sort threads orders them, and one spill thread writes the
+// runs. Each stage pops from the queue before it and pushes to the queue after it; the
+// last thread of a stage to finish closes its output queue so the next stage drains and
+// stops. With an in-flight limit, the reader takes a slot token before loading a chunk
+// and the spiller returns it once the chunk's memory is released, so at most that many
+// chunks are resident at once. The first read or spill error marks the run failed: the
+// reader stops loading, and the chunks still queued pass the later stages without being
+// processed or spilled, since a count over missing runs would be wrong.
+bool ChunkPipeline::run_stages(const std::function<bool(ChunkWork&)>& load) noexcept {
+    WorkQueue parse_queue(queue_capacity_);
+    WorkQueue sort_queue(queue_capacity_);
+    WorkQueue spill_queue(queue_capacity_);
+    BoundedQueue<char> slots(std::max<size_t>(max_in_flight_, 1));
+    for (size_t i = 0; i < max_in_flight_; ++i) {
+        slots.push(0);
+    }
+    std::atomic<bool> failed(false);
+
+    // forward: Pushes a finished chunk downstream and records any back-pressure.
+    auto forward = [](WorkQueue& queue, std::unique_ptr<ChunkWork> work, Counters& counters) {
+        auto start = clock_type::now();
+        queue.push(std::move(work));
+        counters.output_wait_ns.fetch_add(elapsed_ns(start), std::memory_order_relaxed);
+    };
+
+    // take: Pops the next chunk for a stage and records how long the stage starved.
+    auto take = [](WorkQueue& queue, std::unique_ptr<ChunkWork>& work, Counters& counters) {
+        auto start = clock_type::now();
+        bool taken = queue.pop(work);
+        counters.input_wait_ns.fetch_add(elapsed_ns(start), std::memory_order_relaxed);
+        return taken;
+    };
+
+    // finish: Adds one completed chunk to a stage's counters.
+    auto finish = [](Counters& counters, const ChunkWork& work, clock_type::time_point start) {
+        counters.busy_ns.fetch_add(elapsed_ns(start), std::memory_order_relaxed);
+        counters.chunks.fetch_add(1, std::memory_order_relaxed);
+        counters.bytes.fetch_add(work.loaded_size, std::memory_order_relaxed);
+        counters.words.fetch_add(work.words.size(), std::memory_order_relaxed);
+    };
+
+    std::vector<std::thread> threads;
+
+    // Read stage: make each chunk resident, in input order.
+    threads.emplace_back([&]() {
+        Counters& counters = counters_[READ];
+        for (;;) {
+            char slot;
+            if (max_in_flight_ != 0) {
+                auto wait_start = clock_type::now();
+                slots.pop(slot);
+                counters.output_wait_ns.fetch_add(elapsed_ns(wait_start), std::memory_order_relaxed);
+            }
+            auto start = clock_type::now();
+            auto work = std::make_unique<ChunkWork>();
+            const bool more = !failed.load() && load(*work);
+            if (!more || work->data == nullptr) {
+                if (more) {
+                    failed.store(true);
+                }
+                break;
+            }
+            finish(counters, *work, start);
+            forward(parse_queue, std::move(work), counters);
+        }
+        parse_queue.close();
+    });
+
+    // Parse stage: reduce each chunk to its distinct words.
+    std::atomic<size_t> parsers_left(parse_workers_);
+    for (size_t i = 0; i < parse_workers_; ++i) {
+        threads.emplace_back([&]() {
+            Counters& counters = counters_[PARSE];
+            std::unique_ptr<ChunkWork> work;
+            while (take(parse_queue, work, counters)) {
+                // After a failure chunks pass through unprocessed, so the spiller still frees their slots.
+                if (!failed.load()) {
+                    auto start = clock_type::now();
+                    if (word_counts_) {
+                        work->processor->parse_counts(work->data, work->loaded_size, work->words, work->counts);
+                    } else {
+                        work->processor->parse_distinct(work->data, work->loaded_size, work->words);
+                    }
+                    counters.words_parsed.fetch_add(work->processor->words_parsed(), std::memory_order_relaxed);
+                    finish(counters, *work, start);
+                }
+                forward(sort_queue, std::move(work), counters);
+            }
+            if (parsers_left.fetch_sub(1) == 1) {
+                sort_queue.close();
+            }
+        });
+    }
+
+    // Sort stage: order each chunk's distinct words.
+    std::atomic<size_t> sorters_left(sort_workers_);
+    for (size_t i = 0; i < sort_workers_; ++i) {
+        threads.emplace_back([&]() {
+            Counters& counters = counters_[SORT];
+            std::unique_ptr<ChunkWork> work;
+            while (take(sort_queue, work, counters)) {
+                if (!failed.load()) {
+                    auto start = clock_type::now();
+                    work->processor->sort(work->words);
+                    finish(counters, *work, start);
+                }
+                forward(spill_queue, std::move(work), counters);
+            }
+            if (sorters_left.fetch_sub(1) == 1) {
+                spill_queue.close();
+            }
+        });
+    }
+
+    // Spill stage: write each run, then release the chunk's mapping and memory.
+    threads.emplace_back([&]() {
+        Counters& counters = counters_[SPILL];
+        std::unique_ptr<ChunkWork> work;
+        while (take(spill_queue, work, counters)) {
+            if (!failed.load()) {
+                auto start = clock_type::now();
+                size_t bytes_written = 0;
+                if (!ChunkProcessor::spill(work->words, work->chunk->temp_filename,
+                                           word_counts_ ? &work->counts : nullptr, cache_mode_, &bytes_written)) {
+                    failed.store(true);
+                }
+                counters.bytes_written.fetch_add(bytes_written, std::memory_order_relaxed);
+                finish(counters, *work, start);
+            }
+            work.reset();
+            if (max_in_flight_ != 0) {
+                slots.push(0);
+            }
+        }
+    });
+
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    return !failed.load();
+}
+
+// stats: Counters accumulated over all runs.
+// Returns:
+//   One StageStats per stage, in pipeline order.
+std::vector<ChunkPipeline::StageStats> ChunkPipeline::stats() const noexcept {
+    static const char* const NAMES[STAGE_COUNT] = {"read", "parse", "sort", "spill"};
+    const size_t workers[STAGE_COUNT] = {1, parse_workers_, sort_workers_, 1};
+    std::vector<StageStats> result;
+    for (size_t i = 0; i < STAGE_COUNT; ++i) {
+        const Counters& counters = counters_[i];
+        result.push_back({NAMES[i], workers[i], counters.chunks.load(), counters.bytes.load(), counters.words.load(),
+                          counters.words_parsed.load(), counters.bytes_written.load(),
+                          std::chrono::nanoseconds(counters.busy_ns.load()),
+                          std::chrono::nanoseconds(counters.input_wait_ns.load()),
+                          std::chrono::nanoseconds(counters.output_wait_ns.load())});
+    }
+    return result;
+}
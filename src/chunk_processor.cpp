@@ -1,19 +1,24 @@
 // chunk_processor.cpp: Implementation of ChunkProcessor for processing file chunks.
-// This file reads a chunk, parses it into words, sorts them, and writes to a temporary file.
+// This file reads a chunk, parses it into words, deduplicates and sorts them, and writes to a temporary file.
 
 #include "chunk_processor.hpp"
+#include "io_uring_file_handle.hpp"
+#include "run_writer.hpp"
 #include <algorithm>
+#include <string_view>
+#include <unordered_set>
 #include <vector>
 
-#include <iostream>
-
 // Constructor: Initializes ChunkProcessor with file handle and parser.
 // Parameters:
 //   input_file: Unique pointer to the input file handle.
 //   parser: Unique pointer to the parser for word extraction.
+//   sort_algorithm: Engine used to sort the chunk's words.
 // Uses dependency injection for flexibility.
-ChunkProcessor::ChunkProcessor(std::unique_ptr<FileHandle> input_file, std::unique_ptr<Parser> parser) noexcept
-    : input_file_(std::move(input_file)), parser_(std::move(parser)) {
+ChunkProcessor::ChunkProcessor(std::unique_ptr<FileHandle> input_file, std::unique_ptr<Parser> parser,
+                               SortAlgorithm sort_algorithm) noexcept
+    : input_file_(std::move(input_file)), parser_(std::move(parser)), sort_algorithm_(sort_algorithm),
+      words_parsed_(0) {
 }
 
 // process: Processes a file chunk and writes sorted words to a temporary file.
@@ -21,47 +26,185 @@ ChunkProcessor::ChunkProcessor(std::unique_ptr<FileHandle> input_file, std::uniq
 //   start_offset: Starting offset in the input file.
 //   chunk_size: Size of the chunk to process.
 //   temp_filename: Name of the temporary file to write sorted words.
-// Reads the chunk, parses into words, sorts them, and writes to the temporary file.
+// Collects the chunk's distinct words, sorts them, and writes each one once to the
+// temporary file through a buffered RunWriter.
 void ChunkProcessor::process(off_t start_offset, size_t chunk_size, const std::string& temp_filename) noexcept {
-    // Set file offset for reading the chunk.
-    if (input_file_->seek(start_offset, SEEK_SET) == -1) {
-        ssize_t res = write(STDERR_FILENO, "Error: Could not seek in input file\n", 35);
-        (void)res;
+    std::vector<std::string_view> words;
+    WordArena arena;
+    if (!collect_distinct(start_offset, chunk_size, arena, words)) {
         return;
     }
+    sort(words);
+    spill(words, temp_filename);
+}
 
-    // Buffer for reading the chunk (1 MiB to balance memory and I/O).
-    constexpr size_t BUFFER_SIZE = 1ULL << 20;
-    std::vector<char> buffer(BUFFER_SIZE);
-    size_t total_read = 0;
-    std::vector<std::string> words;
+// collect_distinct: Parses a chunk and reduces it to its distinct words.
+// Parameters:
+//   start_offset: Starting offset in the input file.
+//   chunk_size: Size of the chunk.
+//   arena: Arena that keeps the bytes alive when the chunk is not mapped.
+//   words: Output vector receiving unsorted views of the distinct words.
+// Returns:
+//   True on success, false on I/O error.
+bool ChunkProcessor::collect_distinct(off_t start_offset, size_t chunk_size, WordArena& arena,
+                                      std::vector<std::string_view>& words) noexcept {
+    size_t loaded_size = 0;
+    const char* data = load(start_offset, chunk_size, arena, loaded_size);
+    if (data == nullptr) {
+        return false;
+    }
+    parse_distinct(data, loaded_size, words);
+    return true;
+}
+
+// load: Makes a chunk's bytes addressable in memory.
+// Parameters:
+//   start_offset: Starting offset in the input file.
+//   chunk_size: Size of the chunk.
+//   arena: Arena that keeps the bytes alive when the chunk is not mapped.
+//   loaded_size: Output number of bytes available.
+// Returns:
+//   Pointer to the chunk's bytes, or nullptr if the input could not be positioned.
+// Returns the mapped view when the file handle exposes one (zero copy), otherwise
+// reads the whole chunk into one arena allocation in 1 MiB positional requests, so
+// processors sharing a descriptor never race on its file offset.
+const char* ChunkProcessor::load(off_t start_offset, size_t chunk_size, WordArena& arena,
+                                 size_t& loaded_size) noexcept {
+    if (const char* data = input_file_->view(start_offset, chunk_size)) {
+        loaded_size = chunk_size;
+        return data;
+    }
 
-    // Read the chunk in smaller buffers to manage memory.
-    while (total_read < chunk_size) {
-        size_t to_read = std::min(BUFFER_SIZE, chunk_size - total_read);
-        ssize_t bytes_read = input_file_->read(buffer.data(), to_read);
-        if (bytes_read <= 0) {
+    // Read request size (1 MiB to keep individual syscalls modest).
+    constexpr size_t BUFFER_SIZE = 1ULL << 20;
+    char* data = arena.allocate(chunk_size);
+    loaded_size = 0;
+    while (loaded_size < chunk_size) {
+        size_t to_read = std::min(BUFFER_SIZE, chunk_size - loaded_size);
+        ssize_t bytes_read =
+            input_file_->pread(data + loaded_size, to_read, start_offset + static_cast<off_t>(loaded_size));
+        if (bytes_read < 0) {
+            ssize_t res = write(STDERR_FILENO, "Error: Could not read input file\n", 33);
+            (void)res;
+            return nullptr;
+        }
+        if (bytes_read == 0) {
             break;
         }
-        // Parse the buffer into words.
-        parser_->parse(buffer.data(), bytes_read, words);
-        total_read += bytes_read;
+        loaded_size += static_cast<size_t>(bytes_read);
     }
+    return data;
+}
 
-    // Sort words to prepare for merging.
-    std::sort(words.begin(), words.end());
+// parse_distinct: Extracts the distinct words of loaded bytes.
+// Parameters:
+//   data: Chunk bytes.
+//   size: Number of bytes.
+//   words: Output vector receiving unsorted views of the distinct words.
+// Deduplicate while parsing: chunks repeat a small vocabulary many times over, so
+// hashing each word as it is found keeps only distinct views in memory and shrinks
+// both the sort and the spilled run to distinct words.
+void ChunkProcessor::parse_distinct(const char* data, size_t size, std::vector<std::string_view>& words) noexcept {
+    std::unordered_set<std::string_view> distinct;
+    words_parsed_ += parser_->parse(data, size, distinct);
+    words.assign(distinct.begin(), distinct.end());
+    words.shrink_to_fit();
+}
 
-    // Write sorted words to the temporary file.
-    SyscallFileHandle temp_file(temp_filename.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0600);
-    if (!temp_file.is_open()) {
+// parse_counts: Extracts the distinct words of loaded bytes and counts them.
+// Parameters:
+//   data: Chunk bytes.
+//   size: Number of bytes.
+//   words: Output vector receiving unsorted views of the distinct words.
+//   counts: Output occurrences of every distinct word.
+// Pre-aggregating per chunk means a run stores each word once with its count
+// instead of every occurrence; counting during the scan means the occurrences are
+// never held in memory either.
+void ChunkProcessor::parse_counts(const char* data, size_t size, std::vector<std::string_view>& words,
+                                  WordCounts& counts) noexcept {
+    counts.clear();
+    words_parsed_ += parser_->parse(data, size, counts);
+    words.clear();
+    words.reserve(counts.size());
+    for (const auto& entry : counts) {
+        words.push_back(entry.first);
+    }
+    words.shrink_to_fit();
+}
+
+// sort: Orders words with the processor's sorting engine.
+// Parameters:
+//   words: Word views to sort in place.
+void ChunkProcessor::sort(std::vector<std::string_view>& words) noexcept {
+    sort_words(words, sort_algorithm_);
+}
+
+// spill: Writes sorted words to a run file.
+// Parameters:
+//   words: Sorted distinct words.
+//   temp_filename: Name of the run file to create.
+//   counts: Occurrences of the words for a counting run, or nullptr.
+//   cache_mode: Page cache use of the run file.
+//   bytes_written: Receives the size of the run file, if not nullptr.
+// Returns:
+//   True on success, false if the file could not be opened or written.
+bool ChunkProcessor::spill(const std::vector<std::string_view>& words, const std::string& temp_filename,
+                           const WordCounts* counts, CacheMode cache_mode, size_t* bytes_written) noexcept {
+    auto temp_file = std::make_unique<IoUringFileHandle>(temp_filename.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0600,
+                                                         IoUringFileHandle::RUN_QUEUE_DEPTH,
+                                                         RunWriter::DEFAULT_BLOCK_SIZE);
+    if (!temp_file->is_open()) {
         ssize_t res = write(STDERR_FILENO, "Error: Could not open temp file for writing\n", 43);
         (void)res;
-        return;
+        return false;
     }
+    temp_file->set_cache_mode(cache_mode);
 
-    // Write each word followed by a newline.
+    RunWriter writer(std::move(temp_file), RunWriter::DEFAULT_BLOCK_SIZE, counts != nullptr);
     for (const auto& word : words) {
-        temp_file.write(word.c_str(), word.size());
-        temp_file.write("\n", 1);
+        if (counts != nullptr) {
+            auto it = counts->find(word);
+            writer.append(word, it != counts->end() ? it->second : 1);
+        } else {
+            writer.append(word);
+        }
+    }
+    const bool finished = writer.finish();
+    if (bytes_written != nullptr) {
+        *bytes_written = writer.bytes_written();
+    }
+    if (!finished) {
+        ssize_t res = write(STDERR_FILENO, "Error: Could not write temp file\n", 32);
+        (void)res;
+        return false;
+    }
+    return true;
+}
+
+// open_chunk: Opens a handle over one chunk of the input.
+// Parameters:
+//   input_fd: Descriptor of the input file; not owned.
+//   start_offset: Starting offset of the chunk.
+//   chunk_size: Size of the chunk.
+//   cache_mode: Cache mode of the input handle.
+// Returns:
+//   Handle that load() reads the chunk through.
+// The duplicate starts out sharing the input's open file description, but
+// set_cache_mode() switches O_DIRECT by reopening the file through /proc/self/fd and
+// dup2()ing the new description over the duplicate, so the input's own description is
+// unaffected. DIRECT mode is therefore set again on the duplicate to give it an
+// O_DIRECT description and blocks rounded up to DIRECT_ALIGNMENT.
+std::unique_ptr<FileHandle> ChunkProcessor::open_chunk(int input_fd, off_t start_offset, size_t chunk_size,
+                                                       CacheMode cache_mode) noexcept {
+    if (cache_mode != CacheMode::DIRECT) {
+        auto mapping = std::make_unique<MappedFileHandle>(input_fd, start_offset, chunk_size);
+        if (mapping->is_open()) {
+            mapping->set_cache_mode(cache_mode);
+            return mapping;
+        }
     }
+    auto file = std::make_unique<IoUringFileHandle>(::dup(input_fd), IoUringFileHandle::DEFAULT_QUEUE_DEPTH,
+                                                    IoUringFileHandle::DEFAULT_BLOCK_SIZE);
+    file->set_cache_mode(cache_mode);
+    return file;
 }
@@ -1,10 +1,65 @@
-// file_handle.cpp: Implementation of SyscallFileHandle for RAII-based file operations.
-// This file provides a safe interface for Linux syscalls (open, read, write, seek, close).
+// file_handle.cpp: Implementation of SyscallFileHandle and MappedFileHandle for RAII-based file operations.
+// This file provides a safe interface for Linux syscalls (open, read, write, seek, close, mmap).
 
 #include "file_handle.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
 #include <fcntl.h>
+#include <sys/mman.h>
 #include <unistd.h>
 
+namespace {
+
+// Readahead window of STREAM mode, and the bytes transferred between cache releases.
+constexpr off_t STREAM_WINDOW = 8LL << 20;
+
+// Size of the DIRECT-mode bounce and staging buffer.
+constexpr size_t DIRECT_BUFFER_SIZE = 1ULL << 20;
+
+// align_down: Rounds an offset down to DIRECT_ALIGNMENT.
+off_t align_down(off_t value) noexcept {
+    return value - value % static_cast<off_t>(DIRECT_ALIGNMENT);
+}
+
+// reopen: Opens a new open file description of the file behind a descriptor.
+// Parameters:
+//   fd: Open descriptor.
+//   flags: Status flags of the new description; only the access mode, O_APPEND and
+//          O_DIRECT are kept.
+// Returns:
+//   New descriptor, or -1 if /proc/self/fd is unavailable or the open fails.
+// Unlike dup(), the new description has its own status flags and file offset, so
+// setting O_DIRECT on one does not change how the other transfers.
+int reopen(int fd, int flags) noexcept {
+    char path[32];
+    snprintf(path, sizeof(path), "/proc/self/fd/%d", fd);
+    return ::open(path, flags & (O_ACCMODE | O_APPEND | O_DIRECT));
+}
+
+} // namespace
+
+// AlignedFree: Releases memory from allocate_aligned().
+// Parameters:
+//   data: Buffer to free.
+void AlignedFree::operator()(char* data) const noexcept {
+    std::free(data);
+}
+
+// allocate_aligned: Allocates a buffer usable for O_DIRECT transfers.
+// Parameters:
+//   size: Number of bytes.
+// Returns:
+//   Buffer aligned to DIRECT_ALIGNMENT, or nullptr if allocation fails.
+AlignedBuffer allocate_aligned(size_t size) noexcept {
+    void* data = nullptr;
+    if (::posix_memalign(&data, DIRECT_ALIGNMENT, std::max<size_t>(size, 1)) != 0) {
+        return nullptr;
+    }
+    return AlignedBuffer(static_cast<char*>(data));
+}
+
 // SyscallFileHandle default constructor: Initializes with invalid file descriptor.
 SyscallFileHandle::SyscallFileHandle() noexcept
     : fd_(-1) {
@@ -42,8 +97,14 @@ SyscallFileHandle::SyscallFileHandle(int fd) noexcept
 //   other: Source SyscallFileHandle to move from.
 // Ensures the source is left in a valid state (fd_ = -1).
 SyscallFileHandle::SyscallFileHandle(SyscallFileHandle&& other) noexcept
-    : fd_(other.fd_) {
+    : fd_(other.fd_), cache_mode_(other.cache_mode_), readahead_end_(other.readahead_end_),
+      release_start_(other.release_start_), release_end_(other.release_end_),
+      writeback_start_(other.writeback_start_), writeback_end_(other.writeback_end_),
+      direct_buffer_(std::move(other.direct_buffer_)), staged_(other.staged_), stage_offset_(other.stage_offset_),
+      cached_fd_(other.cached_fd_) {
     other.fd_ = -1;
+    other.cached_fd_ = -1;
+    other.reset_cache();
 }
 
 // Move assignment operator: Transfers ownership of the file descriptor.
@@ -54,23 +115,46 @@ SyscallFileHandle::SyscallFileHandle(SyscallFileHandle&& other) noexcept
 // Closes existing file descriptor before taking ownership.
 SyscallFileHandle& SyscallFileHandle::operator=(SyscallFileHandle&& other) noexcept {
     if (this != &other) {
-        // Close current file descriptor if open.
+        // Write staged bytes and close current file descriptor if open.
         if (fd_ != -1) {
+            flush_stage(true);
             ::close(fd_);
         }
+        if (cached_fd_ != -1) {
+            ::close(cached_fd_);
+        }
         // Transfer ownership and reset source.
         fd_ = other.fd_;
+        cache_mode_ = other.cache_mode_;
+        readahead_end_ = other.readahead_end_;
+        release_start_ = other.release_start_;
+        release_end_ = other.release_end_;
+        writeback_start_ = other.writeback_start_;
+        writeback_end_ = other.writeback_end_;
+        direct_buffer_ = std::move(other.direct_buffer_);
+        staged_ = other.staged_;
+        stage_offset_ = other.stage_offset_;
+        cached_fd_ = other.cached_fd_;
         other.fd_ = -1;
+        other.cached_fd_ = -1;
+        other.reset_cache();
     }
     return *this;
 }
 
-// Destructor: Closes the file descriptor if open.
+// Destructor: Writes staged bytes and closes the file descriptor if open.
 // Ensures RAII cleanup to prevent resource leaks.
 SyscallFileHandle::~SyscallFileHandle() noexcept {
     if (fd_ != -1) {
+        if (!flush_stage(true)) {
+            ssize_t res = ::write(STDERR_FILENO, "Error: Could not write file\n", 28);
+            (void)res;
+        }
         ::close(fd_);
     }
+    if (cached_fd_ != -1) {
+        ::close(cached_fd_);
+    }
 }
 
 // is_open: Checks if the file descriptor is valid.
@@ -93,7 +177,11 @@ int SyscallFileHandle::get() const noexcept {
 //   whence: Seek mode (e.g., SEEK_SET, SEEK_CUR, SEEK_END).
 // Returns:
 //   The resulting offset, or -1 on error.
+// Staged DIRECT bytes are written first so the offset reflects them.
 off_t SyscallFileHandle::seek(off_t offset, int whence) noexcept {
+    if (!flush_stage(true)) {
+        return -1;
+    }
     return ::lseek(fd_, offset, whence);
 }
 
@@ -104,7 +192,48 @@ off_t SyscallFileHandle::seek(off_t offset, int whence) noexcept {
 // Returns:
 //   Number of bytes read, or -1 on error.
 ssize_t SyscallFileHandle::read(char* buffer, size_t size) noexcept {
-    return ::read(fd_, buffer, size);
+    if (cache_mode_ == CacheMode::BUFFERED) {
+        return ::read(fd_, buffer, size);
+    }
+    // Other modes need the offset; pread() applies the policy and the offset is advanced here.
+    if (!flush_stage(true)) {
+        return -1;
+    }
+    const off_t offset = ::lseek(fd_, 0, SEEK_CUR);
+    if (offset == -1) {
+        return -1;
+    }
+    const ssize_t bytes_read = SyscallFileHandle::pread(buffer, size, offset);
+    if (bytes_read > 0) {
+        ::lseek(fd_, offset + bytes_read, SEEK_SET);
+    }
+    return bytes_read;
+}
+
+// pread: Reads data at an absolute offset using pread syscall.
+// Parameters:
+//   buffer: Destination buffer for read data.
+//   size: Number of bytes to read.
+//   offset: Absolute file offset of the first byte.
+// Returns:
+//   Number of bytes read, or -1 on error.
+// The descriptor's file offset is neither used nor changed.
+ssize_t SyscallFileHandle::pread(char* buffer, size_t size, off_t offset) noexcept {
+    switch (cache_mode_) {
+        case CacheMode::BUFFERED:
+            return ::pread(fd_, buffer, size, offset);
+        case CacheMode::STREAM: {
+            prefetch(offset, size);
+            const ssize_t bytes_read = ::pread(fd_, buffer, size, offset);
+            if (bytes_read > 0) {
+                release(offset, static_cast<size_t>(bytes_read), false);
+            }
+            return bytes_read;
+        }
+        case CacheMode::DIRECT:
+            return flush_stage(true) ? direct_pread(buffer, size, offset) : -1;
+    }
+    return -1;
 }
 
 // write: Writes data from a buffer to the file using write syscall.
@@ -113,6 +242,495 @@ ssize_t SyscallFileHandle::read(char* buffer, size_t size) noexcept {
 //   size: Number of bytes to write.
 // Returns:
 //   Number of bytes written, or -1 on error.
+// In DIRECT mode the bytes are staged and written in aligned blocks; the offset
+// advances when the stage is flushed.
 ssize_t SyscallFileHandle::write(const char* buffer, size_t size) noexcept {
-    return ::write(fd_, buffer, size);
+    switch (cache_mode_) {
+        case CacheMode::BUFFERED:
+            return ::write(fd_, buffer, size);
+        case CacheMode::STREAM: {
+            const off_t offset = ::lseek(fd_, 0, SEEK_CUR);
+            const ssize_t written = ::write(fd_, buffer, size);
+            if (written > 0 && offset != -1) {
+                release(offset, static_cast<size_t>(written), true);
+            }
+            return written;
+        }
+        case CacheMode::DIRECT:
+            break;
+    }
+    if (staged_ == 0) {
+        stage_offset_ = ::lseek(fd_, 0, SEEK_CUR);
+        if (stage_offset_ == -1) {
+            return -1;
+        }
+    }
+    size_t copied = 0;
+    while (copied < size) {
+        const size_t n = std::min(DIRECT_BUFFER_SIZE - staged_, size - copied);
+        std::memcpy(direct_buffer_.get() + staged_, buffer + copied, n);
+        staged_ += n;
+        copied += n;
+        if (staged_ == DIRECT_BUFFER_SIZE && !flush_stage(false)) {
+            return -1;
+        }
+    }
+    return static_cast<ssize_t>(size);
+}
+
+// flush: Writes staged DIRECT bytes and, in STREAM mode, releases the unreleased tail.
+// Returns:
+//   True on success, false on a write error.
+// The tail includes the last written window, whose writeback is waited for here.
+bool SyscallFileHandle::flush() noexcept {
+    if (!flush_stage(true)) {
+        return false;
+    }
+    if (cache_mode_ == CacheMode::STREAM && release_end_ > 0) {
+        const off_t start = writeback_end_ > writeback_start_ ? writeback_start_ : release_start_;
+        if (release_end_ > start) {
+            ::sync_file_range(fd_, start, release_end_ - start,
+                              SYNC_FILE_RANGE_WAIT_BEFORE | SYNC_FILE_RANGE_WRITE | SYNC_FILE_RANGE_WAIT_AFTER);
+            ::posix_fadvise(fd_, start, release_end_ - start, POSIX_FADV_DONTNEED);
+        }
+        writeback_start_ = writeback_end_ = release_start_ = release_end_;
+    }
+    return true;
+}
+
+// set_cache_mode: Chooses how later transfers use the page cache.
+// Parameters:
+//   mode: Cache mode.
+// Returns:
+//   True if the mode is in effect, false if O_DIRECT is refused (e.g. on tmpfs).
+// STREAM advises sequential access for the whole file; the other modes restore the
+// default advice. The O_DIRECT flag lives in the open file description, which dup'd
+// descriptors share, so switching it reopens the file as a new description in place of
+// fd_ (keeping the file offset) instead of changing the flag under the other handles.
+bool SyscallFileHandle::set_cache_mode(CacheMode mode) noexcept {
+    if (fd_ == -1 || !flush_stage(true)) {
+        return false;
+    }
+    const int flags = ::fcntl(fd_, F_GETFL);
+    if (flags == -1) {
+        return false;
+    }
+    if (mode == CacheMode::DIRECT && !direct_buffer_) {
+        direct_buffer_ = allocate_aligned(DIRECT_BUFFER_SIZE);
+        if (!direct_buffer_) {
+            return false;
+        }
+    }
+    const int wanted = mode == CacheMode::DIRECT ? flags | O_DIRECT : flags & ~O_DIRECT;
+    if (wanted != flags) {
+        const int fd = reopen(fd_, wanted);
+        if (fd == -1) {
+            return false;
+        }
+        const off_t position = ::lseek(fd_, 0, SEEK_CUR);
+        if ((position > 0 && ::lseek(fd, position, SEEK_SET) != position) || ::dup2(fd, fd_) == -1) {
+            ::close(fd);
+            return false;
+        }
+        ::close(fd);
+    }
+    ::posix_fadvise(fd_, 0, 0, mode == CacheMode::STREAM ? POSIX_FADV_SEQUENTIAL : POSIX_FADV_NORMAL);
+    AlignedBuffer buffer = std::move(direct_buffer_);
+    reset_cache();
+    cache_mode_ = mode;
+    direct_buffer_ = std::move(buffer);
+    return true;
+}
+
+// cache_mode: Reports the mode in effect.
+// Returns:
+//   The cache mode.
+CacheMode SyscallFileHandle::cache_mode() const noexcept {
+    return cache_mode_;
+}
+
+// release: Drops transferred data from the page cache in STREAM mode.
+// Parameters:
+//   offset: File offset of the transferred range.
+//   size: Number of bytes transferred.
+//   written: True for written data.
+// Contiguous transfers are collected into STREAM_WINDOW-sized windows. A read window is
+// dropped at once. A written window first has its writeback started; it is dropped one
+// window later, after waiting for that writeback, so the writer rarely blocks on it.
+void SyscallFileHandle::release(off_t offset, size_t size, bool written) noexcept {
+    if (cache_mode_ != CacheMode::STREAM) {
+        return;
+    }
+    if (offset != release_end_) {
+        release_start_ = offset;
+    }
+    release_end_ = offset + static_cast<off_t>(size);
+    if (release_end_ - release_start_ < STREAM_WINDOW) {
+        return;
+    }
+    const off_t length = release_end_ - release_start_;
+    if (written) {
+        ::sync_file_range(fd_, release_start_, length, SYNC_FILE_RANGE_WRITE);
+        if (writeback_end_ > writeback_start_) {
+            ::sync_file_range(fd_, writeback_start_, writeback_end_ - writeback_start_,
+                              SYNC_FILE_RANGE_WAIT_BEFORE | SYNC_FILE_RANGE_WRITE | SYNC_FILE_RANGE_WAIT_AFTER);
+            ::posix_fadvise(fd_, writeback_start_, writeback_end_ - writeback_start_, POSIX_FADV_DONTNEED);
+        }
+        writeback_start_ = release_start_;
+        writeback_end_ = release_end_;
+    } else {
+        ::posix_fadvise(fd_, release_start_, length, POSIX_FADV_DONTNEED);
+    }
+    release_start_ = release_end_;
+}
+
+// pwrite_cached: Writes at an offset through the page cache, even if O_DIRECT is set.
+// Parameters:
+//   buffer: Source bytes.
+//   size: Number of bytes.
+//   offset: File offset.
+// Returns:
+//   True if every byte was written.
+// O_DIRECT rejects unaligned lengths, so with O_DIRECT set the bytes go through a second
+// description of the file opened without it, kept open for later tails.
+bool SyscallFileHandle::pwrite_cached(const char* buffer, size_t size, off_t offset) noexcept {
+    int fd = fd_;
+    const int flags = ::fcntl(fd_, F_GETFL);
+    if (flags != -1 && (flags & O_DIRECT) != 0) {
+        if (cached_fd_ == -1) {
+            cached_fd_ = reopen(fd_, flags & ~(O_DIRECT | O_APPEND));
+        }
+        if (cached_fd_ == -1) {
+            return false;
+        }
+        fd = cached_fd_;
+    }
+    size_t done = 0;
+    while (done < size) {
+        ssize_t res = ::pwrite(fd, buffer + done, size - done, offset + static_cast<off_t>(done));
+        if (res <= 0) {
+            break;
+        }
+        done += static_cast<size_t>(res);
+    }
+    return done == size;
+}
+
+// prefetch: Starts readahead of the STREAM window when a read reaches past it.
+// Parameters:
+//   offset: File offset of the read.
+//   size: Number of bytes requested.
+void SyscallFileHandle::prefetch(off_t offset, size_t size) noexcept {
+    const off_t end = offset + static_cast<off_t>(size);
+    if (end <= readahead_end_ && offset >= readahead_end_ - 2 * STREAM_WINDOW) {
+        return;
+    }
+    ::readahead(fd_, offset, static_cast<size_t>(STREAM_WINDOW));
+    readahead_end_ = offset + STREAM_WINDOW;
+}
+
+// direct_pread: Reads under O_DIRECT.
+// Parameters:
+//   buffer: Destination buffer.
+//   size: Number of bytes requested.
+//   offset: File offset.
+// Returns:
+//   Bytes read, or -1 on error.
+// Aligned requests go straight to the caller's buffer. Others read the enclosing
+// aligned range into the bounce buffer, up to its size, and copy out the requested
+// bytes, so a request may come back short.
+ssize_t SyscallFileHandle::direct_pread(char* buffer, size_t size, off_t offset) noexcept {
+    if (reinterpret_cast<uintptr_t>(buffer) % DIRECT_ALIGNMENT == 0 && offset % DIRECT_ALIGNMENT == 0 &&
+        size % DIRECT_ALIGNMENT == 0) {
+        return ::pread(fd_, buffer, size, offset);
+    }
+    const off_t start = align_down(offset);
+    const size_t skip = static_cast<size_t>(offset - start);
+    const size_t length = std::min(DIRECT_BUFFER_SIZE,
+                                   (skip + size + DIRECT_ALIGNMENT - 1) / DIRECT_ALIGNMENT * DIRECT_ALIGNMENT);
+    const ssize_t bytes_read = ::pread(fd_, direct_buffer_.get(), length, start);
+    if (bytes_read < 0) {
+        return -1;
+    }
+    if (static_cast<size_t>(bytes_read) <= skip) {
+        return 0;
+    }
+    const size_t n = std::min(size, static_cast<size_t>(bytes_read) - skip);
+    std::memcpy(buffer, direct_buffer_.get() + skip, n);
+    return static_cast<ssize_t>(n);
+}
+
+// flush_stage: Writes staged DIRECT bytes.
+// Parameters:
+//   all: True to write the unaligned tail too and move the file offset past the data.
+// Returns:
+//   True on success, false on a write error.
+// The aligned prefix is written with O_DIRECT when the stage starts at an aligned
+// offset; anything else goes through the page cache.
+bool SyscallFileHandle::flush_stage(bool all) noexcept {
+    if (staged_ == 0) {
+        return true;
+    }
+    size_t direct = 0;
+    if (stage_offset_ % static_cast<off_t>(DIRECT_ALIGNMENT) == 0) {
+        direct = staged_ - staged_ % DIRECT_ALIGNMENT;
+    }
+    size_t done = 0;
+    while (done < direct) {
+        ssize_t res = ::pwrite(fd_, direct_buffer_.get() + done, direct - done, stage_offset_ + static_cast<off_t>(done));
+        if (res <= 0) {
+            staged_ = 0;
+            return false;
+        }
+        done += static_cast<size_t>(res);
+    }
+    if (all || direct == 0) {
+        if (!pwrite_cached(direct_buffer_.get() + done, staged_ - done, stage_offset_ + static_cast<off_t>(done))) {
+            staged_ = 0;
+            return false;
+        }
+        done = staged_;
+    }
+    std::memmove(direct_buffer_.get(), direct_buffer_.get() + done, staged_ - done);
+    staged_ -= done;
+    stage_offset_ += static_cast<off_t>(done);
+    if (staged_ == 0) {
+        ::lseek(fd_, stage_offset_, SEEK_SET);
+    }
+    return true;
+}
+
+// reset_cache: Returns the cache state to BUFFERED without touching the descriptor.
+void SyscallFileHandle::reset_cache() noexcept {
+    cache_mode_ = CacheMode::BUFFERED;
+    readahead_end_ = 0;
+    release_start_ = 0;
+    release_end_ = 0;
+    writeback_start_ = 0;
+    writeback_end_ = 0;
+    direct_buffer_.reset();
+    staged_ = 0;
+    stage_offset_ = 0;
+}
+
+// MappedFileHandle default constructor: Initializes with no mapping.
+MappedFileHandle::MappedFileHandle() noexcept
+    : fd_(-1), map_base_(nullptr), map_length_(0), data_(nullptr), offset_(0), length_(0), position_(0),
+      stream_(false) {
+}
+
+// MappedFileHandle constructor: Maps a window of an open file read-only.
+// Parameters:
+//   fd: Open file descriptor; the handle borrows it and never closes it.
+//   offset: Absolute file offset of the window start.
+//   length: Number of bytes to map.
+// mmap requires a page-aligned offset, so the mapping starts at the enclosing page
+// and data_ is advanced to the requested offset.
+MappedFileHandle::MappedFileHandle(int fd, off_t offset, size_t length) noexcept
+    : MappedFileHandle() {
+    if (fd == -1 || offset < 0 || length == 0) {
+        return;
+    }
+    const off_t page_size = static_cast<off_t>(::sysconf(_SC_PAGESIZE));
+    const off_t aligned_offset = offset - (offset % page_size);
+    const size_t delta = static_cast<size_t>(offset - aligned_offset);
+
+    void* base = ::mmap(nullptr, length + delta, PROT_READ, MAP_PRIVATE, fd, aligned_offset);
+    if (base == MAP_FAILED) {
+        return;
+    }
+    // Sequential hint doubles readahead and lets the kernel drop pages behind the scan.
+    ::madvise(base, length + delta, MADV_SEQUENTIAL);
+
+    fd_ = fd;
+    map_base_ = base;
+    map_length_ = length + delta;
+    data_ = static_cast<const char*>(base) + delta;
+    offset_ = offset;
+    length_ = length;
+    position_ = offset;
+}
+
+// Move constructor: Transfers ownership of the mapping.
+// Parameters:
+//   other: Source MappedFileHandle to move from.
+// Ensures the source is left without a mapping.
+MappedFileHandle::MappedFileHandle(MappedFileHandle&& other) noexcept
+    : fd_(other.fd_), map_base_(other.map_base_), map_length_(other.map_length_), data_(other.data_),
+      offset_(other.offset_), length_(other.length_), position_(other.position_), stream_(other.stream_) {
+    other.fd_ = -1;
+    other.stream_ = false;
+    other.map_base_ = nullptr;
+    other.map_length_ = 0;
+    other.data_ = nullptr;
+    other.length_ = 0;
+}
+
+// Move assignment operator: Transfers ownership of the mapping.
+// Parameters:
+//   other: Source MappedFileHandle to move from.
+// Returns:
+//   Reference to this MappedFileHandle.
+// Unmaps the existing window before taking ownership.
+MappedFileHandle& MappedFileHandle::operator=(MappedFileHandle&& other) noexcept {
+    if (this != &other) {
+        unmap();
+        fd_ = other.fd_;
+        map_base_ = other.map_base_;
+        map_length_ = other.map_length_;
+        data_ = other.data_;
+        offset_ = other.offset_;
+        length_ = other.length_;
+        position_ = other.position_;
+        stream_ = other.stream_;
+        other.fd_ = -1;
+        other.stream_ = false;
+        other.map_base_ = nullptr;
+        other.map_length_ = 0;
+        other.data_ = nullptr;
+        other.length_ = 0;
+    }
+    return *this;
+}
+
+// Destructor: Unmaps the window if mapped.
+MappedFileHandle::~MappedFileHandle() noexcept {
+    unmap();
+}
+
+// unmap: Releases the mapping and resets the handle to the unmapped state.
+void MappedFileHandle::unmap() noexcept {
+    if (map_base_ != nullptr) {
+        ::munmap(map_base_, map_length_);
+        if (stream_) {
+            // The scan is done with the window; the pages are clean, so dropping them is cheap.
+            ::posix_fadvise(fd_, offset_, static_cast<off_t>(length_), POSIX_FADV_DONTNEED);
+        }
+    }
+    fd_ = -1;
+    stream_ = false;
+    map_base_ = nullptr;
+    map_length_ = 0;
+    data_ = nullptr;
+    length_ = 0;
+}
+
+// is_open: Checks if a window is mapped.
+// Returns:
+//   True if the mapping is valid, false otherwise.
+bool MappedFileHandle::is_open() const noexcept {
+    return map_base_ != nullptr;
+}
+
+// get: Retrieves the borrowed file descriptor.
+// Returns:
+//   The file descriptor the window was mapped from, or -1 if unmapped.
+int MappedFileHandle::get() const noexcept {
+    return fd_;
+}
+
+// seek: Sets the read position within the mapped window.
+// Parameters:
+//   offset: New offset value (absolute for SEEK_SET).
+//   whence: Seek mode (SEEK_SET, SEEK_CUR, SEEK_END relative to the window end).
+// Returns:
+//   The resulting absolute offset, or -1 if it falls outside the window.
+off_t MappedFileHandle::seek(off_t offset, int whence) noexcept {
+    off_t target;
+    switch (whence) {
+        case SEEK_SET: target = offset; break;
+        case SEEK_CUR: target = position_ + offset; break;
+        case SEEK_END: target = offset_ + static_cast<off_t>(length_) + offset; break;
+        default: return -1;
+    }
+    if (!is_open() || target < offset_ || target > offset_ + static_cast<off_t>(length_)) {
+        return -1;
+    }
+    position_ = target;
+    return position_;
+}
+
+// read: Copies bytes from the mapping into a buffer.
+// Parameters:
+//   buffer: Destination buffer for read data.
+//   size: Maximum number of bytes to read.
+// Returns:
+//   Number of bytes read (0 at the window end), or -1 if unmapped.
+// Provided for interface compatibility; hot paths should use view() instead.
+ssize_t MappedFileHandle::read(char* buffer, size_t size) noexcept {
+    if (!is_open()) {
+        return -1;
+    }
+    const size_t consumed = static_cast<size_t>(position_ - offset_);
+    const size_t n = std::min(size, length_ - consumed);
+    std::memcpy(buffer, data_ + consumed, n);
+    position_ += static_cast<off_t>(n);
+    return static_cast<ssize_t>(n);
+}
+
+// pread: Copies bytes at an absolute offset from the mapping into a buffer.
+// Parameters:
+//   buffer: Destination buffer for read data.
+//   size: Maximum number of bytes to read.
+//   offset: Absolute file offset of the first byte.
+// Returns:
+//   Number of bytes read (0 past the window end), or -1 if unmapped or before the window.
+ssize_t MappedFileHandle::pread(char* buffer, size_t size, off_t offset) noexcept {
+    if (!is_open() || offset < offset_) {
+        return -1;
+    }
+    const size_t skipped = static_cast<size_t>(offset - offset_);
+    if (skipped >= length_) {
+        return 0;
+    }
+    const size_t n = std::min(size, length_ - skipped);
+    std::memcpy(buffer, data_ + skipped, n);
+    return static_cast<ssize_t>(n);
+}
+
+// write: Not supported on a read-only mapping.
+// Returns:
+//   Always -1.
+ssize_t MappedFileHandle::write(const char* buffer, size_t size) noexcept {
+    (void)buffer;
+    (void)size;
+    return -1;
+}
+
+// view: Provides zero-copy access to a byte range inside the mapped window.
+// Parameters:
+//   offset: Absolute file offset of the first byte.
+//   size: Number of bytes requested.
+// Returns:
+//   Pointer into the mapping, or nullptr if the range is not fully mapped.
+const char* MappedFileHandle::view(off_t offset, size_t size) const noexcept {
+    if (!is_open() || offset < offset_ ||
+        static_cast<size_t>(offset - offset_) + size > length_) {
+        return nullptr;
+    }
+    return data_ + (offset - offset_);
+}
+
+// set_cache_mode: Chooses how the window uses the page cache.
+// Parameters:
+//   mode: BUFFERED or STREAM; a mapping cannot bypass the cache, so DIRECT is refused.
+// Returns:
+//   True if the mode is in effect.
+// STREAM starts reading the whole window at once and drops it from the cache on unmap.
+bool MappedFileHandle::set_cache_mode(CacheMode mode) noexcept {
+    if (!is_open() || mode == CacheMode::DIRECT) {
+        return false;
+    }
+    stream_ = mode == CacheMode::STREAM;
+    if (stream_) {
+        ::posix_fadvise(fd_, offset_, static_cast<off_t>(length_), POSIX_FADV_WILLNEED);
+    }
+    return true;
+}
+
+// cache_mode: Reports the mode in effect.
+// Returns:
+//   STREAM or BUFFERED.
+CacheMode MappedFileHandle::cache_mode() const noexcept {
+    return stream_ ? CacheMode::STREAM : CacheMode::BUFFERED;
 }
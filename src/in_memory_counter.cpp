@@ -0,0 +1,196 @@
+// in_memory_counter.cpp: Implementation of InMemoryCounter for the exact in-RAM fast path.
+// This file scans word-aligned chunks in parallel into a sharded hash set and stops
+// claiming chunks once the set outgrows its memory threshold.
+
+#include "in_memory_counter.hpp"
+#include "chunk_coordinator.hpp"
+#include "chunk_processor.hpp"
+#include "io_uring_file_handle.hpp"
+#include "run_writer.hpp"
+#include "string_sort.hpp"
+#include <functional>
+#include <mutex>
+#include <vector>
+
+// Constructor: Initializes InMemoryCounter with the input file and spill threshold.
+// Parameters:
+//   input_file: Unique pointer to the input file handle.
+//   file_size: Total size of the input file.
+//   memory_threshold: Estimated set size in bytes above which counting stops.
+//   chunk_size: Nominal chunk size (a zero value falls back to the default).
+//   pool: Worker pool that runs the scanning loops.
+InMemoryCounter::InMemoryCounter(std::unique_ptr<FileHandle> input_file, size_t file_size, size_t memory_threshold,
+                                 size_t chunk_size, ThreadPool& pool) noexcept
+    : InMemoryCounter(std::vector<InputFile>(), memory_threshold, chunk_size, pool) {
+    inputs_.push_back({std::move(input_file), file_size});
+}
+
+// Constructor: Initializes InMemoryCounter with several input files counted as one.
+// Parameters:
+//   inputs: Input files and their sizes, scanned in order.
+//   memory_threshold: Estimated set size in bytes above which counting stops.
+//   chunk_size: Nominal chunk size (a zero value falls back to the default).
+//   pool: Worker pool that runs the scanning loops.
+InMemoryCounter::InMemoryCounter(std::vector<InputFile> inputs, size_t memory_threshold, size_t chunk_size,
+                                 ThreadPool& pool) noexcept
+    : inputs_(std::move(inputs)), memory_threshold_(memory_threshold),
+      chunk_size_(chunk_size == 0 ? DEFAULT_CHUNK_SIZE : chunk_size), pool_(pool), resume_input_(0),
+      resume_offset_(0), words_scanned_(0), bytes_scanned_(0) {
+}
+
+// count: Inserts chunk words into the set until the file ends or memory runs short.
+// Returns:
+//   True if every byte was counted, false if the threshold stopped the scan early or a
+//   chunk could not be read.
+// Chunks are claimed in input and file order under a mutex, so after the workers join
+// every byte before the resume position has been inserted. A chunk already claimed is
+// always finished, which bounds the overshoot to one chunk per worker. A chunk that
+// fails to load stops the claims and moves the resume position back to its start, so
+// the external pass reads it again (and reports the error if it fails there too);
+// words of later chunks that were already inserted are simply seen twice.
+bool InMemoryCounter::count() noexcept {
+    std::mutex claim_mutex;
+    InputCursor cursor(inputs_, chunk_size_, resume_input_, resume_offset_);
+    bool failed = false;
+    size_t failed_input = 0;
+    off_t failed_offset = 0;
+
+    auto worker = [&]() {
+        for (;;) {
+            size_t input;
+            off_t chunk_start;
+            size_t chunk_size;
+            {
+                std::lock_guard<std::mutex> lock(claim_mutex);
+                if (failed || words_.memory_usage() >= memory_threshold_ ||
+                    !cursor.claim(input, chunk_start, chunk_size)) {
+                    return;
+                }
+            }
+
+            const FileHandle& file = *inputs_[input].file;
+            ChunkProcessor processor(ChunkProcessor::open_chunk(file.get(), chunk_start, chunk_size, file.cache_mode()),
+                                     std::make_unique<SpaceSeparatedParser>());
+            WordArena arena;
+            std::vector<std::string_view> chunk_words;
+            if (!processor.collect_distinct(chunk_start, chunk_size, arena, chunk_words)) {
+                std::lock_guard<std::mutex> lock(claim_mutex);
+                if (!failed || input < failed_input || (input == failed_input && chunk_start < failed_offset)) {
+                    failed_input = input;
+                    failed_offset = chunk_start;
+                }
+                failed = true;
+                return;
+            }
+            words_.insert_batch(chunk_words);
+            words_scanned_.fetch_add(processor.words_parsed(), std::memory_order_relaxed);
+            bytes_scanned_.fetch_add(chunk_size, std::memory_order_relaxed);
+        }
+    };
+
+    // One claiming loop per pool worker; chunks are handed out dynamically inside them.
+    pool_.run_all(std::vector<std::function<void()>>(pool_.size(), worker));
+
+    if (failed) {
+        resume_input_ = failed_input;
+        resume_offset_ = failed_offset;
+        return false;
+    }
+    resume_input_ = cursor.input();
+    resume_offset_ = cursor.offset();
+    return cursor.done();
+}
+
+// unique_count: Number of distinct words inserted so far.
+// Returns:
+//   Size of the shared set.
+size_t InMemoryCounter::unique_count() const noexcept {
+    return words_.size();
+}
+
+// words_scanned: Words parsed by count() so far, duplicates included.
+// Returns:
+//   Sum of the chunk processors' parsed word counts.
+size_t InMemoryCounter::words_scanned() const noexcept {
+    return words_scanned_.load();
+}
+
+// bytes_scanned: Input bytes counted by count() so far.
+// Returns:
+//   Sum of the counted chunk sizes.
+size_t InMemoryCounter::bytes_scanned() const noexcept {
+    return bytes_scanned_.load();
+}
+
+// resume_offset: First byte of resume_input() not yet counted.
+// Returns:
+//   Word-aligned offset where external processing must continue.
+off_t InMemoryCounter::resume_offset() const noexcept {
+    return resume_offset_;
+}
+
+// resume_input: Input that resume_offset() refers to.
+// Returns:
+//   Index into the inputs.
+size_t InMemoryCounter::resume_input() const noexcept {
+    return resume_input_;
+}
+
+// release_inputs: Hands the input files over to the external pass.
+// Returns:
+//   The input files and their sizes; the resume position indexes into them.
+// Reusing the handles keeps a multi-file run from holding two descriptors per file.
+std::vector<InputFile> InMemoryCounter::release_inputs() noexcept {
+    std::vector<InputFile> inputs;
+    inputs.swap(inputs_);
+    return inputs;
+}
+
+// spill: Writes the set's words as one sorted run for the external merge.
+// Parameters:
+//   temp_file: Receives the TempFile holding the sorted distinct words seen so far.
+// Returns:
+//   True on success, false if the run could not be opened or written; the run is
+//   then incomplete and must not be merged.
+// The set is cleared afterwards so its memory is available to the external pipeline.
+bool InMemoryCounter::spill(TempFile& temp_file) noexcept {
+    std::vector<std::string_view> sorted = words_.words();
+    msd_radix_sort(sorted);
+
+    auto file = std::make_unique<IoUringFileHandle>(temp_file.name().c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0600,
+                                                    IoUringFileHandle::RUN_QUEUE_DEPTH, RunWriter::DEFAULT_BLOCK_SIZE);
+    if (!file->is_open()) {
+        ssize_t res = write(STDERR_FILENO, "Error: Could not open temp file for writing\n", 43);
+        (void)res;
+        return false;
+    }
+    file->set_cache_mode(inputs_.empty() ? CacheMode::BUFFERED : inputs_.front().file->cache_mode());
+    bool written;
+    {
+        RunWriter writer(std::move(file));
+        for (const auto& word : sorted) {
+            writer.append(word);
+        }
+        written = writer.finish();
+        if (!written) {
+            ssize_t res = write(STDERR_FILENO, "Error: Could not write temp file\n", 32);
+            (void)res;
+        }
+    }
+    sorted.clear();
+    sorted.shrink_to_fit();
+    words_.clear();
+    return written;
+}
+
+// default_memory_threshold: Derives a threshold from the machine's physical memory.
+// Returns:
+//   A quarter of physical RAM, or 1 GiB if it cannot be determined.
+size_t InMemoryCounter::default_memory_threshold() noexcept {
+    const long pages = ::sysconf(_SC_PHYS_PAGES);
+    const long page_size = ::sysconf(_SC_PAGESIZE);
+    if (pages <= 0 || page_size <= 0) {
+        return 1ULL << 30;
+    }
+    return static_cast<size_t>(pages) * static_cast<size_t>(page_size) / 4;
+}
@@ -0,0 +1,252 @@
+// incremental_counter.cpp: Implementation of IncrementalCounter for append-only inputs.
+// This file validates a persisted dictionary, parses only the appended bytes into sorted
+// runs and merges them with the dictionary into its replacement.
+
+#include "incremental_counter.hpp"
+#include "chunk_coordinator.hpp"
+#include "hyperloglog.hpp"
+#include "io_uring_file_handle.hpp"
+#include "parser.hpp"
+#include "run_format.hpp"
+#include "run_partition.hpp"
+#include "run_reader.hpp"
+#include "run_writer.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+namespace {
+
+// Magic at the start of a dictionary's footer.
+constexpr char STATE_MAGIC[4] = {'W', 'C', 'D', 'I'};
+
+// read_range: Reads size bytes at offset, retrying short reads.
+bool read_range(FileHandle& file, off_t offset, char* out, size_t size) noexcept {
+    while (size > 0) {
+        const ssize_t bytes_read = file.pread(out, size, offset);
+        if (bytes_read <= 0) {
+            return false;
+        }
+        out += bytes_read;
+        offset += bytes_read;
+        size -= static_cast<size_t>(bytes_read);
+    }
+    return true;
+}
+
+// last_space: Finds the last space in [start, end) by scanning backwards.
+// Returns: Its offset, start if the range has none, or -1 on a read error.
+off_t last_space(FileHandle& file, off_t start, off_t end) noexcept {
+    char buffer[4096];
+    off_t position = end;
+    while (position > start) {
+        const size_t size = static_cast<size_t>(std::min<off_t>(sizeof(buffer), position - start));
+        position -= static_cast<off_t>(size);
+        if (!read_range(file, position, buffer, size)) {
+            return -1;
+        }
+        for (size_t i = size; i > 0; --i) {
+            if (buffer[i - 1] == ' ') {
+                return position + static_cast<off_t>(i - 1);
+            }
+        }
+    }
+    return start;
+}
+
+// contains_word: Looks a word up in a plain run through its block index.
+// Parameters:
+//   path: Run to search.
+//   word: Word to look up.
+//   found: Receives whether the run holds the word.
+// Returns: True if the run could be searched, false if it could not be opened or read.
+bool contains_word(const std::string& path, std::string_view word, bool& found) noexcept {
+    found = false;
+    auto file = std::make_unique<SyscallFileHandle>(path.c_str(), O_RDONLY);
+    run_format::RunIndex index;
+    if (!file->is_open() || !run_format::read_run_index(*file, index)) {
+        return false;
+    }
+    const off_t begin = slice_begin(index, word);
+    if (begin >= index.data_end) {
+        return true;
+    }
+    if (file->seek(begin, SEEK_SET) != begin) {
+        return false;
+    }
+    RunReader reader(std::move(file), RunReader::DEFAULT_BLOCK_SIZE, static_cast<size_t>(index.data_end - begin));
+    std::string_view next;
+    while (reader.next(next)) {
+        if (next >= word) {
+            found = next == word;
+            return true;
+        }
+    }
+    return !reader.failed();
+}
+
+} // namespace
+
+// Constructor: Initializes IncrementalCounter with the input file and the dictionary's path.
+// Parameters:
+//   input_file: Unique pointer to the input file handle.
+//   file_size: Total size of the input file.
+//   dictionary_path: Dictionary to read and replace.
+//   options: Merge options of the dictionary update.
+//   memory_limit: Budget of the parsed chunks (0 = none).
+IncrementalCounter::IncrementalCounter(std::unique_ptr<FileHandle> input_file, size_t file_size,
+                                       std::string dictionary_path, WordCounter::Options options,
+                                       size_t memory_limit) noexcept
+    : input_file_(std::move(input_file)), file_size_(file_size), dictionary_path_(std::move(dictionary_path)),
+      options_(options), memory_limit_(memory_limit), unique_count_(0), resume_offset_(0) {
+}
+
+// count: Counts the file's unique words and updates the dictionary.
+// Returns:
+//   True on success, false if the input, a run or the dictionary could not be read or
+//   the dictionary written; the old dictionary is then left in place.
+// Only the bytes between the dictionary's offset and the last space of the file are
+// parsed; they go through the usual chunk pipeline into sorted runs, which are merged
+// with the old dictionary into "<path>.tmp". The new dictionary is synced and renamed
+// over the old one, so a crash leaves either the old or the new state. The word after
+// the last space is looked up in the new dictionary and counted if it is not there.
+bool IncrementalCounter::count() noexcept {
+    State state = {0, 0, 0};
+    bool have_base = false;
+    if (::access(dictionary_path_.c_str(), F_OK) == 0) {
+        have_base = read_state(dictionary_path_, state) && state.processed <= file_size_ &&
+                    fingerprint(*input_file_, state.processed) == state.fingerprint;
+        if (!have_base) {
+            ssize_t res = write(STDERR_FILENO, "Warning: Dictionary does not match the input, counting from the start\n", 70);
+            (void)res;
+        }
+    }
+    resume_offset_ = have_base ? static_cast<off_t>(state.processed) : 0;
+
+    // Everything up to the last space is final; the word after it may still grow.
+    const off_t cut = last_space(*input_file_, resume_offset_, static_cast<off_t>(file_size_));
+    std::string tail(cut < 0 ? 0 : file_size_ - static_cast<size_t>(cut), '\0');
+    const uint64_t cut_fingerprint = cut < 0 ? 0 : fingerprint(*input_file_, static_cast<uint64_t>(cut));
+    if (cut < 0 || !read_range(*input_file_, cut, &tail[0], tail.size())) {
+        ssize_t res = write(STDERR_FILENO, "Error: Could not read input file\n", 33);
+        (void)res;
+        return false;
+    }
+    tail.erase(0, std::min(tail.size(), tail.find_first_not_of(' ')));
+
+    size_t words = static_cast<size_t>(state.words);
+    if (!have_base || cut > resume_offset_) {
+        std::vector<TempFile> temp_files;
+        if (cut > resume_offset_) {
+            // The coordinator gets its own descriptor, so the counter keeps its input for later counts.
+            auto chunk_input = std::make_unique<SyscallFileHandle>(::dup(input_file_->get()));
+            chunk_input->set_cache_mode(input_file_->cache_mode());
+            ChunkCoordinator coordinator(std::move(chunk_input), std::make_unique<SpaceSeparatedParser>(),
+                                         static_cast<size_t>(cut));
+            coordinator.set_memory_limit(memory_limit_);
+            if (!coordinator.process_chunks(temp_files, resume_offset_)) {
+                return false;
+            }
+        }
+        std::vector<std::string> run_names;
+        if (have_base) {
+            run_names.push_back(dictionary_path_);
+        }
+        for (const auto& temp_file : temp_files) {
+            run_names.push_back(temp_file.name());
+        }
+
+        const std::string temp_path = dictionary_path_ + ".tmp";
+        auto file = std::make_unique<IoUringFileHandle>(temp_path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0600,
+                                                        IoUringFileHandle::RUN_QUEUE_DEPTH, RunWriter::DEFAULT_BLOCK_SIZE);
+        if (!file->is_open()) {
+            ssize_t res = write(STDERR_FILENO, "Error: Could not open dictionary for writing\n", 45);
+            (void)res;
+            return false;
+        }
+        file->set_cache_mode(options_.cache_mode);
+        bool written;
+        {
+            RunWriter writer(std::move(file));
+            WordCounter counter(nullptr, options_);
+            const bool merged = counter.merge_into(run_names, writer, words);
+            char footer[STATE_SIZE];
+            std::memcpy(footer, STATE_MAGIC, sizeof(STATE_MAGIC));
+            run_format::put_u64(footer + 4, static_cast<uint64_t>(cut));
+            run_format::put_u64(footer + 12, words);
+            run_format::put_u64(footer + 20, cut_fingerprint);
+            written = writer.finish(std::string_view(footer, sizeof(footer))) && merged;
+        }
+        SyscallFileHandle synced(temp_path.c_str(), O_RDONLY);
+        if (!written || !synced.is_open() || ::fdatasync(synced.get()) != 0 ||
+            std::rename(temp_path.c_str(), dictionary_path_.c_str()) != 0) {
+            ::unlink(temp_path.c_str());
+            ssize_t res = write(STDERR_FILENO, "Error: Could not write dictionary\n", 34);
+            (void)res;
+            return false;
+        }
+    }
+
+    bool tail_known = false;
+    if (!tail.empty() && !contains_word(dictionary_path_, tail, tail_known)) {
+        ssize_t res = write(STDERR_FILENO, "Error: Could not read dictionary\n", 33);
+        (void)res;
+        return false;
+    }
+    unique_count_ = words + (!tail.empty() && !tail_known ? 1 : 0);
+    return true;
+}
+
+// unique_count: Number of distinct words in the whole file.
+// Returns:
+//   The count of the last successful count().
+size_t IncrementalCounter::unique_count() const noexcept {
+    return unique_count_;
+}
+
+// resume_offset: Offset the last count() started parsing at.
+// Returns:
+//   The dictionary's processed offset, or 0 if it was missing or did not match.
+off_t IncrementalCounter::resume_offset() const noexcept {
+    return resume_offset_;
+}
+
+// read_state: Loads the footer of a dictionary.
+// Parameters:
+//   path: Dictionary file.
+//   state: Receives the recorded state.
+// Returns:
+//   True if the file is a finished plain run with a dictionary footer.
+bool IncrementalCounter::read_state(const std::string& path, State& state) noexcept {
+    SyscallFileHandle file(path.c_str(), O_RDONLY);
+    run_format::RunIndex index;
+    std::string footer;
+    if (!file.is_open() || !run_format::read_run_index(file, index) ||
+        (index.flags & run_format::FLAG_COUNTS) != 0 || !run_format::read_run_footer(file, index, footer) ||
+        footer.size() != STATE_SIZE || std::memcmp(footer.data(), STATE_MAGIC, sizeof(STATE_MAGIC)) != 0) {
+        return false;
+    }
+    state.processed = run_format::get_u64(footer.data() + 4);
+    state.words = run_format::get_u64(footer.data() + 12);
+    state.fingerprint = run_format::get_u64(footer.data() + 20);
+    return true;
+}
+
+// fingerprint: Hashes the end of the input's first bytes.
+// Parameters:
+//   input: Input file.
+//   offset: Length of the prefix.
+// Returns:
+//   Hash of the offset and the last FINGERPRINT_SIZE bytes before it, or 0 on a read error.
+// An append never changes the prefix, so a different hash means the file was truncated
+// or rewritten; the check is a cheap guard, not a proof the whole prefix is unchanged.
+uint64_t IncrementalCounter::fingerprint(FileHandle& input, uint64_t offset) noexcept {
+    const size_t size = static_cast<size_t>(std::min<uint64_t>(offset, FINGERPRINT_SIZE));
+    std::string bytes(size + sizeof(offset), '\0');
+    if (!read_range(input, static_cast<off_t>(offset - size), &bytes[0], size)) {
+        return 0;
+    }
+    run_format::put_u64(&bytes[size], offset);
+    return HyperLogLog::hash(bytes);
+}
@@ -0,0 +1,134 @@
+// input_files.cpp: Implementation of multi-file input and InputCursor.
+// This file expands glob patterns and manifests and claims chunks across several inputs.
+
+#include "input_files.hpp"
+#include "chunk_coordinator.hpp"
+#include <cstring>
+#include <glob.h>
+
+// Constructor: Starts at a position in the list.
+// Parameters:
+//   inputs: Inputs to hand out; not owned.
+//   chunk_size: Nominal chunk size (at least one byte).
+//   input: Index of the input to start in.
+//   offset: Word-aligned offset within that input.
+InputCursor::InputCursor(const std::vector<InputFile>& inputs, size_t chunk_size, size_t input, off_t offset) noexcept
+    : inputs_(inputs), chunk_size_(chunk_size == 0 ? 1 : chunk_size), input_(input), offset_(offset) {
+}
+
+// claim: Takes the next chunk.
+// Parameters:
+//   input: Output index of the chunk's input.
+//   start: Output offset of the chunk within that input.
+//   size: Output number of bytes in the chunk.
+// Returns:
+//   True if a chunk was claimed, false once every input is exhausted.
+// Exhausted inputs are skipped, but the cursor never moves past the last one, so a
+// finished single-file scan reports the file size as its offset.
+bool InputCursor::claim(size_t& input, off_t& start, size_t& size) noexcept {
+    while (input_ + 1 < inputs_.size() && offset_ >= static_cast<off_t>(inputs_[input_].size)) {
+        ++input_;
+        offset_ = 0;
+    }
+    if (done()) {
+        return false;
+    }
+    const InputFile& file = inputs_[input_];
+    const off_t end = ChunkCoordinator::find_chunk_end(*file.file, offset_ + static_cast<off_t>(chunk_size_), file.size);
+    input = input_;
+    start = offset_;
+    size = static_cast<size_t>(end - offset_);
+    offset_ = end;
+    return true;
+}
+
+// done: Checks if every input has been handed out.
+// Returns:
+//   True if the current input and all later ones have no bytes left.
+bool InputCursor::done() const noexcept {
+    for (size_t i = input_; i < inputs_.size(); ++i) {
+        const off_t start = i == input_ ? offset_ : 0;
+        if (start < static_cast<off_t>(inputs_[i].size)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// input: Index of the input the next chunk comes from.
+// Returns:
+//   Input index.
+size_t InputCursor::input() const noexcept {
+    return input_;
+}
+
+// offset: Offset of the next chunk within input().
+// Returns:
+//   Word-aligned offset.
+off_t InputCursor::offset() const noexcept {
+    return offset_;
+}
+
+// expand_input_name: Adds the files an input argument names.
+// Parameters:
+//   name: File name, "-", or a glob pattern.
+//   names: Receives the file names.
+// Returns:
+//   True on success, false if a pattern matches no file.
+// Patterns are expanded here as well as by the shell, so quoted patterns and manifest
+// lines work, and shard directories too large for the argument list can be named.
+bool expand_input_name(const char* name, std::vector<std::string>& names) noexcept {
+    if (strpbrk(name, "*?[") == nullptr) {
+        names.emplace_back(name);
+        return true;
+    }
+    glob_t matches;
+    if (::glob(name, 0, nullptr, &matches) != 0) {
+        ::globfree(&matches);
+        return false;
+    }
+    for (size_t i = 0; i < matches.gl_pathc; ++i) {
+        names.emplace_back(matches.gl_pathv[i]);
+    }
+    ::globfree(&matches);
+    return true;
+}
+
+// read_manifest: Adds the inputs listed in a manifest file.
+// Parameters:
+//   filename: Manifest with one file name or glob pattern per line.
+//   names: Receives the expanded file names.
+// Returns:
+//   True on success, false if the manifest cannot be read or a pattern matches nothing.
+// Lines may end in CRLF; blank lines are skipped.
+bool read_manifest(const char* filename, std::vector<std::string>& names) noexcept {
+    SyscallFileHandle file(filename, O_RDONLY);
+    if (!file.is_open()) {
+        return false;
+    }
+    std::string content;
+    char buffer[4096];
+    ssize_t bytes_read;
+    while ((bytes_read = file.read(buffer, sizeof(buffer))) > 0) {
+        content.append(buffer, static_cast<size_t>(bytes_read));
+    }
+    if (bytes_read < 0) {
+        return false;
+    }
+    size_t line_start = 0;
+    while (line_start < content.size()) {
+        size_t line_end = content.find('\n', line_start);
+        if (line_end == std::string::npos) {
+            line_end = content.size();
+        }
+        std::string line = content.substr(line_start, line_end - line_start);
+        if (!line.empty() && line.back() == '\r') {
+            line.pop_back();
+        }
+        if (!line.empty() && !expand_input_name(line.c_str(), names)) {
+            return false;
+        }
+        line_start = line_end + 1;
+    }
+    return true;
+}
@@ -0,0 +1,655 @@
+// io_uring_file_handle.cpp: Implementation of IoUring and IoUringFileHandle for overlapped file I/O.
+// This file drives io_uring through its raw syscalls and layers read-ahead and write-behind on it.
+
+#include "io_uring_file_handle.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstring>
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+
+namespace {
+
+// Set by IoUring::set_enabled(); checked whenever a thread picks its ring.
+std::atomic<bool> ring_enabled{true};
+
+// io_uring_setup: Creates a ring (no glibc wrapper exists).
+int io_uring_setup(unsigned entries, io_uring_params* params) noexcept {
+    return static_cast<int>(::syscall(__NR_io_uring_setup, entries, params));
+}
+
+// io_uring_enter: Submits entries and/or waits for completions.
+int io_uring_enter(int fd, unsigned to_submit, unsigned min_complete, unsigned flags) noexcept {
+    return static_cast<int>(::syscall(__NR_io_uring_enter, fd, to_submit, min_complete, flags, nullptr, 0));
+}
+
+// supports_read_write: Checks that a ring accepts IORING_OP_READ and IORING_OP_WRITE.
+// Parameters:
+//   fd: Ring descriptor.
+// Returns:
+//   True if the kernel's opcode probe lists both as supported.
+// Rings can be set up since Linux 5.1, but the plain read and write opcodes arrived in
+// 5.6 together with IORING_REGISTER_PROBE; older kernels fail the probe and would fail
+// every read and write with -EINVAL.
+bool supports_read_write(int fd) noexcept {
+    constexpr unsigned PROBE_OPS = 256;
+    std::vector<char> buffer(sizeof(io_uring_probe) + PROBE_OPS * sizeof(io_uring_probe_op), 0);
+    io_uring_probe* probe = reinterpret_cast<io_uring_probe*>(buffer.data());
+    if (::syscall(__NR_io_uring_register, fd, IORING_REGISTER_PROBE, probe, PROBE_OPS) < 0) {
+        return false;
+    }
+    auto supported = [probe](unsigned opcode) {
+        return opcode <= probe->last_op && (probe->ops[opcode].flags & IO_URING_OP_SUPPORTED) != 0;
+    };
+    return supported(IORING_OP_READ) && supported(IORING_OP_WRITE);
+}
+
+// at: Pointer to a ring field at a kernel-reported offset.
+unsigned* at(void* ring, unsigned offset) noexcept {
+    return reinterpret_cast<unsigned*>(static_cast<char*>(ring) + offset);
+}
+
+} // namespace
+
+// Constructor: Sets up the ring and maps its queues.
+// Parameters:
+//   entries: Submission queue size.
+// Any failure, including a kernel without the read and write opcodes, leaves the ring
+// closed so callers fall back to blocking syscalls.
+IoUring::IoUring(unsigned entries) noexcept
+    : ring_fd_(-1), sq_ring_(MAP_FAILED), sq_ring_size_(0), cq_ring_(MAP_FAILED), cq_ring_size_(0),
+      sqes_(nullptr), sqes_size_(0), sq_tail_(nullptr), sq_mask_(nullptr), sq_array_(nullptr),
+      cq_head_(nullptr), cq_tail_(nullptr), cq_mask_(nullptr), cqes_(nullptr), cq_entries_(0), in_flight_(0) {
+    io_uring_params params;
+    std::memset(&params, 0, sizeof(params));
+    const int fd = io_uring_setup(entries, &params);
+    if (fd < 0) {
+        return;
+    }
+    if (!supports_read_write(fd)) {
+        ::close(fd);
+        return;
+    }
+
+    sq_ring_size_ = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+    cq_ring_size_ = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+    const bool single_mmap = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+    if (single_mmap) {
+        sq_ring_size_ = cq_ring_size_ = std::max(sq_ring_size_, cq_ring_size_);
+    }
+    sq_ring_ = ::mmap(nullptr, sq_ring_size_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd,
+                      IORING_OFF_SQ_RING);
+    if (sq_ring_ == MAP_FAILED) {
+        ::close(fd);
+        return;
+    }
+    cq_ring_ = single_mmap ? sq_ring_
+                           : ::mmap(nullptr, cq_ring_size_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd,
+                                    IORING_OFF_CQ_RING);
+    sqes_size_ = params.sq_entries * sizeof(io_uring_sqe);
+    void* sqes = ::mmap(nullptr, sqes_size_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQES);
+    if (cq_ring_ == MAP_FAILED || sqes == MAP_FAILED) {
+        if (sqes != MAP_FAILED) {
+            ::munmap(sqes, sqes_size_);
+        }
+        if (cq_ring_ != MAP_FAILED && cq_ring_ != sq_ring_) {
+            ::munmap(cq_ring_, cq_ring_size_);
+        }
+        ::munmap(sq_ring_, sq_ring_size_);
+        sq_ring_ = cq_ring_ = MAP_FAILED;
+        ::close(fd);
+        return;
+    }
+
+    sqes_ = static_cast<io_uring_sqe*>(sqes);
+    sq_tail_ = at(sq_ring_, params.sq_off.tail);
+    sq_mask_ = at(sq_ring_, params.sq_off.ring_mask);
+    sq_array_ = at(sq_ring_, params.sq_off.array);
+    cq_head_ = at(cq_ring_, params.cq_off.head);
+    cq_tail_ = at(cq_ring_, params.cq_off.tail);
+    cq_mask_ = at(cq_ring_, params.cq_off.ring_mask);
+    cqes_ = reinterpret_cast<io_uring_cqe*>(static_cast<char*>(cq_ring_) + params.cq_off.cqes);
+    cq_entries_ = params.cq_entries;
+    ring_fd_ = fd;
+}
+
+// Destructor: Waits for in-flight operations, then releases the ring.
+// The kernel may still write into request buffers until their completions are reaped.
+IoUring::~IoUring() noexcept {
+    if (ring_fd_ == -1) {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        while (in_flight_ > 0) {
+            reap(true);
+        }
+    }
+    ::munmap(sqes_, sqes_size_);
+    if (cq_ring_ != sq_ring_) {
+        ::munmap(cq_ring_, cq_ring_size_);
+    }
+    ::munmap(sq_ring_, sq_ring_size_);
+    ::close(ring_fd_);
+}
+
+// is_open: Checks if the ring was set up.
+// Returns:
+//   True if operations can be submitted.
+bool IoUring::is_open() const noexcept {
+    return ring_fd_ != -1;
+}
+
+// submit_read: Starts a positional read.
+// Parameters:
+//   fd: Descriptor to read from.
+//   buffer: Destination buffer.
+//   size: Number of bytes to read.
+//   offset: Absolute file offset.
+//   request: Completion slot.
+// Returns:
+//   True if the read was queued.
+bool IoUring::submit_read(int fd, char* buffer, size_t size, off_t offset, Request& request) noexcept {
+    return submit(IORING_OP_READ, fd, reinterpret_cast<unsigned long long>(buffer), size, offset, request);
+}
+
+// submit_write: Starts a positional write.
+// Parameters:
+//   fd: Descriptor to write to.
+//   buffer: Source buffer.
+//   size: Number of bytes to write.
+//   offset: Absolute file offset.
+//   request: Completion slot.
+// Returns:
+//   True if the write was queued.
+bool IoUring::submit_write(int fd, const char* buffer, size_t size, off_t offset, Request& request) noexcept {
+    return submit(IORING_OP_WRITE, fd, reinterpret_cast<unsigned long long>(buffer), size, offset, request);
+}
+
+// wait: Blocks until a request has completed.
+// Parameters:
+//   request: Submitted request.
+// Completions of other requests found on the way are recorded as well.
+void IoUring::wait(Request& request) noexcept {
+    std::lock_guard<std::mutex> lock(mutex_);
+    while (!request.done) {
+        reap(true);
+    }
+}
+
+// for_thread: Returns the calling thread's shared ring.
+// Returns:
+//   The ring, or nullptr if io_uring is unavailable or disabled.
+// The ring is created on first use and lives as long as the thread or the last
+// handle holding it, so a handle may be finished on another thread.
+std::shared_ptr<IoUring> IoUring::for_thread() noexcept {
+    if (!ring_enabled.load(std::memory_order_relaxed) || !available()) {
+        return nullptr;
+    }
+    thread_local std::shared_ptr<IoUring> ring;
+    if (!ring) {
+        auto created = std::make_shared<IoUring>();
+        if (!created->is_open()) {
+            return nullptr;
+        }
+        ring = std::move(created);
+    }
+    return ring;
+}
+
+// set_enabled: Switches new handles between io_uring and the blocking syscalls.
+// Parameters:
+//   enabled: False to make for_thread() return nullptr.
+void IoUring::set_enabled(bool enabled) noexcept {
+    ring_enabled.store(enabled, std::memory_order_relaxed);
+}
+
+// available: Checks once whether the kernel supports io_uring.
+// Returns:
+//   True if a ring with the read and write opcodes can be set up (seccomp filters
+//   refuse rings, and kernels before 5.6 lack the opcodes).
+bool IoUring::available() noexcept {
+    static const bool supported = IoUring(1).is_open();
+    return supported;
+}
+
+// submit: Fills one submission entry and hands it to the kernel.
+// Parameters:
+//   opcode: IORING_OP_READ or IORING_OP_WRITE.
+//   fd: Target descriptor.
+//   address: Buffer address.
+//   size: Number of bytes.
+//   offset: Absolute file offset.
+//   request: Completion slot, identified by its address in user_data.
+// Returns:
+//   True on success, false if io_uring_enter failed.
+// Each call submits its entry at once, so the submission queue never holds more than
+// one; in-flight requests are capped at the completion queue size so none is dropped.
+bool IoUring::submit(unsigned char opcode, int fd, unsigned long long address, size_t size, off_t offset,
+                     Request& request) noexcept {
+    if (ring_fd_ == -1) {
+        return false;
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    while (in_flight_ >= cq_entries_) {
+        reap(true);
+    }
+
+    const unsigned tail = *sq_tail_;
+    const unsigned index = tail & *sq_mask_;
+    io_uring_sqe& sqe = sqes_[index];
+    std::memset(&sqe, 0, sizeof(sqe));
+    sqe.opcode = opcode;
+    sqe.fd = fd;
+    sqe.addr = address;
+    sqe.len = static_cast<unsigned>(size);
+    sqe.off = static_cast<unsigned long long>(offset);
+    sqe.user_data = reinterpret_cast<unsigned long long>(&request);
+    sq_array_[index] = index;
+    request.done = false;
+    request.result = 0;
+    __atomic_store_n(sq_tail_, tail + 1, __ATOMIC_RELEASE);
+
+    for (;;) {
+        const int res = io_uring_enter(ring_fd_, 1, 0, 0);
+        if (res >= 1) {
+            ++in_flight_;
+            return true;
+        }
+        if (res < 0 && (errno == EINTR || errno == EAGAIN || errno == EBUSY) && in_flight_ > 0) {
+            reap(errno != EINTR);
+            continue;
+        }
+        if (res < 0 && errno == EINTR) {
+            continue;
+        }
+        // Take the entry back so a later submission does not pick it up.
+        __atomic_store_n(sq_tail_, tail, __ATOMIC_RELEASE);
+        request.done = true;
+        request.result = -1;
+        return false;
+    }
+}
+
+// reap: Moves completions into their requests.
+// Parameters:
+//   block: True to wait for at least one completion if none is ready.
+void IoUring::reap(bool block) noexcept {
+    for (;;) {
+        unsigned head = *cq_head_;
+        const unsigned tail = __atomic_load_n(cq_tail_, __ATOMIC_ACQUIRE);
+        if (head != tail) {
+            for (; head != tail; ++head) {
+                const io_uring_cqe& cqe = cqes_[head & *cq_mask_];
+                Request* request = reinterpret_cast<Request*>(cqe.user_data);
+                request->result = cqe.res;
+                request->done = true;
+                --in_flight_;
+            }
+            __atomic_store_n(cq_head_, head, __ATOMIC_RELEASE);
+            return;
+        }
+        if (!block || in_flight_ == 0) {
+            return;
+        }
+        io_uring_enter(ring_fd_, 0, 1, IORING_ENTER_GETEVENTS);
+    }
+}
+
+// IoUringFileHandle constructor: Opens a file.
+// Parameters:
+//   filename: Path to the file.
+//   flags: Open flags.
+//   mode: File permissions for created files.
+//   queue_depth: Number of blocks kept in flight.
+//   block_size: Size of every request.
+IoUringFileHandle::IoUringFileHandle(const char* filename, int flags, mode_t mode, size_t queue_depth,
+                                     size_t block_size) noexcept
+    : SyscallFileHandle(filename, flags, mode) {
+    init(queue_depth, block_size);
+}
+
+// IoUringFileHandle constructor: Takes ownership of an existing file descriptor.
+// Parameters:
+//   fd: Existing file descriptor.
+//   queue_depth: Number of blocks kept in flight.
+//   block_size: Size of every request.
+IoUringFileHandle::IoUringFileHandle(int fd, size_t queue_depth, size_t block_size) noexcept
+    : SyscallFileHandle(fd) {
+    init(queue_depth, block_size);
+}
+
+// Destructor: Waits for in-flight operations before the descriptor is closed.
+IoUringFileHandle::~IoUringFileHandle() noexcept {
+    if (!drain()) {
+        ssize_t res = ::write(STDERR_FILENO, "Error: Could not write file\n", 28);
+        (void)res;
+    }
+}
+
+// init: Sizes the slots and picks the ring.
+// Parameters:
+//   queue_depth: Number of blocks kept in flight.
+//   block_size: Size of every request.
+// Block buffers are allocated on first use, so a handle that is only opened and
+// closed, or that falls back to blocking syscalls, costs nothing.
+void IoUringFileHandle::init(size_t queue_depth, size_t block_size) noexcept {
+    head_ = 0;
+    count_ = 0;
+    block_size_ = std::max<size_t>(block_size, 1);
+    read_eof_ = false;
+    failed_ = false;
+    mode_ = Mode::IDLE;
+    position_ = 0;
+    next_read_ = 0;
+    if (!is_open()) {
+        fill_ = 0;
+        return;
+    }
+    ring_ = IoUring::for_thread();
+    if (ring_) {
+        slots_.resize(std::max<size_t>(queue_depth, 1));
+        position_ = std::max<off_t>(::lseek(get(), 0, SEEK_CUR), 0);
+    }
+    fill_ = slots_.size();
+}
+
+// async: Checks if the handle submits through io_uring.
+// Returns:
+//   True if a ring is in use.
+bool IoUringFileHandle::async() const noexcept {
+    return ring_ != nullptr;
+}
+
+// seek: Sets the logical file offset.
+// Parameters:
+//   offset: New offset value.
+//   whence: Seek mode (SEEK_SET, SEEK_CUR or SEEK_END).
+// Returns:
+//   The resulting offset, or -1 on error.
+// Pending blocks are drained first; the descriptor's own offset is kept in step so
+// the handle stays consistent with code that uses get() directly.
+off_t IoUringFileHandle::seek(off_t offset, int whence) noexcept {
+    if (!ring_) {
+        return SyscallFileHandle::seek(offset, whence);
+    }
+    if (!drain()) {
+        return -1;
+    }
+    if (whence == SEEK_CUR) {
+        offset += position_;
+        whence = SEEK_SET;
+    }
+    const off_t result = SyscallFileHandle::seek(offset, whence);
+    if (result != -1) {
+        position_ = result;
+    }
+    return result;
+}
+
+// read: Returns bytes from the read-ahead window.
+// Parameters:
+//   buffer: Destination buffer.
+//   size: Maximum number of bytes to read.
+// Returns:
+//   Number of bytes read (at most the rest of one block), 0 at end of file, or -1 on error.
+// The first read after a seek or a write starts the window at the logical position;
+// every call tops it up to queue_depth blocks before waiting for the oldest one.
+ssize_t IoUringFileHandle::read(char* buffer, size_t size) noexcept {
+    if (!ring_) {
+        return SyscallFileHandle::read(buffer, size);
+    }
+    if (mode_ == Mode::WRITING && !drain()) {
+        return -1;
+    }
+    if (mode_ != Mode::READING) {
+        mode_ = Mode::READING;
+        next_read_ = position_;
+        if (cache_mode() == CacheMode::DIRECT) {
+            next_read_ -= position_ % static_cast<off_t>(DIRECT_ALIGNMENT);
+        }
+        read_eof_ = false;
+    }
+    submit_reads();
+    if (count_ == 0 || size == 0) {
+        return 0;
+    }
+
+    Slot& slot = slots_[head_];
+    ring_->wait(slot.request);
+    if (slot.request.result < 0) {
+        drain();
+        errno = static_cast<int>(-slot.request.result);
+        return -1;
+    }
+    const size_t received = static_cast<size_t>(slot.request.result);
+    if (received < slot.size) {
+        // Blocks behind a short read lie past the end of the file.
+        read_eof_ = true;
+    }
+    // The first block of an aligned window may start before the position.
+    const size_t consumed = static_cast<size_t>(position_ - slot.offset);
+    if (consumed >= received) {
+        return 0;
+    }
+    const size_t n = std::min(size, received - consumed);
+    std::memcpy(buffer, slot.data.get() + consumed, n);
+    position_ += static_cast<off_t>(n);
+    if (consumed + n == received) {
+        release(slot.offset, received, false);
+        head_ = (head_ + 1) % slots_.size();
+        --count_;
+        if (!read_eof_) {
+            submit_reads();
+        }
+    }
+    return static_cast<ssize_t>(n);
+}
+
+// pread: Reads at an absolute offset through the read-ahead window.
+// Parameters:
+//   buffer: Destination buffer.
+//   size: Maximum number of bytes to read.
+//   offset: Absolute file offset of the first byte.
+// Returns:
+//   Number of bytes read, 0 at end of file, or -1 on error.
+// Consecutive positional reads are served from the window like read(); a read at
+// another offset restarts the window there. The descriptor's offset is not used.
+ssize_t IoUringFileHandle::pread(char* buffer, size_t size, off_t offset) noexcept {
+    if (!ring_) {
+        return SyscallFileHandle::pread(buffer, size, offset);
+    }
+    if (mode_ != Mode::READING || offset != position_) {
+        if (!drain()) {
+            return -1;
+        }
+        position_ = offset;
+    }
+    return read(buffer, size);
+}
+
+// write: Copies bytes into write blocks and submits every full block.
+// Parameters:
+//   buffer: Source buffer.
+//   size: Number of bytes to write.
+// Returns:
+//   size on success, or -1 if an earlier write failed.
+// A block is reused only after its previous write completed, so at most queue_depth
+// writes are in flight; errors surface on a later call or in flush().
+ssize_t IoUringFileHandle::write(const char* buffer, size_t size) noexcept {
+    if (!ring_) {
+        return SyscallFileHandle::write(buffer, size);
+    }
+    if (mode_ == Mode::READING) {
+        drain();
+    }
+    if (failed_) {
+        return -1;
+    }
+    mode_ = Mode::WRITING;
+    size_t copied = 0;
+    while (copied < size) {
+        if (fill_ == slots_.size()) {
+            if (count_ == slots_.size()) {
+                Slot& oldest = slots_[head_];
+                ring_->wait(oldest.request);
+                complete_write(oldest);
+                head_ = (head_ + 1) % slots_.size();
+                --count_;
+                if (failed_) {
+                    return -1;
+                }
+            }
+            fill_ = (head_ + count_) % slots_.size();
+            ++count_;
+            Slot& slot = slots_[fill_];
+            if (!allocate(slot)) {
+                --count_;
+                fill_ = slots_.size();
+                failed_ = true;
+                return -1;
+            }
+            slot.size = 0;
+            slot.offset = position_;
+        }
+        Slot& slot = slots_[fill_];
+        const size_t n = std::min(block_size_ - slot.size, size - copied);
+        std::memcpy(slot.data.get() + slot.size, buffer + copied, n);
+        slot.size += n;
+        copied += n;
+        position_ += static_cast<off_t>(n);
+        if (slot.size == block_size_) {
+            submit_fill();
+        }
+    }
+    return static_cast<ssize_t>(size);
+}
+
+// flush: Waits until every accepted write has reached the file.
+// Returns:
+//   True on success, false if a write failed.
+// In STREAM mode the written tail is then dropped from the page cache.
+bool IoUringFileHandle::flush() noexcept {
+    if (!ring_) {
+        return SyscallFileHandle::flush();
+    }
+    return drain() && SyscallFileHandle::flush();
+}
+
+// set_cache_mode: Chooses how later transfers use the page cache.
+// Parameters:
+//   mode: Cache mode.
+// Returns:
+//   True if the mode is in effect.
+// Pending blocks are drained first. DIRECT rounds the block size up to DIRECT_ALIGNMENT,
+// so full blocks written from an aligned offset stay aligned.
+bool IoUringFileHandle::set_cache_mode(CacheMode mode) noexcept {
+    if (!drain() || !SyscallFileHandle::set_cache_mode(mode)) {
+        return false;
+    }
+    if (mode == CacheMode::DIRECT && block_size_ % DIRECT_ALIGNMENT != 0) {
+        block_size_ += DIRECT_ALIGNMENT - block_size_ % DIRECT_ALIGNMENT;
+        for (auto& slot : slots_) {
+            slot.data.reset();
+        }
+    }
+    return true;
+}
+
+// allocate: Gives a slot its block buffer on first use.
+// Parameters:
+//   slot: Slot about to be submitted.
+// Returns:
+//   False if the allocation failed.
+bool IoUringFileHandle::allocate(Slot& slot) noexcept {
+    if (!slot.data) {
+        slot.data = allocate_aligned(block_size_);
+    }
+    return slot.data != nullptr;
+}
+
+// submit_reads: Tops up the read-ahead window.
+// Reads stop being issued once one came back short; a failed submission is retried
+// as a blocking pread so the window never holds an unfinished request.
+void IoUringFileHandle::submit_reads() noexcept {
+    while (count_ < slots_.size() && !read_eof_) {
+        Slot& slot = slots_[(head_ + count_) % slots_.size()];
+        slot.size = block_size_;
+        slot.offset = next_read_;
+        if (!allocate(slot)) {
+            // Queue a failed block so read() reports the error when it gets there.
+            slot.request.result = -ENOMEM;
+            slot.request.done = true;
+            read_eof_ = true;
+            ++count_;
+            return;
+        }
+        if (!ring_->submit_read(get(), slot.data.get(), block_size_, next_read_, slot.request)) {
+            slot.request.result = ::pread(get(), slot.data.get(), block_size_, next_read_);
+            if (slot.request.result < 0) {
+                slot.request.result = -errno;
+            }
+            slot.request.done = true;
+        }
+        next_read_ += static_cast<off_t>(block_size_);
+        ++count_;
+    }
+}
+
+// submit_fill: Submits the partially filled write block, if any.
+void IoUringFileHandle::submit_fill() noexcept {
+    if (fill_ == slots_.size()) {
+        return;
+    }
+    Slot& slot = slots_[fill_];
+    fill_ = slots_.size();
+    const bool aligned = slot.offset % static_cast<off_t>(DIRECT_ALIGNMENT) == 0 && slot.size % DIRECT_ALIGNMENT == 0;
+    if ((cache_mode() == CacheMode::DIRECT && !aligned) ||
+        !ring_->submit_write(get(), slot.data.get(), slot.size, slot.offset, slot.request)) {
+        // Written synchronously by complete_write().
+        slot.request.result = 0;
+        slot.request.done = true;
+    }
+}
+
+// complete_write: Checks a finished write, completing short writes synchronously.
+// Parameters:
+//   slot: Block whose request is done.
+void IoUringFileHandle::complete_write(Slot& slot) noexcept {
+    if (slot.request.result < 0) {
+        failed_ = true;
+        return;
+    }
+    // O_DIRECT cannot write an unaligned remainder, so it goes through the page cache.
+    const size_t written = static_cast<size_t>(slot.request.result);
+    if (written < slot.size && !pwrite_cached(slot.data.get() + written, slot.size - written,
+                                              slot.offset + static_cast<off_t>(written))) {
+        failed_ = true;
+        return;
+    }
+    release(slot.offset, slot.size, true);
+}
+
+// drain: Waits for every block in flight and discards read-ahead.
+// Returns:
+//   False if a write failed.
+bool IoUringFileHandle::drain() noexcept {
+    if (!ring_) {
+        return !failed_;
+    }
+    submit_fill();
+    while (count_ > 0) {
+        Slot& slot = slots_[head_];
+        ring_->wait(slot.request);
+        if (mode_ == Mode::WRITING) {
+            complete_write(slot);
+        }
+        head_ = (head_ + 1) % slots_.size();
+        --count_;
+    }
+    head_ = 0;
+    mode_ = Mode::IDLE;
+    return !failed_;
+}
@@ -1,64 +1,459 @@
 // main.cpp: Entry point for the word counter program.
 // This file validates command-line arguments, initializes components,
-// and orchestrates the workflow to count unique words in a large file.
+// and orchestrates the workflow to count unique words in a large file: an in-memory
+// pass first, falling back to external sorting only if the vocabulary outgrows RAM.
 
+#include "approx_counter.hpp"
 #include "chunk_coordinator.hpp"
 #include "file_handle.hpp"
+#include "in_memory_counter.hpp"
+#include "incremental_counter.hpp"
+#include "input_files.hpp"
 #include "parser.hpp"
+#include "stats_report.hpp"
 #include "word_counter.hpp"
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstdlib>
+#include <functional>
 #include <memory>
+#include <sys/resource.h>
 #include <sys/stat.h>
 #include <string.h>
 #include <unistd.h>
 
+namespace {
+
+// Size suffixes, each 1024 times the previous one.
+constexpr char SIZE_SUFFIXES[] = "KMG";
+
+// parse_size: Parses a byte count with an optional K, M or G suffix (powers of 1024).
+// Parameters:
+//   text: Argument text, e.g. "512M".
+//   bytes: Receives the byte count.
+// Returns: True if the text is a positive size.
+bool parse_size(const char* text, size_t& bytes) noexcept {
+    char* end = nullptr;
+    unsigned long long value = strtoull(text, &end, 10);
+    if (end == text || value == 0) {
+        return false;
+    }
+    unsigned shift = 0;
+    const char* suffix = strchr(SIZE_SUFFIXES, toupper(static_cast<unsigned char>(*end)));
+    if (*end != '\0' && suffix != nullptr) {
+        shift = 10 * static_cast<unsigned>(suffix - SIZE_SUFFIXES + 1);
+        ++end;
+    }
+    if (*end != '\0' || value > (~0ULL >> shift)) {
+        return false;
+    }
+    bytes = static_cast<size_t>(value << shift);
+    return true;
+}
+
+// parse_count: Parses a positive decimal count.
+// Parameters:
+//   text: Argument text.
+//   count: Receives the count.
+// Returns: True if the text is a positive integer.
+bool parse_count(const char* text, size_t& count) noexcept {
+    char* end = nullptr;
+    unsigned long long value = strtoull(text, &end, 10);
+    if (end == text || *end != '\0' || value == 0) {
+        return false;
+    }
+    count = static_cast<size_t>(value);
+    return true;
+}
+
+// parse_cache_mode: Parses a --page-cache argument.
+// Parameters:
+//   text: Argument text: buffered, stream or direct.
+//   mode: Receives the cache mode.
+// Returns: True if the text names a mode.
+bool parse_cache_mode(const char* text, CacheMode& mode) noexcept {
+    if (strcmp(text, "buffered") == 0) {
+        mode = CacheMode::BUFFERED;
+    } else if (strcmp(text, "stream") == 0) {
+        mode = CacheMode::STREAM;
+    } else if (strcmp(text, "direct") == 0) {
+        mode = CacheMode::DIRECT;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+// open_input: Opens a handle on one input; "-" is standard input.
+// Every opened handle has its own open file description, so each one is switched to a
+// cache mode separately.
+std::unique_ptr<FileHandle> open_input(const char* filename) noexcept {
+    if (strcmp(filename, "-") == 0) {
+        return std::make_unique<SyscallFileHandle>(::dup(STDIN_FILENO));
+    }
+    return std::make_unique<SyscallFileHandle>(filename, O_RDONLY);
+}
+
+// raise_descriptor_limit: Raises the soft descriptor limit to the hard limit, so
+// thousands of input shards can be open at once next to the merge's runs.
+void raise_descriptor_limit() noexcept {
+    struct rlimit limit;
+    if (getrlimit(RLIMIT_NOFILE, &limit) == 0 && limit.rlim_cur < limit.rlim_max) {
+        limit.rlim_cur = limit.rlim_max;
+        setrlimit(RLIMIT_NOFILE, &limit);
+    }
+}
+
+// Bytes of output collected before each write().
+constexpr size_t OUTPUT_BUFFER_SIZE = 1ULL << 20;
+
+// write_output: Writes all of a buffer to stdout and empties it.
+void write_output(std::string& out) noexcept {
+    size_t offset = 0;
+    while (offset < out.size()) {
+        ssize_t res = write(STDOUT_FILENO, out.data() + offset, out.size() - offset);
+        if (res <= 0) {
+            break;
+        }
+        offset += static_cast<size_t>(res);
+    }
+    out.clear();
+}
+
+// print_usage: Writes the command-line synopsis to stderr.
+void print_usage(const char* program) noexcept {
+    ssize_t res = write(STDERR_FILENO, "Usage: ", 7);
+    res = write(STDERR_FILENO, program, strlen(program));
+    res = write(STDERR_FILENO, " [--approx | --frequencies | --top K] [--memory-limit SIZE[K|M|G]] [--stats]\n", 77);
+    res = write(STDERR_FILENO, "       [--page-cache buffered|stream|direct] [--manifest FILE] [--dictionary PATH]\n", 83);
+    res = write(STDERR_FILENO, "       <filename | pattern | ->...\n", 35);
+    (void)res;
+}
+
+} // namespace
+
 // Main function: Validates input, sets up components, and executes the word-counting process.
 // Parameters:
 //   argc: Number of command-line arguments.
-//   argv: Array of command-line argument strings (expects argv[1] as input file name).
+//   argv: Array of command-line argument strings (options, then the input file names).
 // Returns:
 //   0 on success, 1 on error (invalid arguments, file access issues).
+// --memory-limit bounds the process's working memory: the in-memory pass spills at
+// half of it, the external chunks are sized to fit it, and the merge buffers share it.
+// --approx replaces the exact count with a HyperLogLog estimate and its error bound.
+// --frequencies prints every word with its count, in word order, and --top K prints
+// the K most frequent words; both may be combined (frequencies first).
+// --page-cache stream reads ahead and drops input and run data from the page cache
+// once used; direct bypasses the cache with O_DIRECT (buffered is the default).
+// A file name of "-" reads standard input. Inputs that are not regular files (pipes,
+// FIFOs, terminals) are read sequentially in word-aligned chunks: no stat() size, no
+// seeking, and the external pipeline from the start instead of the in-memory pass.
+// Several file names, glob patterns (expanded in sorted order) and --manifest files
+// listing one name or pattern per line are counted as one input with one result.
+// --dictionary keeps the sorted distinct words of an append-only file in PATH, so later
+// counts parse only the bytes appended since (exact mode, one regular file only).
+// --stats writes one JSON object to stderr after the result: per-phase wall and CPU
+// time, bytes read and written, words parsed, pipeline stage counters, run sizes, merge
+// passes, peak RSS and per-thread utilization.
 int main(int argc, char* argv[]) {
-    // Validate command-line arguments: expect exactly one input file name.
-    if (argc != 2) {
-        ssize_t res = write(STDERR_FILENO, "Usage: ", 7);
-        res = write(STDERR_FILENO, argv[0], strlen(argv[0]));
-        res = write(STDERR_FILENO, " <filename>\n", 12);
-        (void)res;
+    // Validate command-line arguments: options followed by at least one input file name.
+    std::vector<const char*> manifests;
+    const char* dictionary = nullptr;
+    size_t memory_limit = 0;
+    size_t top_k = 0;
+    bool approx = false;
+    bool frequencies = false;
+    bool collect_stats = false;
+    CacheMode cache_mode = CacheMode::BUFFERED;
+    int arg = 1;
+    while (arg < argc && strncmp(argv[arg], "--", 2) == 0) {
+        if (strcmp(argv[arg], "--approx") == 0) {
+            approx = true;
+            ++arg;
+        } else if (strcmp(argv[arg], "--frequencies") == 0) {
+            frequencies = true;
+            ++arg;
+        } else if (strcmp(argv[arg], "--stats") == 0) {
+            collect_stats = true;
+            ++arg;
+        } else if (strcmp(argv[arg], "--top") == 0 && arg + 1 < argc && parse_count(argv[arg + 1], top_k)) {
+            arg += 2;
+        } else if (strcmp(argv[arg], "--memory-limit") == 0 && arg + 1 < argc && parse_size(argv[arg + 1], memory_limit)) {
+            arg += 2;
+        } else if (strcmp(argv[arg], "--page-cache") == 0 && arg + 1 < argc && parse_cache_mode(argv[arg + 1], cache_mode)) {
+            arg += 2;
+        } else if (strcmp(argv[arg], "--manifest") == 0 && arg + 1 < argc) {
+            manifests.push_back(argv[arg + 1]);
+            arg += 2;
+        } else if (strcmp(argv[arg], "--dictionary") == 0 && arg + 1 < argc) {
+            dictionary = argv[arg + 1];
+            arg += 2;
+        } else {
+            print_usage(argv[0]);
+            return 1;
+        }
+    }
+    const bool frequency_mode = frequencies || top_k != 0;
+    if ((argc == arg && manifests.empty()) || (approx && frequency_mode) ||
+        (dictionary != nullptr && (approx || frequency_mode))) {
+        print_usage(argv[0]);
         return 1;
     }
 
-    // Check if the input file exists and is accessible using stat.
-    struct stat st;
-    if (stat(argv[1], &st) == -1) {
-        ssize_t res = write(STDERR_FILENO, "Error: Could not stat file\n", 27);
-        (void)res;
+    // Expand manifests and patterns into the list of input files.
+    std::vector<std::string> names;
+    for (const char* manifest : manifests) {
+        if (!read_manifest(manifest, names)) {
+            ssize_t res = write(STDERR_FILENO, "Error: Could not read manifest\n", 31);
+            (void)res;
+            return 1;
+        }
+    }
+    for (; arg < argc; ++arg) {
+        if (!expand_input_name(argv[arg], names)) {
+            ssize_t res = write(STDERR_FILENO, "Error: No files match pattern\n", 30);
+            (void)res;
+            return 1;
+        }
+    }
+    if (names.empty() || (dictionary != nullptr && names.size() != 1)) {
+        print_usage(argv[0]);
         return 1;
     }
+    raise_descriptor_limit();
 
-    // Open the input file using SyscallFileHandle.
-    auto input_file = std::make_unique<SyscallFileHandle>(argv[1], O_RDONLY);
-    if (!input_file->is_open()) {
-        ssize_t res = write(STDERR_FILENO, "Error: Could not open input file\n", 32);
+    // Phases are timed in every run; the report is only printed with --stats.
+    StatsReport stats;
+    auto print_stats = [&]() {
+        if (collect_stats) {
+            stats.end_phase();
+            std::string json = stats.to_json(ThreadPool::shared().stats());
+            ssize_t res = write(STDERR_FILENO, json.c_str(), json.size());
+            (void)res;
+        }
+    };
+
+    // Check if the input files exist and are accessible using stat.
+    std::vector<size_t> sizes;
+    bool streaming = false;
+    for (const auto& name : names) {
+        struct stat st;
+        if ((name == "-" ? fstat(STDIN_FILENO, &st) : stat(name.c_str(), &st)) == -1) {
+            ssize_t res = write(STDERR_FILENO, "Error: Could not stat file\n", 27);
+            (void)res;
+            return 1;
+        }
+        // Pipes have no size and cannot be mapped or read at offsets, nor use the page cache modes.
+        if (!S_ISREG(st.st_mode)) {
+            if (names.size() > 1) {
+                ssize_t res = write(STDERR_FILENO, "Error: Only a single input may be a pipe\n", 41);
+                (void)res;
+                return 1;
+            }
+            if (dictionary != nullptr) {
+                ssize_t res = write(STDERR_FILENO, "Error: A dictionary needs a regular input file\n", 47);
+                (void)res;
+                return 1;
+            }
+            streaming = true;
+            cache_mode = CacheMode::BUFFERED;
+        }
+        sizes.push_back(streaming ? 0 : static_cast<size_t>(st.st_size));
+    }
+
+    // Open the input files using SyscallFileHandle.
+    std::vector<InputFile> inputs;
+    bool cache_supported = true;
+    for (size_t i = 0; i < names.size(); ++i) {
+        inputs.push_back({open_input(names[i].c_str()), sizes[i]});
+        if (!inputs.back().file->is_open()) {
+            ssize_t res = write(STDERR_FILENO, "Error: Could not open input file\n", 32);
+            (void)res;
+            return 1;
+        }
+        cache_supported = cache_supported && inputs.back().file->set_cache_mode(cache_mode);
+    }
+    if (!cache_supported) {
+        ssize_t res = write(STDERR_FILENO, "Warning: Page cache mode not supported, using buffered I/O\n", 59);
         (void)res;
-        return 1;
+        cache_mode = CacheMode::BUFFERED;
+        for (auto& input : inputs) {
+            input.file->set_cache_mode(cache_mode);
+        }
     }
 
-    // Initialize the parser for space-separated words.
-    auto parser = std::make_unique<SpaceSeparatedParser>();
+    // Approximate mode: one streaming pass into HyperLogLog sketches, no temporary files.
+    if (approx) {
+        StatsReport::Phase& phase = stats.begin_phase("approx");
+        for (const auto& input : inputs) {
+            phase.bytes_read += input.size;
+        }
+        ApproxCounter approx_counter(std::move(inputs));
+        HyperLogLog sketch = streaming ? approx_counter.count_stream() : approx_counter.count();
+        stats.end_phase();
+        const double estimate = sketch.estimate();
+        // Two standard errors: the true count lies within the bound about 95% of the time.
+        const double bound = 2.0 * sketch.standard_error() * estimate;
+        std::string estimate_str = std::to_string(std::llround(estimate)) + " +/- " +
+                                   std::to_string(std::llround(std::ceil(bound))) + " (approx, 95%)\n";
+        ssize_t res = write(STDOUT_FILENO, estimate_str.c_str(), estimate_str.size());
+        (void)res;
+        print_stats();
+        return 0;
+    }
 
-    // Coordinate chunk processing: splits file into chunks and processes them in parallel.
-    ChunkCoordinator coordinator(std::move(input_file), std::move(parser), st.st_size);
-    auto temp_files = coordinator.process_chunks();
+    // Frequency mode: chunks spill (word, count) runs and the merge totals every word.
+    if (frequency_mode) {
+        std::vector<TempFile> temp_files;
+        stats.begin_phase("chunks");
+        {
+            // The inputs are closed before the merge, which budgets every free descriptor for runs.
+            ChunkPipeline::Options pipeline_options;
+            pipeline_options.word_counts = true;
+            ChunkCoordinator coordinator(std::move(inputs), std::make_unique<SpaceSeparatedParser>(),
+                                         ChunkCoordinator::DEFAULT_CHUNK_SIZE, pipeline_options);
+            coordinator.set_memory_limit(memory_limit);
+            const bool processed =
+                streaming ? coordinator.process_stream(temp_files) : coordinator.process_chunks(temp_files);
+            if (!processed) {
+                return 1;
+            }
+            stats.add_pipeline(coordinator.stage_stats(), coordinator.planning_time());
+        }
+        stats.add_runs(temp_files);
+        StatsReport::Phase& merge_phase = stats.begin_phase("merge");
 
-    // Count unique words by merging sorted temporary files.
-    auto word_counter_file = std::make_unique<SyscallFileHandle>(argv[1], O_RDONLY);
-    WordCounter counter(std::move(word_counter_file));
-    size_t unique_count = counter.count_unique_words(temp_files);
+        WordCounter::Options options;
+        options.buffer_memory = memory_limit;
+        options.cache_mode = cache_mode;
+        WordCounter counter(nullptr, options);
+        std::string out;
+        std::function<void(std::string_view, uint64_t)> print_word;
+        if (frequencies) {
+            print_word = [&out](std::string_view word, uint64_t count) {
+                out.append(word.data(), word.size());
+                out += ' ';
+                out += std::to_string(count);
+                out += '\n';
+                if (out.size() >= OUTPUT_BUFFER_SIZE) {
+                    write_output(out);
+                }
+            };
+        }
+        WordCounter::FrequencyReport report = counter.count_frequencies(temp_files, top_k, print_word);
+        merge_phase.words = report.total_words;
+        stats.set_merge(counter.merge_stats());
+        for (const auto& entry : report.top) {
+            out += entry.word + " " + std::to_string(entry.count) + "\n";
+        }
+        write_output(out);
+        print_stats();
+        return 0;
+    }
+
+    // Streams cannot be reread after an in-memory pass, so they go straight to the external pipeline.
+    if (streaming) {
+        std::vector<TempFile> temp_files;
+        stats.begin_phase("chunks");
+        {
+            ChunkCoordinator coordinator(std::move(inputs), std::make_unique<SpaceSeparatedParser>());
+            coordinator.set_memory_limit(memory_limit);
+            if (!coordinator.process_stream(temp_files)) {
+                return 1;
+            }
+            stats.add_pipeline(coordinator.stage_stats(), coordinator.planning_time());
+        }
+        stats.add_runs(temp_files);
+        stats.begin_phase("merge");
+        WordCounter::Options options;
+        options.buffer_memory = memory_limit;
+        WordCounter counter(nullptr, options);
+        std::string count_str = std::to_string(counter.count_unique_words(temp_files)) + "\n";
+        stats.set_merge(counter.merge_stats());
+        ssize_t res = write(STDOUT_FILENO, count_str.c_str(), count_str.size());
+        (void)res;
+        print_stats();
+        return 0;
+    }
+
+    // Incremental mode: merge the appended bytes into the persisted dictionary.
+    if (dictionary != nullptr) {
+        WordCounter::Options options;
+        options.buffer_memory = memory_limit;
+        options.cache_mode = cache_mode;
+        StatsReport::Phase& phase = stats.begin_phase("incremental");
+        const size_t file_size = inputs.front().size;
+        IncrementalCounter incremental(std::move(inputs.front().file), file_size, dictionary, options, memory_limit);
+        if (!incremental.count()) {
+            return 1;
+        }
+        phase.bytes_read = file_size - static_cast<size_t>(incremental.resume_offset());
+        std::string count_str = std::to_string(incremental.unique_count()) + "\n";
+        ssize_t res = write(STDOUT_FILENO, count_str.c_str(), count_str.size());
+        (void)res;
+        print_stats();
+        return 0;
+    }
+
+    // Fast path: count exactly in memory while the distinct words fit.
+    size_t memory_threshold = InMemoryCounter::default_memory_threshold();
+    if (memory_limit != 0) {
+        memory_threshold = std::min(memory_threshold, memory_limit / 2);
+    }
+    InMemoryCounter in_memory(std::move(inputs), memory_threshold);
+    size_t unique_count;
+    StatsReport::Phase& in_memory_phase = stats.begin_phase("in_memory");
+    const bool counted = in_memory.count();
+    in_memory_phase.bytes_read = in_memory.bytes_scanned();
+    in_memory_phase.words = in_memory.words_scanned();
+    if (counted) {
+        unique_count = in_memory.unique_count();
+    } else {
+        // Spill what was counted as one sorted run and externally sort the remainder.
+        std::vector<TempFile> temp_files;
+        StatsReport::Phase& spill_phase = stats.begin_phase("spill");
+        temp_files.emplace_back();
+        if (!in_memory.spill(temp_files.back())) {
+            return 1;
+        }
+        stats.add_runs(temp_files);
+        spill_phase.bytes_written = stats.runs().total_bytes;
+
+        // Initialize the parser for space-separated words.
+        auto parser = std::make_unique<SpaceSeparatedParser>();
+
+        // Coordinate chunk processing: splits the rest of the inputs into chunks and processes them in parallel.
+        stats.begin_phase("chunks");
+        {
+            ChunkCoordinator coordinator(in_memory.release_inputs(), std::move(parser));
+            coordinator.set_memory_limit(memory_limit);
+            std::vector<TempFile> chunk_files;
+            if (!coordinator.process_chunks(chunk_files, in_memory.resume_offset(), in_memory.resume_input())) {
+                return 1;
+            }
+            stats.add_pipeline(coordinator.stage_stats(), coordinator.planning_time());
+            stats.add_runs(chunk_files);
+            for (auto& temp_file : chunk_files) {
+                temp_files.push_back(std::move(temp_file));
+            }
+        }
+
+        // Count unique words by merging sorted temporary files.
+        WordCounter::Options options;
+        options.buffer_memory = memory_limit;
+        options.cache_mode = cache_mode;
+        stats.begin_phase("merge");
+        WordCounter counter(nullptr, options);
+        unique_count = counter.count_unique_words(temp_files);
+        stats.set_merge(counter.merge_stats());
+    }
 
     // Output the count of unique words to stdout.
     std::string count_str = std::to_string(unique_count) + "\n";
     ssize_t res = write(STDOUT_FILENO, count_str.c_str(), count_str.size());
     (void)res;
+    print_stats();
 
     return 0;
 }
@@ -1,31 +1,209 @@
 // parser.cpp: Implementation of SpaceSeparatedParser for parsing input into words.
 // This file processes input buffers, splitting them into space-separated words.
+// Space positions are found 64 bytes at a time with the widest SIMD unit the CPU
+// supports (SSE2, AVX2 or AVX-512), selected once, on first use.
 
 #include "parser.hpp"
+#include <cstdint>
 
-// parse: Splits a buffer into words based on spaces and stores them in a vector.
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define WORD_COUNTER_X86_SIMD 1
+#include <immintrin.h>
+#endif
+
+namespace {
+
+// SpaceMaskFn: Returns a bitmask with bit i set when block[i] is a space, for 64 bytes.
+using SpaceMaskFn = uint64_t (*)(const char* block) noexcept;
+
+#ifdef WORD_COUNTER_X86_SIMD
+// space_mask_sse2: Four 16-byte compares; SSE2 is always present on x86-64.
+uint64_t space_mask_sse2(const char* block) noexcept {
+    const __m128i spaces = _mm_set1_epi8(' ');
+    uint64_t mask = 0;
+    for (unsigned i = 0; i < 4; ++i) {
+        __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(block + 16 * i));
+        uint32_t bits = static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(bytes, spaces)));
+        mask |= static_cast<uint64_t>(bits) << (16 * i);
+    }
+    return mask;
+}
+
+// space_mask_avx2: Two 32-byte compares.
+__attribute__((target("avx2")))
+uint64_t space_mask_avx2(const char* block) noexcept {
+    const __m256i spaces = _mm256_set1_epi8(' ');
+    __m256i low = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(block));
+    __m256i high = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(block + 32));
+    uint32_t low_bits = static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(low, spaces)));
+    uint32_t high_bits = static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(high, spaces)));
+    return static_cast<uint64_t>(low_bits) | (static_cast<uint64_t>(high_bits) << 32);
+}
+
+// space_mask_avx512: One 64-byte compare straight into a mask register.
+__attribute__((target("avx512f,avx512bw")))
+uint64_t space_mask_avx512(const char* block) noexcept {
+    __m512i bytes = _mm512_loadu_si512(block);
+    return _mm512_cmpeq_epi8_mask(bytes, _mm512_set1_epi8(' '));
+}
+#else
+// space_mask_scalar: Portable fallback for CPUs without a supported SIMD unit.
+uint64_t space_mask_scalar(const char* block) noexcept {
+    uint64_t mask = 0;
+    for (unsigned i = 0; i < 64; ++i) {
+        mask |= static_cast<uint64_t>(block[i] == ' ') << i;
+    }
+    return mask;
+}
+#endif
+
+// ScannerChoice: Kernel picked for this CPU together with its name for diagnostics.
+struct ScannerChoice {
+    SpaceMaskFn mask;
+    const char* name;
+};
+
+// select_scanner: Queries cpuid once and returns the widest supported kernel.
+ScannerChoice select_scanner() noexcept {
+#ifdef WORD_COUNTER_X86_SIMD
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512bw")) {
+        return {space_mask_avx512, "avx512"};
+    }
+    if (__builtin_cpu_supports("avx2")) {
+        return {space_mask_avx2, "avx2"};
+    }
+    return {space_mask_sse2, "sse2"};
+#else
+    return {space_mask_scalar, "scalar"};
+#endif
+}
+
+// scanner: Kernel selected on first use, shared by all parser instances and threads.
+// Returns:
+//   The selection, made once; a function-local static so parsers used during the static
+//   initialization of another translation unit never see it unset.
+const ScannerChoice& scanner() noexcept {
+    static const ScannerChoice choice = select_scanner();
+    return choice;
+}
+
+// scan_words: Calls emit(start, length) for every space-separated word in a buffer.
 // Parameters:
 //   buffer: Input buffer containing lowercase letters and spaces.
 //   size: Size of the buffer.
-//   words: Output vector to store parsed words.
-// Assumes input is valid (lowercase 'a' to 'z', spaces) per project requirements.
-void SpaceSeparatedParser::parse(const char* buffer, size_t size, std::vector<std::string>& words) noexcept {
-    std::string current_word;
-    // Iterate through each character in the buffer.
-    for (size_t i = 0; i < size; ++i) {
+//   emit: Callback receiving each word's start pointer and length, in order.
+// Each 64-byte block is turned into a space bitmask; word starts (letter after a space)
+// and word ends (space after a letter) are then read off the mask with bit tricks, so
+// words are emitted as whole spans instead of being built one character at a time.
+template <typename Emit>
+void scan_words(const char* buffer, size_t size, Emit&& emit) noexcept {
+    size_t word_start = 0;
+    bool in_word = false;
+    size_t i = 0;
+    const SpaceMaskFn mask = scanner().mask;
+
+    for (; i + 64 <= size; i += 64) {
+        const uint64_t letters = ~mask(buffer + i);
+        // Bit j of previous is set when byte i + j - 1 is a letter.
+        const uint64_t previous = (letters << 1) | static_cast<uint64_t>(in_word);
+        const uint64_t starts = letters & ~previous;
+        uint64_t events = starts | (~letters & previous);
+        while (events != 0) {
+            const unsigned bit = static_cast<unsigned>(__builtin_ctzll(events));
+            if ((starts >> bit) & 1) {
+                word_start = i + bit;
+            } else {
+                emit(buffer + word_start, i + bit - word_start);
+            }
+            events &= events - 1;
+        }
+        in_word = (letters >> 63) != 0;
+    }
+
+    // Scalar tail for the last partial block.
+    for (; i < size; ++i) {
         if (buffer[i] == ' ') {
-            // End of a word: add to vector if non-empty.
-            if (!current_word.empty()) {
-                words.push_back(std::move(current_word));
-                current_word.clear();
+            if (in_word) {
+                emit(buffer + word_start, i - word_start);
+                in_word = false;
             }
-        } else {
-            // Append non-space character to current word.
-            current_word += buffer[i];
+        } else if (!in_word) {
+            word_start = i;
+            in_word = true;
         }
     }
-    // Add the last word if non-empty.
-    if (!current_word.empty()) {
-        words.push_back(std::move(current_word));
+    // Emit the last word if non-empty.
+    if (in_word) {
+        emit(buffer + word_start, size - word_start);
     }
 }
+
+} // namespace
+
+// parse: Splits a buffer into words based on spaces and stores them in a vector.
+// Parameters:
+//   buffer: Input buffer containing lowercase letters and spaces.
+//   size: Size of the buffer.
+//   words: Output vector to store parsed words.
+// Assumes input is valid (lowercase 'a' to 'z', spaces) per project requirements.
+void SpaceSeparatedParser::parse(const char* buffer, size_t size, std::vector<std::string>& words) noexcept {
+    scan_words(buffer, size, [&words](const char* start, size_t length) {
+        words.emplace_back(start, length);
+    });
+}
+
+// parse: Splits a buffer into views of space-separated words.
+// Parameters:
+//   buffer: Input buffer containing lowercase letters and spaces; must outlive the views.
+//   size: Size of the buffer.
+//   words: Output vector to store views of parsed words.
+// Stores 16-byte views instead of std::string objects, so no word is copied or allocated.
+void SpaceSeparatedParser::parse(const char* buffer, size_t size, std::vector<std::string_view>& words) noexcept {
+    scan_words(buffer, size, [&words](const char* start, size_t length) {
+        words.emplace_back(start, length);
+    });
+}
+
+// parse: Inserts views of space-separated words into a set.
+// Parameters:
+//   buffer: Input buffer containing lowercase letters and spaces; must outlive the views.
+//   size: Size of the buffer.
+//   words: Set receiving the distinct words.
+// Returns:
+//   Number of words parsed, duplicates included.
+// Deduplicating during the scan keeps memory proportional to the distinct words; a
+// chunk's occurrences are never held at once.
+size_t SpaceSeparatedParser::parse(const char* buffer, size_t size,
+                                   std::unordered_set<std::string_view>& words) noexcept {
+    size_t parsed = 0;
+    scan_words(buffer, size, [&words, &parsed](const char* start, size_t length) {
+        words.emplace(start, length);
+        ++parsed;
+    });
+    return parsed;
+}
+
+// parse: Counts the occurrences of space-separated words.
+// Parameters:
+//   buffer: Input buffer containing lowercase letters and spaces; must outlive the views.
+//   size: Size of the buffer.
+//   counts: Occurrences of every distinct word, added to.
+// Returns:
+//   Number of words parsed, duplicates included.
+size_t SpaceSeparatedParser::parse(const char* buffer, size_t size,
+                                   std::unordered_map<std::string_view, uint64_t>& counts) noexcept {
+    size_t parsed = 0;
+    scan_words(buffer, size, [&counts, &parsed](const char* start, size_t length) {
+        ++counts[std::string_view(start, length)];
+        ++parsed;
+    });
+    return parsed;
+}
+
+// scanner_name: Reports which delimiter scanning kernel is selected.
+// Returns:
+//   "avx512", "avx2", "sse2" or "scalar".
+const char* SpaceSeparatedParser::scanner_name() noexcept {
+    return scanner().name;
+}
@@ -0,0 +1,124 @@
+// run_format.cpp: Implementation of the run file header and block index helpers.
+// This file validates run headers and decodes the index written after the last block.
+
+#include "run_format.hpp"
+#include <cstring>
+#include <memory>
+
+namespace run_format {
+
+namespace {
+
+// read_exact: Reads size bytes at offset, retrying short reads.
+bool read_exact(FileHandle& run, off_t offset, char* out, size_t size) noexcept {
+    size_t done = 0;
+    while (done < size) {
+        ssize_t bytes_read = run.pread(out + done, size - done, offset + static_cast<off_t>(done));
+        if (bytes_read <= 0) {
+            return false;
+        }
+        done += static_cast<size_t>(bytes_read);
+    }
+    return true;
+}
+
+} // namespace
+
+// write_file_header: Fills in the file header of the current version.
+// Parameters:
+//   out: Destination with room for FILE_HEADER_SIZE bytes.
+//   flags: Layout flags of the run.
+void write_file_header(char* out, uint8_t flags) noexcept {
+    std::memcpy(out, FILE_MAGIC, sizeof(FILE_MAGIC));
+    out[4] = static_cast<char>(VERSION);
+    out[5] = static_cast<char>(flags);
+    out[6] = out[7] = 0;
+}
+
+// check_file_header: Validates a file header.
+// Parameters:
+//   header: FILE_HEADER_SIZE bytes read from the start of a run.
+// Returns:
+//   True if the magic matches, the version is supported and no unknown flag is set.
+bool check_file_header(const char* header) noexcept {
+    return std::memcmp(header, FILE_MAGIC, sizeof(FILE_MAGIC)) == 0 && static_cast<uint8_t>(header[4]) == VERSION &&
+           (file_flags(header) & ~FLAG_COUNTS) == 0;
+}
+
+// read_run_index: Loads the block index of a finished run.
+// Parameters:
+//   run: Handle to the run.
+//   index: Receives the index.
+// Returns:
+//   True on success, false if the run is empty, unfinished or corrupt.
+// Reads the trailer at the end of the file, then decodes the index it points to.
+bool read_run_index(FileHandle& run, RunIndex& index) noexcept {
+    index.blocks.clear();
+    index.data_end = 0;
+    index.footer_offset = 0;
+    index.flags = 0;
+    const off_t size = run.seek(0, SEEK_END);
+    if (size < static_cast<off_t>(FILE_HEADER_SIZE + BLOCK_HEADER_SIZE + TRAILER_SIZE)) {
+        return false;
+    }
+
+    char header[FILE_HEADER_SIZE];
+    char trailer[TRAILER_SIZE];
+    if (!read_exact(run, 0, header, sizeof(header)) || !check_file_header(header) ||
+        !read_exact(run, size - static_cast<off_t>(TRAILER_SIZE), trailer, sizeof(trailer)) ||
+        std::memcmp(trailer + 8, INDEX_MAGIC, sizeof(INDEX_MAGIC)) != 0) {
+        return false;
+    }
+    const uint64_t index_offset = get_u64(trailer);
+    const uint64_t index_end = static_cast<uint64_t>(size) - TRAILER_SIZE;
+    if (index_offset < FILE_HEADER_SIZE + BLOCK_HEADER_SIZE || index_offset > index_end) {
+        return false;
+    }
+
+    const size_t index_size = static_cast<size_t>(index_end - index_offset);
+    std::unique_ptr<char[]> bytes(new char[index_size + 1]);
+    if (!read_exact(run, static_cast<off_t>(index_offset), bytes.get(), index_size)) {
+        return false;
+    }
+    const char* in = bytes.get();
+    const char* end = in + index_size;
+    uint64_t count;
+    if ((in = get_varint(in, end, count)) == nullptr || count > index_size) {
+        return false;
+    }
+    index.blocks.reserve(static_cast<size_t>(count));
+    for (uint64_t i = 0; i < count; ++i) {
+        uint64_t offset;
+        uint64_t length;
+        if ((in = get_varint(in, end, offset)) == nullptr || (in = get_varint(in, end, length)) == nullptr ||
+            length > static_cast<uint64_t>(end - in)) {
+            index.blocks.clear();
+            return false;
+        }
+        index.blocks.push_back({static_cast<off_t>(offset), std::string(in, static_cast<size_t>(length))});
+        in += length;
+    }
+    index.data_end = static_cast<off_t>(index_offset - BLOCK_HEADER_SIZE);
+    index.footer_offset = static_cast<off_t>(index_offset + static_cast<uint64_t>(in - bytes.get()));
+    index.flags = file_flags(header);
+    return true;
+}
+
+// read_run_footer: Loads the footer of a finished run.
+// Parameters:
+//   run: Handle to the run.
+//   index: Index loaded by read_run_index().
+//   footer: Receives the footer bytes.
+// Returns:
+//   True on success, false on a read error.
+bool read_run_footer(FileHandle& run, const RunIndex& index, std::string& footer) noexcept {
+    const off_t size = run.seek(0, SEEK_END);
+    const off_t footer_end = size - static_cast<off_t>(TRAILER_SIZE);
+    if (size < 0 || footer_end < index.footer_offset) {
+        return false;
+    }
+    footer.resize(static_cast<size_t>(footer_end - index.footer_offset));
+    return read_exact(run, index.footer_offset, &footer[0], footer.size());
+}
+
+} // namespace run_format
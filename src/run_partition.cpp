@@ -0,0 +1,78 @@
+// run_partition.cpp: Implementation of key-range partitioning over sorted runs.
+// This file picks splitters from block first words and binary-searches block indexes.
+
+#include "run_partition.hpp"
+#include <algorithm>
+
+namespace {
+
+// first_block_at_least: Index of the first block whose first word is >= key.
+size_t first_block_at_least(const run_format::RunIndex& index, std::string_view key) noexcept {
+    auto it = std::lower_bound(index.blocks.begin(), index.blocks.end(), key,
+                               [](const run_format::RunBlock& block, std::string_view value) {
+                                   return std::string_view(block.first_word) < value;
+                               });
+    return static_cast<size_t>(it - index.blocks.begin());
+}
+
+} // namespace
+
+// slice_begin: Finds where the words not less than a key start in a run.
+// Parameters:
+//   index: Block index of the run.
+//   key: Lower bound of the key range.
+// Returns:
+//   Offset of the block that may hold the first word >= key, or the data end.
+// Words >= key can sit at the tail of the block before the first block starting at
+// or above key, unless that block starts exactly at key. The slice therefore starts
+// one block early, and the merge skips the words below key.
+off_t slice_begin(const run_format::RunIndex& index, std::string_view key) noexcept {
+    size_t block = first_block_at_least(index, key);
+    if (block > 0 && (block == index.blocks.size() || index.blocks[block].first_word != key)) {
+        --block;
+    }
+    return block < index.blocks.size() ? index.blocks[block].offset : index.data_end;
+}
+
+// slice_end: Finds where the words less than a key end in a run.
+// Parameters:
+//   index: Block index of the run.
+//   key: Upper bound (exclusive) of the key range.
+// Returns:
+//   Offset of the first block whose first word is >= key, or the data end.
+off_t slice_end(const run_format::RunIndex& index, std::string_view key) noexcept {
+    const size_t block = first_block_at_least(index, key);
+    return block < index.blocks.size() ? index.blocks[block].offset : index.data_end;
+}
+
+// sample_splitters: Chooses words that cut the union of sorted runs into similar slices.
+// Parameters:
+//   indexes: Block indexes of the runs.
+//   partitions: Number of slices wanted.
+// Returns:
+//   Strictly increasing splitter words.
+// Blocks hold a similar number of bytes, so their first words are an evenly spaced
+// sample of each run, and the quantiles of the pooled sample approximate the
+// quantiles of all words without reading any run data.
+std::vector<std::string> sample_splitters(const std::vector<run_format::RunIndex>& indexes,
+                                          size_t partitions) noexcept {
+    std::vector<std::string> splitters;
+    if (partitions < 2) {
+        return splitters;
+    }
+    std::vector<std::string_view> samples;
+    for (const auto& index : indexes) {
+        for (const auto& block : index.blocks) {
+            samples.push_back(block.first_word);
+        }
+    }
+    std::sort(samples.begin(), samples.end());
+    for (size_t i = 1; i < partitions && !samples.empty(); ++i) {
+        std::string_view splitter = samples[i * samples.size() / partitions];
+        if (splitter.empty() || (!splitters.empty() && splitter <= splitters.back())) {
+            continue;
+        }
+        splitters.emplace_back(splitter);
+    }
+    return splitters;
+}
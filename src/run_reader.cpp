@@ -0,0 +1,169 @@
+// run_reader.cpp: Implementation of RunReader for buffered reading of sorted runs.
+// This file refills a block buffer from a temporary file and decodes front-coded words.
+
+#include "run_reader.hpp"
+#include "run_format.hpp"
+#include <algorithm>
+#include <cstring>
+#include <limits>
+
+// Constructor: Initializes RunReader with a file handle and block size.
+// Parameters:
+//   file: Unique pointer to the run's file handle.
+//   block_size: Size of the refillable read buffer (at least one byte).
+//   length: Number of bytes to read from the handle's current position.
+//   counts: True if a slice's entries carry counts; a whole run reads this from its header.
+// The buffer is not zero-filled, so pages are only touched as data is read into them.
+// A reader starting at offset 0 expects the file header; any other position is a slice.
+RunReader::RunReader(std::unique_ptr<FileHandle> file, size_t block_size, size_t length, bool counts) noexcept
+    : file_(std::move(file)), buffer_(new char[std::max<size_t>(block_size, 1)]),
+      capacity_(std::max<size_t>(block_size, 1)), begin_(0), end_(0), block_end_(0), unread_(length), count_(1),
+      counts_(counts), check_header_(false), done_(false), failed_(false) {
+    if (!file_ || !file_->is_open()) {
+        done_ = true;
+    } else {
+        check_header_ = file_->seek(0, SEEK_CUR) == 0;
+    }
+}
+
+// next: Advances to the next word in the run.
+// Parameters:
+//   word: Receives a view of the rebuilt word, valid until the next call.
+// Returns:
+//   True if a word was read, false once the run is exhausted.
+// Each entry is a varint shared-prefix length, a varint suffix length, the suffix
+// and, in counting runs, a varint count; blocks are loaded whole, so entries never
+// straddle a refill.
+bool RunReader::next(std::string_view& word) noexcept {
+    while (begin_ >= block_end_) {
+        if (done_ || !start_block()) {
+            done_ = true;
+            return false;
+        }
+    }
+    const char* in = buffer_.get() + begin_;
+    const char* end = buffer_.get() + block_end_;
+    uint64_t shared;
+    uint64_t suffix;
+    const char* entry_end = nullptr;
+    bool valid = (in = run_format::get_varint(in, end, shared)) != nullptr &&
+                 (in = run_format::get_varint(in, end, suffix)) != nullptr && shared <= word_.size() &&
+                 suffix <= static_cast<uint64_t>(end - in);
+    if (valid) {
+        entry_end = in + suffix;
+        if (counts_) {
+            valid = (entry_end = run_format::get_varint(entry_end, end, count_)) != nullptr;
+        }
+    }
+    if (!valid) {
+        ssize_t res = write(STDERR_FILENO, "Error: Corrupt run file\n", 24);
+        (void)res;
+        done_ = true;
+        failed_ = true;
+        block_end_ = begin_;
+        return false;
+    }
+    word_.resize(static_cast<size_t>(shared));
+    word_.append(in, static_cast<size_t>(suffix));
+    begin_ = static_cast<size_t>(entry_end - buffer_.get());
+    word = word_;
+    return true;
+}
+
+// start_block: Validates the file header if needed and loads the next whole block.
+// Returns:
+//   True if a block with words is ready, false at the end marker or on error.
+bool RunReader::start_block() noexcept {
+    block_end_ = 0;
+    if (check_header_) {
+        check_header_ = false;
+        if (!ensure(run_format::FILE_HEADER_SIZE)) {
+            return false;
+        }
+        if (!run_format::check_file_header(buffer_.get() + begin_)) {
+            ssize_t res = write(STDERR_FILENO, "Error: Unrecognized run file format\n", 36);
+            (void)res;
+            failed_ = true;
+            return false;
+        }
+        counts_ = (run_format::file_flags(buffer_.get() + begin_) & run_format::FLAG_COUNTS) != 0;
+        begin_ += run_format::FILE_HEADER_SIZE;
+    }
+    for (;;) {
+        if (!ensure(run_format::BLOCK_HEADER_SIZE)) {
+            return false;
+        }
+        const size_t payload = run_format::get_u32(buffer_.get() + begin_);
+        const uint32_t words = run_format::get_u32(buffer_.get() + begin_ + 4);
+        if (payload == 0) {
+            // End marker: the index and trailer that follow are not words.
+            return false;
+        }
+        if (!ensure(run_format::BLOCK_HEADER_SIZE + payload)) {
+            return false;
+        }
+        begin_ += run_format::BLOCK_HEADER_SIZE;
+        block_end_ = begin_ + payload;
+        word_.clear();
+        if (words > 0) {
+            return true;
+        }
+        begin_ = block_end_;
+    }
+}
+
+// ensure: Makes at least size unconsumed bytes available in the buffer.
+// Parameters:
+//   size: Number of bytes needed.
+// Returns:
+//   True on success, false if the file or slice ends first.
+// A slice may only end where a block does, so leftover bytes at its end are a failure.
+bool RunReader::ensure(size_t size) noexcept {
+    while (end_ - begin_ < size) {
+        if (!refill(size)) {
+            failed_ = failed_ || end_ > begin_;
+            return false;
+        }
+    }
+    return true;
+}
+
+// refill: Moves unconsumed bytes to the front of the buffer and reads the next block.
+// Parameters:
+//   needed: Unconsumed bytes the buffer must be able to hold.
+// Returns:
+//   True if new bytes were read, false at the end of the slice, or on error.
+// Grows the buffer (by doubling) when a single run block does not fit in it. A run
+// ends at its end marker and a slice after its length, so reaching the end of the
+// file first means the run was truncated and counts as a failure, like a read error;
+// only a completely empty file reads as an empty run.
+bool RunReader::refill(size_t needed) noexcept {
+    if (unread_ == 0) {
+        return false;
+    }
+    const size_t remaining = end_ - begin_;
+    if (begin_ > 0) {
+        std::memmove(buffer_.get(), buffer_.get() + begin_, remaining);
+        begin_ = 0;
+        end_ = remaining;
+    }
+    if (needed > capacity_) {
+        size_t grown_capacity = capacity_;
+        while (grown_capacity < needed) {
+            grown_capacity *= 2;
+        }
+        std::unique_ptr<char[]> grown(new char[grown_capacity]);
+        std::memcpy(grown.get(), buffer_.get(), end_);
+        buffer_ = std::move(grown);
+        capacity_ = grown_capacity;
+    }
+    ssize_t bytes_read = file_->read(buffer_.get() + end_, std::min(capacity_ - end_, unread_));
+    if (bytes_read <= 0) {
+        // An empty file (nothing read from a whole-file reader) is an empty run.
+        failed_ = bytes_read < 0 || unread_ != std::numeric_limits<size_t>::max();
+        return false;
+    }
+    end_ += static_cast<size_t>(bytes_read);
+    unread_ -= static_cast<size_t>(bytes_read);
+    return true;
+}
@@ -0,0 +1,234 @@
+// run_writer.cpp: Implementation of RunWriter for buffered writing of sorted runs.
+// This file front-codes words into blocks in a buffer and flushes it in large write() calls.
+
+#include "run_writer.hpp"
+#include <algorithm>
+#include <cstring>
+
+// Constructor: Initializes RunWriter with a file handle and block size.
+// Parameters:
+//   file: Unique pointer to a file handle opened for writing.
+//   block_size: Size of the write buffer (at least one byte).
+//   counts: True to store an occurrence count with every word.
+// The file header is buffered immediately so it is written with the first block.
+RunWriter::RunWriter(std::unique_ptr<FileHandle> file, size_t block_size, bool counts) noexcept
+    : file_(std::move(file)),
+      capacity_(std::max<size_t>(block_size, run_format::FILE_HEADER_SIZE + run_format::BLOCK_HEADER_SIZE)),
+      used_(run_format::FILE_HEADER_SIZE), written_(0),
+      block_limit_(std::min<size_t>(std::max<size_t>(block_size, 1), run_format::BLOCK_PAYLOAD_SIZE)),
+      block_start_(0), block_open_(false), counts_(counts), block_words_(0), words_(0), failed_(false),
+      finished_(false) {
+    buffer_.reset(new char[capacity_]);
+    run_format::write_file_header(buffer_.get(), counts_ ? run_format::FLAG_COUNTS : 0);
+}
+
+// Destructor: Finishes the run so no data is lost on scope exit.
+RunWriter::~RunWriter() noexcept {
+    finish();
+}
+
+// append: Buffers one word, front-coded against the previous word of its block.
+// Parameters:
+//   word: Word to append.
+//   count: Occurrences of the word, stored after the suffix in counting runs.
+// Returns:
+//   True on success, false if the file could not be written.
+// A new block is started once the open one reaches its size limit; its first word
+// is stored whole and recorded in the index.
+bool RunWriter::append(std::string_view word, uint64_t count) noexcept {
+    if (failed_ || finished_) {
+        return false;
+    }
+    if (block_open_ && used_ - block_start_ - run_format::BLOCK_HEADER_SIZE >= block_limit_) {
+        close_block();
+    }
+    if (!block_open_) {
+        if (!reserve(run_format::BLOCK_HEADER_SIZE)) {
+            return false;
+        }
+        block_start_ = used_;
+        used_ += run_format::BLOCK_HEADER_SIZE;
+        block_open_ = true;
+        block_words_ = 0;
+        previous_.clear();
+        index_.push_back({static_cast<off_t>(written_ + block_start_), std::string(word)});
+    }
+
+    const size_t limit = std::min(previous_.size(), word.size());
+    size_t shared = 0;
+    while (shared < limit && previous_[shared] == word[shared]) {
+        ++shared;
+    }
+    const size_t suffix = word.size() - shared;
+    if (!reserve(3 * run_format::MAX_VARINT_SIZE + suffix)) {
+        return false;
+    }
+    char* out = buffer_.get() + used_;
+    out = run_format::put_varint(out, shared);
+    out = run_format::put_varint(out, suffix);
+    std::memcpy(out, word.data() + shared, suffix);
+    out += suffix;
+    if (counts_) {
+        out = run_format::put_varint(out, count);
+    }
+    used_ = static_cast<size_t>(out - buffer_.get());
+
+    previous_.resize(shared);
+    previous_.append(word.data() + shared, suffix);
+    ++block_words_;
+    ++words_;
+    return true;
+}
+
+// flush: Closes the current block and writes buffered bytes to the file.
+// Returns:
+//   True on success, false on a write error.
+bool RunWriter::flush() noexcept {
+    if (block_open_) {
+        close_block();
+    }
+    return write_out();
+}
+
+// finish: Writes the end marker, the block index, the footer and the trailer.
+// Parameters:
+//   footer: Bytes stored between the index and the trailer.
+// Returns:
+//   True on success, false on a write error.
+bool RunWriter::finish(std::string_view footer) noexcept {
+    if (finished_) {
+        return !failed_;
+    }
+    if (block_open_) {
+        close_block();
+    }
+    finished_ = true;
+
+    // End marker: an empty block header.
+    if (!reserve(run_format::BLOCK_HEADER_SIZE)) {
+        return false;
+    }
+    std::memset(buffer_.get() + used_, 0, run_format::BLOCK_HEADER_SIZE);
+    used_ += run_format::BLOCK_HEADER_SIZE;
+
+    const uint64_t index_offset = written_ + used_;
+    if (!reserve(run_format::MAX_VARINT_SIZE)) {
+        return false;
+    }
+    used_ = static_cast<size_t>(run_format::put_varint(buffer_.get() + used_, index_.size()) - buffer_.get());
+    for (const auto& block : index_) {
+        if (!reserve(2 * run_format::MAX_VARINT_SIZE + block.first_word.size())) {
+            return false;
+        }
+        char* out = buffer_.get() + used_;
+        out = run_format::put_varint(out, static_cast<uint64_t>(block.offset));
+        out = run_format::put_varint(out, block.first_word.size());
+        std::memcpy(out, block.first_word.data(), block.first_word.size());
+        used_ = static_cast<size_t>(out + block.first_word.size() - buffer_.get());
+    }
+    if (!reserve(footer.size())) {
+        return false;
+    }
+    std::memcpy(buffer_.get() + used_, footer.data(), footer.size());
+    used_ += footer.size();
+
+    if (!reserve(run_format::TRAILER_SIZE)) {
+        return false;
+    }
+    run_format::put_u64(buffer_.get() + used_, index_offset);
+    std::memcpy(buffer_.get() + used_ + 8, run_format::INDEX_MAGIC, sizeof(run_format::INDEX_MAGIC));
+    used_ += run_format::TRAILER_SIZE;
+    if (!write_out()) {
+        return false;
+    }
+    // Handles that write in the background must land every block before the run is complete.
+    if (!file_->flush()) {
+        failed_ = true;
+        return false;
+    }
+    return true;
+}
+
+// bytes_written: Reports the number of bytes written to the file so far.
+// Returns:
+//   Bytes flushed to the file.
+size_t RunWriter::bytes_written() const noexcept {
+    return written_;
+}
+
+// words_written: Reports the number of words appended.
+// Returns:
+//   Word count.
+size_t RunWriter::words_written() const noexcept {
+    return words_;
+}
+
+// reserve: Makes room for size more bytes.
+// Parameters:
+//   size: Number of bytes about to be buffered.
+// Returns:
+//   True on success, false on a write error.
+// When the buffer runs short the completed blocks are written out and the open block,
+// whose header is not filled in yet, moves to the front. The buffer only grows when
+// the open block alone does not fit.
+bool RunWriter::reserve(size_t size) noexcept {
+    if (failed_) {
+        return false;
+    }
+    if (used_ + size <= capacity_) {
+        return true;
+    }
+    if (!write_out()) {
+        return false;
+    }
+    if (used_ + size > capacity_) {
+        size_t grown_capacity = capacity_;
+        while (used_ + size > grown_capacity) {
+            grown_capacity *= 2;
+        }
+        std::unique_ptr<char[]> grown(new char[grown_capacity]);
+        std::memcpy(grown.get(), buffer_.get(), used_);
+        buffer_ = std::move(grown);
+        capacity_ = grown_capacity;
+    }
+    return true;
+}
+
+// close_block: Fills in the open block's payload size and word count.
+void RunWriter::close_block() noexcept {
+    const size_t payload = used_ - block_start_ - run_format::BLOCK_HEADER_SIZE;
+    run_format::put_u32(buffer_.get() + block_start_, static_cast<uint32_t>(payload));
+    run_format::put_u32(buffer_.get() + block_start_ + 4, block_words_);
+    block_open_ = false;
+}
+
+// write_out: Writes buffered bytes up to the open block, retrying short writes.
+// Returns:
+//   True on success, false on a write error.
+// The open block's bytes are moved to the front of the buffer; with no open block
+// the buffer is left empty.
+bool RunWriter::write_out() noexcept {
+    if (failed_ || !file_ || !file_->is_open()) {
+        failed_ = true;
+        used_ = 0;
+        return false;
+    }
+    const size_t end = block_open_ ? block_start_ : used_;
+    size_t offset = 0;
+    while (offset < end) {
+        ssize_t res = file_->write(buffer_.get() + offset, end - offset);
+        if (res <= 0) {
+            failed_ = true;
+            used_ = 0;
+            return false;
+        }
+        offset += static_cast<size_t>(res);
+    }
+    std::memmove(buffer_.get(), buffer_.get() + end, used_ - end);
+    written_ += end;
+    used_ -= end;
+    if (block_open_) {
+        block_start_ -= end;
+    }
+    return true;
+}
@@ -0,0 +1,97 @@
+// sharded_word_set.cpp: Implementation of ShardedWordSet for concurrent exact deduplication.
+// This file routes words to hash-selected shards and stores new ones in per-shard arenas.
+
+#include "sharded_word_set.hpp"
+#include <cstring>
+#include <functional>
+
+namespace {
+
+// Estimated per-word overhead of an unordered_set node plus its bucket slot.
+constexpr size_t NODE_OVERHEAD = 48;
+
+// shard_of: Maps a word hash to a shard index using its high bits, which the
+// set's own bucket index (low bits) does not depend on.
+size_t shard_of(size_t hash) noexcept {
+    return (hash >> (sizeof(size_t) * 4)) % ShardedWordSet::SHARD_COUNT;
+}
+
+} // namespace
+
+// Constructor: Initializes an empty set with zero tracked memory.
+ShardedWordSet::ShardedWordSet() noexcept
+    : memory_usage_(0) {
+}
+
+// insert_batch: Inserts a batch of words, locking each shard at most once.
+// Parameters:
+//   words: Words to insert; new ones are copied into the owning shard's arena.
+// Words are first grouped by shard so threads hold each lock only for one tight loop.
+void ShardedWordSet::insert_batch(const std::vector<std::string_view>& words) noexcept {
+    std::array<std::vector<std::string_view>, SHARD_COUNT> groups;
+    std::hash<std::string_view> hasher;
+    for (const auto& word : words) {
+        groups[shard_of(hasher(word))].push_back(word);
+    }
+
+    for (size_t i = 0; i < SHARD_COUNT; ++i) {
+        if (groups[i].empty()) {
+            continue;
+        }
+        Shard& shard = shards_[i];
+        size_t added = 0;
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        for (const auto& word : groups[i]) {
+            if (shard.words.find(word) != shard.words.end()) {
+                continue;
+            }
+            char* copy = shard.arena.allocate(word.size());
+            std::memcpy(copy, word.data(), word.size());
+            shard.words.emplace(copy, word.size());
+            added += word.size() + NODE_OVERHEAD;
+        }
+        memory_usage_.fetch_add(added, std::memory_order_relaxed);
+    }
+}
+
+// size: Counts the distinct words stored across all shards.
+// Returns:
+//   Number of distinct words.
+size_t ShardedWordSet::size() const noexcept {
+    size_t total = 0;
+    for (const auto& shard : shards_) {
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        total += shard.words.size();
+    }
+    return total;
+}
+
+// memory_usage: Estimates the bytes held by all shards.
+// Returns:
+//   Word bytes plus an estimated per-node overhead.
+size_t ShardedWordSet::memory_usage() const noexcept {
+    return memory_usage_.load(std::memory_order_relaxed);
+}
+
+// words: Collects views of every stored word.
+// Returns:
+//   Unordered views into the shard arenas, valid for the lifetime of the set.
+std::vector<std::string_view> ShardedWordSet::words() const noexcept {
+    std::vector<std::string_view> result;
+    result.reserve(size());
+    for (const auto& shard : shards_) {
+        result.insert(result.end(), shard.words.begin(), shard.words.end());
+    }
+    return result;
+}
+
+// clear: Removes every word and releases the shards' memory.
+// Swapping with fresh containers returns the hash buckets and arena blocks to the allocator.
+void ShardedWordSet::clear() noexcept {
+    for (auto& shard : shards_) {
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        std::unordered_set<std::string_view>().swap(shard.words);
+        shard.arena = WordArena(1ULL << 20);
+    }
+    memory_usage_.store(0, std::memory_order_relaxed);
+}
@@ -0,0 +1,247 @@
+// stats_report.cpp: Implementation of StatsReport for per-phase run statistics.
+// This file times phases, sums the component counters and writes them as JSON.
+
+#include "stats_report.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <sys/resource.h>
+#include <sys/stat.h>
+#include <time.h>
+
+namespace {
+
+// seconds: Formats a duration as fractional seconds.
+std::string seconds(std::chrono::nanoseconds time) noexcept {
+    char buffer[32];
+    snprintf(buffer, sizeof(buffer), "%.6f", std::chrono::duration<double>(time).count());
+    return buffer;
+}
+
+// ratio: Formats the busy share of a thread's time, 0 if it had no time at all.
+std::string ratio(std::chrono::nanoseconds busy, std::chrono::nanoseconds total) noexcept {
+    char buffer[32];
+    snprintf(buffer, sizeof(buffer), "%.4f",
+             total.count() > 0 ? static_cast<double>(busy.count()) / static_cast<double>(total.count()) : 0.0);
+    return buffer;
+}
+
+// field: Appends a "key": value member; value is already JSON.
+void field(std::string& out, const char* key, const std::string& value, bool last = false) noexcept {
+    out += '"';
+    out += key;
+    out += "\": ";
+    out += value;
+    out += last ? "" : ", ";
+}
+
+// field: Appends a "key": number member.
+void field(std::string& out, const char* key, size_t value, bool last = false) noexcept {
+    field(out, key, std::to_string(value), last);
+}
+
+} // namespace
+
+// Constructor: Starts the total wall and CPU clocks.
+StatsReport::StatsReport() noexcept
+    : start_(clock_type::now()), start_cpu_(cpu_time()), phase_open_(false), phase_start_(start_),
+      phase_start_cpu_(start_cpu_), planning_time_(0), runs_{0, 0, 0, 0}, merge_{0, 0, 0, 0, 0} {
+}
+
+// begin_phase: Ends the open phase, if any, and starts timing a new one.
+// Parameters:
+//   name: Phase name.
+// Returns:
+//   The new phase, with zero counters; later begin_phase() calls may move it.
+StatsReport::Phase& StatsReport::begin_phase(const std::string& name) noexcept {
+    end_phase();
+    phases_.push_back({name, std::chrono::nanoseconds(0), std::chrono::nanoseconds(0), 0, 0, 0});
+    phase_open_ = true;
+    phase_start_ = clock_type::now();
+    phase_start_cpu_ = cpu_time();
+    return phases_.back();
+}
+
+// end_phase: Stops timing the open phase.
+// Calling it with no open phase does nothing, so a phase may be ended early on one path.
+void StatsReport::end_phase() noexcept {
+    if (!phase_open_) {
+        return;
+    }
+    phases_.back().wall = clock_type::now() - phase_start_;
+    phases_.back().cpu = cpu_time() - phase_start_cpu_;
+    phase_open_ = false;
+}
+
+// add_pipeline: Adds the stage counters of a chunk pipeline run.
+// Parameters:
+//   stages: Stage statistics, in pipeline order.
+//   planning_time: Time the coordinator spent before the pipeline ran.
+// Stages are summed by position, so several runs report as one pipeline. The open
+// phase is credited with the read stage's bytes, the parsed words and the run bytes.
+void StatsReport::add_pipeline(const std::vector<ChunkPipeline::StageStats>& stages,
+                               std::chrono::nanoseconds planning_time) noexcept {
+    if (stages_.empty()) {
+        stages_ = stages;
+    } else {
+        for (size_t i = 0; i < std::min(stages_.size(), stages.size()); ++i) {
+            stages_[i].workers = std::max(stages_[i].workers, stages[i].workers);
+            stages_[i].chunks += stages[i].chunks;
+            stages_[i].bytes += stages[i].bytes;
+            stages_[i].words += stages[i].words;
+            stages_[i].words_parsed += stages[i].words_parsed;
+            stages_[i].bytes_written += stages[i].bytes_written;
+            stages_[i].busy_time += stages[i].busy_time;
+            stages_[i].input_wait += stages[i].input_wait;
+            stages_[i].output_wait += stages[i].output_wait;
+        }
+    }
+    planning_time_ += planning_time;
+    if (phases_.empty() || stages.size() <= ChunkPipeline::SPILL) {
+        return;
+    }
+    Phase& phase = phases_.back();
+    phase.bytes_read += stages[ChunkPipeline::READ].bytes;
+    phase.words += stages[ChunkPipeline::PARSE].words_parsed;
+    phase.bytes_written += stages[ChunkPipeline::SPILL].bytes_written;
+}
+
+// add_runs: Records the sizes of runs handed to the merge.
+// Parameters:
+//   runs: Run files; their sizes are read with stat().
+void StatsReport::add_runs(const std::vector<TempFile>& runs) noexcept {
+    for (const auto& run : runs) {
+        struct stat st;
+        const size_t size = stat(run.name().c_str(), &st) == 0 ? static_cast<size_t>(st.st_size) : 0;
+        runs_.min_bytes = runs_.count == 0 ? size : std::min(runs_.min_bytes, size);
+        runs_.max_bytes = std::max(runs_.max_bytes, size);
+        runs_.total_bytes += size;
+        ++runs_.count;
+    }
+}
+
+// set_merge: Records what the merge did.
+// Parameters:
+//   merge: Merge statistics of the count.
+// The open phase is credited with the run bytes the merge read and rewrote.
+void StatsReport::set_merge(const WordCounter::MergeStats& merge) noexcept {
+    merge_ = merge;
+    if (!phases_.empty()) {
+        phases_.back().bytes_read += merge.bytes_read;
+        phases_.back().bytes_written += merge.bytes_rewritten;
+    }
+}
+
+// phases: Phases recorded so far.
+// Returns:
+//   Phases in start order; the last one has no times while it is open.
+const std::vector<StatsReport::Phase>& StatsReport::phases() const noexcept {
+    return phases_;
+}
+
+// runs: Run sizes recorded so far.
+// Returns:
+//   Count, total, smallest and largest run size.
+StatsReport::RunStats StatsReport::runs() const noexcept {
+    return runs_;
+}
+
+// to_json: Renders the report.
+// Parameters:
+//   threads: Per-worker counters of the thread pool that ran the work.
+// Returns:
+//   One JSON object on one line. Times are in seconds and sizes in bytes; a stage's
+//   utilization is its busy share of busy plus waiting time, summed over its threads,
+//   and a pool thread's is its busy share of busy plus idle time.
+std::string StatsReport::to_json(const std::vector<ThreadPool::WorkerStats>& threads) const noexcept {
+    std::string out = "{";
+    field(out, "wall_seconds", seconds(clock_type::now() - start_));
+    field(out, "cpu_seconds", seconds(cpu_time() - start_cpu_));
+    field(out, "peak_rss_bytes", peak_rss());
+
+    out += "\"phases\": [";
+    for (size_t i = 0; i < phases_.size(); ++i) {
+        const Phase& phase = phases_[i];
+        out += i == 0 ? "{" : ", {";
+        field(out, "name", "\"" + phase.name + "\"");
+        field(out, "wall_seconds", seconds(phase.wall));
+        field(out, "cpu_seconds", seconds(phase.cpu));
+        field(out, "bytes_read", phase.bytes_read);
+        field(out, "bytes_written", phase.bytes_written);
+        field(out, "words", phase.words, true);
+        out += "}";
+    }
+    out += "], ";
+
+    out += "\"pipeline\": {";
+    field(out, "planning_seconds", seconds(planning_time_));
+    out += "\"stages\": [";
+    for (size_t i = 0; i < stages_.size(); ++i) {
+        const ChunkPipeline::StageStats& stage = stages_[i];
+        out += i == 0 ? "{" : ", {";
+        field(out, "name", std::string("\"") + stage.name + "\"");
+        field(out, "workers", stage.workers);
+        field(out, "chunks", stage.chunks);
+        field(out, "bytes", stage.bytes);
+        field(out, "words", stage.words);
+        field(out, "words_parsed", stage.words_parsed);
+        field(out, "bytes_written", stage.bytes_written);
+        field(out, "busy_seconds", seconds(stage.busy_time));
+        field(out, "input_wait_seconds", seconds(stage.input_wait));
+        field(out, "output_wait_seconds", seconds(stage.output_wait));
+        field(out, "utilization", ratio(stage.busy_time, stage.busy_time + stage.input_wait + stage.output_wait), true);
+        out += "}";
+    }
+    out += "]}, ";
+
+    out += "\"runs\": {";
+    field(out, "count", runs_.count);
+    field(out, "total_bytes", runs_.total_bytes);
+    field(out, "min_bytes", runs_.min_bytes);
+    field(out, "max_bytes", runs_.max_bytes, true);
+    out += "}, ";
+
+    out += "\"merge\": {";
+    field(out, "runs", merge_.runs);
+    field(out, "passes", merge_.passes);
+    field(out, "intermediate_runs", merge_.intermediate_runs);
+    field(out, "bytes_rewritten", merge_.bytes_rewritten);
+    field(out, "bytes_read", merge_.bytes_read, true);
+    out += "}, ";
+
+    out += "\"threads\": [";
+    for (size_t i = 0; i < threads.size(); ++i) {
+        const ThreadPool::WorkerStats& worker = threads[i];
+        out += i == 0 ? "{" : ", {";
+        field(out, "tasks_executed", worker.tasks_executed);
+        field(out, "tasks_stolen", worker.tasks_stolen);
+        field(out, "busy_seconds", seconds(worker.busy_time));
+        field(out, "idle_seconds", seconds(worker.idle_time));
+        field(out, "utilization", ratio(worker.busy_time, worker.busy_time + worker.idle_time), true);
+        out += "}";
+    }
+    out += "]}\n";
+    return out;
+}
+
+// peak_rss: Peak resident set size of the process.
+// Returns:
+//   getrusage()'s maximum resident set size in bytes, or 0 if it fails.
+size_t StatsReport::peak_rss() noexcept {
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0) {
+        return 0;
+    }
+    // Linux reports the maximum in KiB.
+    return static_cast<size_t>(usage.ru_maxrss) * 1024;
+}
+
+// cpu_time: CPU time of all threads of the process so far.
+// Returns:
+//   The process CPU clock, or zero if it is unavailable.
+std::chrono::nanoseconds StatsReport::cpu_time() noexcept {
+    struct timespec now;
+    if (clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &now) != 0) {
+        return std::chrono::nanoseconds(0);
+    }
+    return std::chrono::seconds(now.tv_sec) + std::chrono::nanoseconds(now.tv_nsec);
+}
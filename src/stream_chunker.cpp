@@ -0,0 +1,130 @@
+// stream_chunker.cpp: Implementation of StreamChunker for chunking non-seekable input.
+// This file reads a stream sequentially and cuts it after the last space of each chunk.
+
+#include "stream_chunker.hpp"
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+
+// Constructor: Chunks a stream.
+// Parameters:
+//   input: Handle to read from; not owned.
+//   chunk_size: Nominal chunk size.
+StreamChunker::StreamChunker(FileHandle& input, size_t chunk_size) noexcept
+    : input_(input), chunk_size_(std::max<size_t>(chunk_size, 1)), consumed_(0), eof_(false), failed_(false) {
+}
+
+// set_chunk_size: Changes the nominal size of later chunks.
+// Parameters:
+//   chunk_size: Nominal chunk size.
+void StreamChunker::set_chunk_size(size_t chunk_size) noexcept {
+    chunk_size_ = std::max<size_t>(chunk_size, 1);
+}
+
+// peek: Reads ahead without consuming.
+// Parameters:
+//   size: Number of bytes wanted.
+// Returns:
+//   The carried bytes, topped up to size unless the stream ended first.
+const std::string& StreamChunker::peek(size_t size) noexcept {
+    if (carry_.size() < size && !eof_ && !failed_) {
+        const size_t old_size = carry_.size();
+        carry_.resize(size);
+        carry_.resize(old_size + fill(&carry_[old_size], size - old_size));
+    }
+    return carry_;
+}
+
+// next: Reads the next chunk.
+// Parameters:
+//   arena: Arena receiving the chunk's bytes.
+//   size: Output number of bytes in the chunk.
+// Returns:
+//   Pointer to the chunk's bytes, or nullptr at the end of the stream or on error.
+// The chunk starts with the carried bytes and is topped up from the stream. Unless the
+// stream ended, it is cut after its last space and the rest is carried. A chunk with no
+// space at all is one word longer than the chunk size; reading continues in READ_SIZE
+// steps until the word ends.
+const char* StreamChunker::next(WordArena& arena, size_t& size) noexcept {
+    size = 0;
+    if (failed_ || (eof_ && carry_.empty())) {
+        return nullptr;
+    }
+    const size_t capacity = std::max(chunk_size_, carry_.size());
+    char* data = arena.allocate(capacity);
+    size_t filled = carry_.size();
+    std::memcpy(data, carry_.data(), filled);
+    carry_.clear();
+    filled += fill(data + filled, capacity - filled);
+    if (failed_) {
+        return nullptr;
+    }
+
+    size_t cut = filled;
+    if (!eof_) {
+        while (cut > 0 && data[cut - 1] != ' ') {
+            --cut;
+        }
+    }
+    if (cut == 0 && !eof_) {
+        std::string word(data, filled);
+        size_t end = std::string::npos;
+        while (end == std::string::npos && !eof_) {
+            const size_t old_size = word.size();
+            word.resize(old_size + READ_SIZE);
+            word.resize(old_size + fill(&word[old_size], READ_SIZE));
+            if (failed_) {
+                return nullptr;
+            }
+            end = word.find(' ', old_size);
+        }
+        cut = end == std::string::npos ? word.size() : end;
+        data = arena.allocate(cut);
+        std::memcpy(data, word.data(), cut);
+        carry_.assign(word, cut, std::string::npos);
+    } else {
+        carry_.assign(data + cut, filled - cut);
+    }
+    if (cut == 0) {
+        return nullptr;
+    }
+    size = cut;
+    consumed_ += cut;
+    return data;
+}
+
+// failed: Checks if a read failed.
+// Returns:
+//   True after a read error.
+bool StreamChunker::failed() const noexcept {
+    return failed_;
+}
+
+// bytes_consumed: Bytes returned in chunks so far.
+// Returns:
+//   Stream offset of the next chunk.
+size_t StreamChunker::bytes_consumed() const noexcept {
+    return consumed_;
+}
+
+// fill: Reads until a buffer is full or the stream ends.
+// Parameters:
+//   buffer: Destination.
+//   size: Number of bytes wanted.
+// Returns:
+//   Bytes read. Pipes return short reads, so read() is repeated; EINTR is retried.
+size_t StreamChunker::fill(char* buffer, size_t size) noexcept {
+    size_t filled = 0;
+    while (filled < size && !eof_) {
+        ssize_t bytes_read = input_.read(buffer + filled, size - filled);
+        if (bytes_read > 0) {
+            filled += static_cast<size_t>(bytes_read);
+        } else if (bytes_read == 0) {
+            eof_ = true;
+        } else if (errno != EINTR) {
+            failed_ = true;
+            break;
+        }
+    }
+    return filled;
+}
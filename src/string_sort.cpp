@@ -0,0 +1,127 @@
+// string_sort.cpp: Implementation of string sorting engines for chunk words.
+// This file implements an MSD radix sort specialised for lowercase ASCII words.
+
+#include "string_sort.hpp"
+#include <algorithm>
+#include <cstdint>
+
+namespace {
+
+// Bucket 0 holds words that end at the current depth; buckets 1-26 hold 'a'-'z'.
+constexpr size_t BUCKETS = 27;
+
+// Below this size, insertion sort beats another distribution pass.
+constexpr size_t INSERTION_THRESHOLD = 32;
+
+// suffix_less: Compares two words from a given depth, where their prefixes are equal.
+bool suffix_less(std::string_view a, std::string_view b, size_t depth) noexcept {
+    return a.substr(depth) < b.substr(depth);
+}
+
+// insertion_sort: Sorts a small range of words sharing their first depth characters.
+void insertion_sort(std::string_view* words, size_t count, size_t depth) noexcept {
+    for (size_t i = 1; i < count; ++i) {
+        std::string_view word = words[i];
+        size_t j = i;
+        while (j > 0 && suffix_less(word, words[j - 1], depth)) {
+            words[j] = words[j - 1];
+            --j;
+        }
+        words[j] = word;
+    }
+}
+
+// msd_sort: Recursively radix sorts a range of words sharing their first depth characters.
+// Parameters:
+//   words: Range to sort.
+//   aux: Scratch space at least as large as the range.
+//   keys: Scratch key cache at least as large as the range.
+//   count: Number of words in the range.
+//   depth: Character position to distribute on.
+void msd_sort(std::string_view* words, std::string_view* aux, uint8_t* keys, size_t count, size_t depth) noexcept {
+    while (count > 1) {
+        if (count < INSERTION_THRESHOLD) {
+            insertion_sort(words, count, depth);
+            return;
+        }
+
+        // Cache each word's key so the distribution pass does not chase pointers again.
+        size_t counts[BUCKETS] = {};
+        for (size_t i = 0; i < count; ++i) {
+            uint8_t key = 0;
+            if (depth < words[i].size()) {
+                const unsigned letter = static_cast<unsigned char>(words[i][depth]) - 'a';
+                if (letter >= 26) {
+                    // Outside the alphabet: comparison sort keeps the result correct.
+                    std::sort(words, words + count, [depth](std::string_view a, std::string_view b) {
+                        return suffix_less(a, b, depth);
+                    });
+                    return;
+                }
+                key = static_cast<uint8_t>(letter + 1);
+            }
+            keys[i] = key;
+            ++counts[key];
+        }
+
+        // A shared character needs no distribution; move on to the next position.
+        if (counts[keys[0]] == count) {
+            if (keys[0] == 0) {
+                return;
+            }
+            ++depth;
+            continue;
+        }
+
+        size_t offsets[BUCKETS];
+        size_t sum = 0;
+        for (size_t b = 0; b < BUCKETS; ++b) {
+            offsets[b] = sum;
+            sum += counts[b];
+        }
+        for (size_t i = 0; i < count; ++i) {
+            aux[offsets[keys[i]]++] = words[i];
+        }
+        std::copy(aux, aux + count, words);
+
+        // Bucket 0 words are all equal; recurse into each letter bucket.
+        size_t start = counts[0];
+        for (size_t b = 1; b < BUCKETS; ++b) {
+            if (counts[b] > 1) {
+                msd_sort(words + start, aux, keys, counts[b], depth + 1);
+            }
+            start += counts[b];
+        }
+        return;
+    }
+}
+
+} // namespace
+
+// sort_words: Sorts word views lexicographically with the selected engine.
+// Parameters:
+//   words: Views to sort in place.
+//   algorithm: Sorting engine to use.
+void sort_words(std::vector<std::string_view>& words, SortAlgorithm algorithm) noexcept {
+    switch (algorithm) {
+        case SortAlgorithm::Std:
+            std::sort(words.begin(), words.end());
+            break;
+        case SortAlgorithm::MsdRadix:
+            msd_radix_sort(words);
+            break;
+    }
+}
+
+// msd_radix_sort: Sorts word views with an MSD radix sort.
+// Parameters:
+//   words: Views to sort in place.
+// Allocates one scratch view array and one key byte per word up front, shared by all levels.
+void msd_radix_sort(std::vector<std::string_view>& words) noexcept {
+    if (words.size() < 2) {
+        return;
+    }
+    std::vector<std::string_view> aux(words.size());
+    std::vector<uint8_t> keys(words.size());
+    msd_sort(words.data(), aux.data(), keys.data(), words.size(), 0);
+}
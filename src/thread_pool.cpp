@@ -0,0 +1,193 @@
+// thread_pool.cpp: Implementation of ThreadPool for persistent work-stealing task execution.
+// This file runs the worker loops, distributes submitted tasks, and tracks per-worker statistics.
+
+#include "thread_pool.hpp"
+#include <algorithm>
+
+namespace {
+
+// Deadline of one wait; it only bounds a single sleep, wake-ups come from notifications.
+constexpr std::chrono::hours WAIT_DEADLINE(24);
+
+// wait_until_true: Blocks on a condition variable until a predicate holds.
+// Parameters:
+//   condition: Condition variable notified whenever the predicate may have changed.
+//   lock: Held lock of the condition's mutex.
+//   predicate: Condition to wait for.
+// Equivalent to condition.wait(lock, predicate), but built on the inline deadline wait:
+// the untimed wait() is an out-of-line libstdc++ symbol from GCC 12 (GLIBCXX_3.4.30)
+// that older runtimes lack.
+template <typename Predicate>
+void wait_until_true(std::condition_variable& condition, std::unique_lock<std::mutex>& lock,
+                     Predicate predicate) noexcept {
+    while (!predicate()) {
+        condition.wait_until(lock, std::chrono::steady_clock::now() + WAIT_DEADLINE);
+    }
+}
+
+} // namespace
+
+// Constructor: Starts the worker threads.
+// Parameters:
+//   thread_count: Number of workers; 0 selects the hardware concurrency (at least one).
+ThreadPool::ThreadPool(size_t thread_count) noexcept
+    : pending_(0), stopping_(false), next_queue_(0) {
+    if (thread_count == 0) {
+        thread_count = std::max(1u, std::thread::hardware_concurrency());
+    }
+    for (size_t i = 0; i < thread_count; ++i) {
+        workers_.push_back(std::make_unique<Worker>());
+    }
+    // Start threads only after every deque exists, since workers steal from all of them.
+    for (size_t i = 0; i < thread_count; ++i) {
+        workers_[i]->thread = std::thread([this, i]() { worker_loop(i); });
+    }
+}
+
+// Destructor: Lets workers drain queued tasks, then joins them.
+ThreadPool::~ThreadPool() noexcept {
+    {
+        std::lock_guard<std::mutex> lock(wake_mutex_);
+        stopping_ = true;
+    }
+    wake_.notify_all();
+    for (auto& worker : workers_) {
+        worker->thread.join();
+    }
+}
+
+// submit: Queues a task on the next worker deque in round-robin order.
+// Parameters:
+//   task: Callable to run on a worker thread.
+void ThreadPool::submit(std::function<void()> task) noexcept {
+    Worker& worker = *workers_[next_queue_.fetch_add(1, std::memory_order_relaxed) % workers_.size()];
+    // Count the task before publishing it so a fast taker never drives pending_ below zero.
+    {
+        std::lock_guard<std::mutex> lock(wake_mutex_);
+        ++pending_;
+    }
+    {
+        std::lock_guard<std::mutex> lock(worker.mutex);
+        worker.tasks.push_back(std::move(task));
+    }
+    wake_.notify_one();
+}
+
+// run_all: Runs a batch of tasks and blocks until every one has finished.
+// Parameters:
+//   tasks: Callables to run.
+// Completion is tracked per batch, so independent callers can share the pool.
+void ThreadPool::run_all(std::vector<std::function<void()>> tasks) noexcept {
+    std::mutex done_mutex;
+    std::condition_variable done;
+    size_t remaining = tasks.size();
+    for (auto& task : tasks) {
+        submit([&, task = std::move(task)]() {
+            task();
+            std::lock_guard<std::mutex> lock(done_mutex);
+            if (--remaining == 0) {
+                done.notify_all();
+            }
+        });
+    }
+    std::unique_lock<std::mutex> lock(done_mutex);
+    wait_until_true(done, lock, [&remaining]() { return remaining == 0; });
+}
+
+// size: Number of worker threads.
+// Returns:
+//   Worker count.
+size_t ThreadPool::size() const noexcept {
+    return workers_.size();
+}
+
+// stats: Snapshot of every worker's counters.
+// Returns:
+//   One WorkerStats per worker, in worker order.
+std::vector<ThreadPool::WorkerStats> ThreadPool::stats() const noexcept {
+    std::vector<WorkerStats> result;
+    result.reserve(workers_.size());
+    for (const auto& worker : workers_) {
+        result.push_back({worker->executed.load(std::memory_order_relaxed),
+                          worker->stolen.load(std::memory_order_relaxed),
+                          std::chrono::nanoseconds(worker->busy_ns.load(std::memory_order_relaxed)),
+                          std::chrono::nanoseconds(worker->idle_ns.load(std::memory_order_relaxed))});
+    }
+    return result;
+}
+
+// shared: Process-wide pool sized to the hardware concurrency.
+// Returns:
+//   Reference to a pool created on first use and joined at exit.
+ThreadPool& ThreadPool::shared() noexcept {
+    static ThreadPool pool;
+    return pool;
+}
+
+// try_take: Pops from the worker's own deque or steals from another one.
+// Parameters:
+//   index: Worker looking for work.
+//   task: Receives the task.
+//   stolen: Set to true when the task came from another worker.
+// Returns:
+//   True if a task was taken.
+// Own tasks are taken oldest-first to keep chunk reads roughly sequential; thieves take
+// from the back, away from the owner.
+bool ThreadPool::try_take(size_t index, std::function<void()>& task, bool& stolen) noexcept {
+    for (size_t step = 0; step < workers_.size(); ++step) {
+        Worker& victim = *workers_[(index + step) % workers_.size()];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if (victim.tasks.empty()) {
+            continue;
+        }
+        if (step == 0) {
+            task = std::move(victim.tasks.front());
+            victim.tasks.pop_front();
+        } else {
+            task = std::move(victim.tasks.back());
+            victim.tasks.pop_back();
+        }
+        stolen = step != 0;
+        return true;
+    }
+    return false;
+}
+
+// worker_loop: Runs tasks until the pool is stopped and drained.
+// Parameters:
+//   index: Worker whose deque is preferred.
+// Sleeps on the wake condition while no task is queued anywhere.
+void ThreadPool::worker_loop(size_t index) noexcept {
+    using clock = std::chrono::steady_clock;
+    Worker& self = *workers_[index];
+    for (;;) {
+        std::function<void()> task;
+        bool stolen = false;
+        if (try_take(index, task, stolen)) {
+            {
+                std::lock_guard<std::mutex> lock(wake_mutex_);
+                --pending_;
+            }
+            auto start = clock::now();
+            task();
+            self.busy_ns.fetch_add(std::chrono::duration_cast<std::chrono::nanoseconds>(clock::now() - start).count(),
+                                   std::memory_order_relaxed);
+            self.executed.fetch_add(1, std::memory_order_relaxed);
+            if (stolen) {
+                self.stolen.fetch_add(1, std::memory_order_relaxed);
+            }
+            continue;
+        }
+
+        auto start = clock::now();
+        std::unique_lock<std::mutex> lock(wake_mutex_);
+        wait_until_true(wake_, lock, [this]() { return pending_ > 0 || stopping_; });
+        bool exit = stopping_ && pending_ == 0;
+        lock.unlock();
+        self.idle_ns.fetch_add(std::chrono::duration_cast<std::chrono::nanoseconds>(clock::now() - start).count(),
+                               std::memory_order_relaxed);
+        if (exit) {
+            return;
+        }
+    }
+}
@@ -0,0 +1,40 @@
+// word_arena.cpp: Implementation of WordArena for per-chunk bump allocation.
+// This file hands out slices of large blocks and releases them together.
+
+#include "word_arena.hpp"
+#include <algorithm>
+
+// Constructor: Initializes an empty arena.
+// Parameters:
+//   block_size: Size of each regular block (at least one byte).
+WordArena::WordArena(size_t block_size) noexcept
+    : block_size_(std::max<size_t>(block_size, 1)), cursor_(nullptr), remaining_(0), reserved_(0) {
+}
+
+// allocate: Reserves uninitialized bytes from the current block.
+// Parameters:
+//   size: Number of bytes requested.
+// Returns:
+//   Pointer to the reserved bytes, valid until the arena is destroyed.
+// Starts a new block when the current one is too small; oversized requests get a
+// block of their own so the regular block size stays modest.
+char* WordArena::allocate(size_t size) noexcept {
+    if (size > remaining_) {
+        const size_t new_block = std::max(size, block_size_);
+        blocks_.emplace_back(new char[new_block]);
+        cursor_ = blocks_.back().get();
+        remaining_ = new_block;
+        reserved_ += new_block;
+    }
+    char* result = cursor_;
+    cursor_ += size;
+    remaining_ -= size;
+    return result;
+}
+
+// bytes_reserved: Reports the total size of all blocks owned by the arena.
+// Returns:
+//   Number of bytes held.
+size_t WordArena::bytes_reserved() const noexcept {
+    return reserved_;
+}
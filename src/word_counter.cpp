@@ -1,17 +1,141 @@
 // word_counter.cpp: Implementation of WordCounter for counting unique words.
-// This file merges sorted temporary files using a priority queue to count unique words.
+// This file merges sorted temporary files using a loser tree to count unique words.
 
 #include "word_counter.hpp"
-#include "file_word.hpp"
+#include "io_uring_file_handle.hpp"
+#include "loser_tree.hpp"
+#include "run_partition.hpp"
+#include "run_reader.hpp"
+#include "run_writer.hpp"
+#include <algorithm>
+#include <atomic>
+#include <functional>
+#include <limits>
 #include <queue>
 #include <string>
+#include <sys/resource.h>
+#include <sys/stat.h>
+
+namespace {
+
+// Descriptors kept free for the input, stdio and temporary files being created.
+constexpr size_t RESERVED_DESCRIPTORS = 64;
+
+// Smallest per-run read buffer when the run buffers are divided among partitions.
+constexpr size_t MIN_BLOCK_SIZE = 64ULL << 10;
+
+// reader_block_size: Per-run read buffer when readers share the given memory.
+// Each reader also owns RUN_QUEUE_DEPTH read-ahead blocks of the same size.
+size_t reader_block_size(size_t readers, size_t memory) noexcept {
+    const size_t buffers = std::max<size_t>(readers, 1) * (1 + IoUringFileHandle::RUN_QUEUE_DEPTH);
+    return std::max(MIN_BLOCK_SIZE, std::min(RunReader::DEFAULT_BLOCK_SIZE, memory / buffers));
+}
+
+// open_run: Opens a run for reading with block-sized read-ahead in the given cache mode.
+std::unique_ptr<FileHandle> open_run(const std::string& name, size_t block_size, CacheMode cache_mode) noexcept {
+    auto file = std::make_unique<IoUringFileHandle>(name.c_str(), O_RDONLY, 0, IoUringFileHandle::RUN_QUEUE_DEPTH,
+                                                    block_size);
+    if (file->is_open()) {
+        file->set_cache_mode(cache_mode);
+    }
+    return file;
+}
+
+// open_runs: Opens a reader over each whole run, exiting if one cannot be opened.
+void open_runs(const std::vector<std::string>& run_names, size_t block_size, CacheMode cache_mode,
+               std::vector<std::unique_ptr<RunReader>>& readers, std::vector<RunReader*>& sources) noexcept {
+    for (const auto& name : run_names) {
+        auto fd = open_run(name, block_size, cache_mode);
+        if (!fd->is_open()) {
+            ssize_t res = write(STDERR_FILENO, "Error: Could not open temp file\n", 31);
+            (void)res;
+            _exit(1);
+        }
+        readers.push_back(std::make_unique<RunReader>(std::move(fd), block_size));
+        sources.push_back(readers.back().get());
+    }
+}
+
+// check_readers: Exits if a merge stopped reading a run at an error instead of its end.
+// Parameters:
+//   readers: Readers of the merge.
+// A failed reader looks exhausted to the merge, so the count it fed would be short.
+void check_readers(const std::vector<std::unique_ptr<RunReader>>& readers) noexcept {
+    for (const auto& reader : readers) {
+        if (reader->failed()) {
+            ssize_t res = write(STDERR_FILENO, "Error: Could not read temp file\n", 32);
+            (void)res;
+            _exit(1);
+        }
+    }
+}
+
+// names_of: Paths of a list of runs.
+std::vector<std::string> names_of(const std::vector<TempFile>& temp_files) noexcept {
+    std::vector<std::string> run_names;
+    for (const auto& temp_file : temp_files) {
+        run_names.push_back(temp_file.name());
+    }
+    return run_names;
+}
+
+// total_size: Bytes on disk of a list of runs (runs that cannot be stat()ed count as empty).
+size_t total_size(const std::vector<std::string>& run_names) noexcept {
+    size_t bytes = 0;
+    for (const auto& name : run_names) {
+        struct stat st;
+        if (stat(name.c_str(), &st) == 0) {
+            bytes += static_cast<size_t>(st.st_size);
+        }
+    }
+    return bytes;
+}
+
+// merge_sources: Appends the distinct words of merged runs to a writer, summing the
+// counts of equal words.
+// Returns: Number of distinct words appended.
+size_t merge_sources(std::vector<RunReader*>& sources, RunWriter& writer) noexcept {
+    std::string last_word;
+    uint64_t last_count = 0;
+    bool has_last = false;
+    size_t words = 0;
+    LoserTree<RunReader> tree(sources);
+    while (!tree.empty()) {
+        std::string_view word = tree.top();
+        const uint64_t count = sources[tree.top_source()]->count();
+        if (has_last && last_word == word) {
+            last_count += count;
+        } else {
+            if (has_last) {
+                writer.append(last_word, last_count);
+                ++words;
+            }
+            last_word.assign(word.data(), word.size());
+            last_count = count;
+            has_last = true;
+        }
+        tree.pop();
+    }
+    if (has_last) {
+        writer.append(last_word, last_count);
+        ++words;
+    }
+    return words;
+}
+
+} // namespace
 
 // Constructor: Initializes WordCounter with a file handle.
 // Parameters:
 //   file_handle: Unique pointer to the file handle (used for validation).
+//   options: Merge parallelism and resource limits.
+//   pool: Worker pool that runs the merges.
 // Uses dependency injection for flexibility.
-WordCounter::WordCounter(std::unique_ptr<FileHandle> file_handle) noexcept
-    : file_handle_(std::move(file_handle)) {       
+WordCounter::WordCounter(std::unique_ptr<FileHandle> file_handle, Options options, ThreadPool& pool) noexcept
+    : file_handle_(std::move(file_handle)), options_(options), pool_(pool), stats_{0, 0, 0, 0, 0} {
+    if (options_.buffer_memory == 0) {
+        options_.buffer_memory = DEFAULT_BUFFER_MEMORY;
+    }
 }
 
 // count_unique_words: Counts unique words by merging sorted temporary files.
@@ -19,57 +143,407 @@ WordCounter::WordCounter(std::unique_ptr<FileHandle> file_handle) noexcept
 //   temp_files: Vector of TempFile objects containing sorted words.
 // Returns:
 //   Number of unique words across all temporary files.
-// Uses a priority queue to merge words in sorted order, counting unique occurrences.
+// Intermediate passes first reduce the runs to a number one merge may read; the
+// remaining runs are counted in one final pass.
 size_t WordCounter::count_unique_words(const std::vector<TempFile>& temp_files) noexcept {
-    // Priority queue to merge words from multiple files (min-heap).
-    std::priority_queue<FileWord, std::vector<FileWord>, std::greater<FileWord>> pq;
-    size_t unique_count = 0;
+    std::vector<TempFile> intermediate;
+    size_t budget;
+    std::vector<std::string> run_names = reduce_runs(names_of(temp_files), false, intermediate, budget);
+    return count_final(run_names, budget);
+}
+
+// merge_into: Merges runs into a caller's run writer.
+// Parameters:
+//   run_names: Paths of the runs.
+//   writer: Writer receiving the distinct words in order.
+//   words: Receives the number of distinct words appended.
+// Returns:
+//   True on success, false if a run could not be read to its end; the writer then
+//   holds a partial merge and must not be kept.
+// The runs are reduced to the fan-in first, like for a count; the writer is left open
+// so the caller can finish it with a footer of its own.
+bool WordCounter::merge_into(const std::vector<std::string>& run_names, RunWriter& writer, size_t& words) noexcept {
+    std::vector<TempFile> intermediate;
+    size_t budget;
+    std::vector<std::string> final_names = reduce_runs(run_names, false, intermediate, budget);
+    std::vector<std::unique_ptr<RunReader>> readers;
+    std::vector<RunReader*> sources;
+    open_runs(final_names, reader_block_size(final_names.size(), options_.buffer_memory), options_.cache_mode, readers,
+              sources);
+    words = merge_sources(sources, writer);
+    for (const auto& reader : readers) {
+        if (reader->failed()) {
+            ssize_t res = write(STDERR_FILENO, "Error: Could not read temp file\n", 32);
+            (void)res;
+            return false;
+        }
+    }
+    return true;
+}
+
+// count_frequencies: Counts every word's occurrences and finds the most frequent words.
+// Parameters:
+//   temp_files: Runs written with counts.
+//   top_k: Number of most frequent words to keep.
+//   visit: Called with every distinct word and its total, in word order; may be empty.
+// Returns:
+//   Unique and total word counts and the top_k words, most frequent first.
+// After any intermediate passes (which sum the counts of equal words), one loser tree
+// streams every word in order and adds up its counts across runs. A min-heap of at
+// most top_k entries keeps the best words seen so far; a word only becomes a string
+// when it beats the heap's weakest entry, so the scan allocates almost nothing.
+WordCounter::FrequencyReport WordCounter::count_frequencies(
+    const std::vector<TempFile>& temp_files, size_t top_k,
+    const std::function<void(std::string_view, uint64_t)>& visit) noexcept {
+    std::vector<TempFile> intermediate;
+    size_t budget;
+    std::vector<std::string> run_names = reduce_runs(names_of(temp_files), true, intermediate, budget);
+
+    std::vector<std::unique_ptr<RunReader>> readers;
+    std::vector<RunReader*> sources;
+    open_runs(run_names, reader_block_size(run_names.size(), options_.buffer_memory), options_.cache_mode, readers,
+              sources);
+
+    // ranks_before: Heap order; the top of the heap is the weakest entry.
+    auto ranks_before = [](const WordFrequency& a, const WordFrequency& b) {
+        return a.count != b.count ? a.count > b.count : a.word < b.word;
+    };
+    std::priority_queue<WordFrequency, std::vector<WordFrequency>, decltype(ranks_before)> heap(ranks_before);
+    FrequencyReport report{0, 0, {}};
+
+    // emit: Records one distinct word and its total count.
+    auto emit = [&](std::string_view word, uint64_t count) {
+        ++report.unique_words;
+        report.total_words += count;
+        if (visit) {
+            visit(word, count);
+        }
+        if (top_k == 0) {
+            return;
+        }
+        if (heap.size() < top_k) {
+            heap.push({std::string(word), count});
+        } else if (count > heap.top().count || (count == heap.top().count && word < heap.top().word)) {
+            heap.pop();
+            heap.push({std::string(word), count});
+        }
+    };
+
+    LoserTree<RunReader> tree(sources);
     std::string last_word;
+    uint64_t last_count = 0;
+    bool has_last = false;
+    while (!tree.empty()) {
+        std::string_view word = tree.top();
+        const uint64_t count = sources[tree.top_source()]->count();
+        if (has_last && last_word == word) {
+            last_count += count;
+        } else {
+            if (has_last) {
+                emit(last_word, last_count);
+            }
+            last_word.assign(word.data(), word.size());
+            last_count = count;
+            has_last = true;
+        }
+        tree.pop();
+    }
+    if (has_last) {
+        emit(last_word, last_count);
+    }
+    check_readers(readers);
 
-    // Initialize the priority queue with the first word from each temporary file.
-    for (const auto& temp_file : temp_files) {
-        auto fd = std::make_unique<SyscallFileHandle>(temp_file.name().c_str(), O_RDONLY);
-        if (!fd->is_open()) {
+    report.top.resize(heap.size());
+    for (size_t i = heap.size(); i > 0; --i) {
+        report.top[i - 1] = heap.top();
+        heap.pop();
+    }
+    return report;
+}
+
+// reduce_runs: Runs intermediate passes until the runs fit in one merge.
+// Parameters:
+//   run_names: Paths of the initial runs.
+//   counts: True to keep summed word counts in the merged runs.
+//   intermediate: Receives the last generation of merged runs.
+//   budget: Receives the run descriptor budget.
+// Returns:
+//   Paths of the runs for the final pass.
+// While there are more runs than one merge may read (the smaller of the fan-in and
+// the descriptor budget), intermediate passes merge groups of runs into larger runs
+// of their distinct words. Each generation of intermediate runs is deleted once the
+// next one is written. The final pass is counted in the stats, and so are the bytes it
+// will read.
+std::vector<std::string> WordCounter::reduce_runs(std::vector<std::string> run_names, bool counts,
+                                                  std::vector<TempFile>& intermediate, size_t& budget) noexcept {
+    stats_ = {run_names.size(), 0, 0, 0, 0};
+
+    budget = fd_budget();
+    const size_t fan_in = std::max<size_t>(2, std::min(options_.max_fan_in == 0 ? budget : options_.max_fan_in, budget));
+    while (run_names.size() > fan_in) {
+        stats_.bytes_read += total_size(run_names);
+        std::vector<TempFile> merged = merge_pass(run_names, fan_in, budget, counts);
+        ++stats_.passes;
+        run_names.clear();
+        for (const auto& run : merged) {
+            run_names.push_back(run.name());
+        }
+        intermediate = std::move(merged);
+    }
+    ++stats_.passes;
+    stats_.bytes_read += total_size(run_names);
+    return run_names;
+}
+
+// merge_stats: Reports the passes of the last count.
+// Returns:
+//   Run and pass counts, intermediate output volume and bytes read.
+WordCounter::MergeStats WordCounter::merge_stats() const noexcept {
+    return stats_;
+}
+
+// fd_budget: Number of run descriptors that may be open at once.
+// Returns:
+//   The configured budget, or RLIMIT_NOFILE minus RESERVED_DESCRIPTORS (at least 2).
+size_t WordCounter::fd_budget() const noexcept {
+    if (options_.fd_budget != 0) {
+        return std::max<size_t>(options_.fd_budget, 2);
+    }
+    struct rlimit limit;
+    if (getrlimit(RLIMIT_NOFILE, &limit) != 0 || limit.rlim_cur == RLIM_INFINITY) {
+        return 1ULL << 20;
+    }
+    return limit.rlim_cur > RESERVED_DESCRIPTORS + 2 ? limit.rlim_cur - RESERVED_DESCRIPTORS : 2;
+}
+
+// merge_pass: Merges groups of at most fan_in runs into larger runs, in parallel.
+// Parameters:
+//   run_names: Paths of the runs to merge.
+//   fan_in: Most runs per group.
+//   budget: Run descriptors that may be open at once.
+//   counts: True to keep summed word counts in the merged runs.
+// Returns:
+//   The merged runs, one per group.
+// Runs are split into the fewest groups of balanced size. Up to budget / fan_in
+// groups are merged at once, each by a pool task that claims groups until none remain.
+std::vector<TempFile> WordCounter::merge_pass(const std::vector<std::string>& run_names, size_t fan_in,
+                                              size_t budget, bool counts) noexcept {
+    const size_t groups = (run_names.size() + fan_in - 1) / fan_in;
+    std::vector<TempFile> outputs(groups);
+    const size_t workers = std::max<size_t>(1, std::min({pool_.size(), budget / fan_in, groups}));
+    const size_t block_size = reader_block_size(workers * fan_in, options_.buffer_memory);
+
+    std::atomic<size_t> next_group(0);
+    std::atomic<size_t> bytes(0);
+    std::vector<std::function<void()>> tasks;
+    for (size_t w = 0; w < workers; ++w) {
+        tasks.emplace_back([&]() {
+            for (size_t g = next_group++; g < groups; g = next_group++) {
+                std::vector<std::string> group(run_names.begin() + g * run_names.size() / groups,
+                                               run_names.begin() + (g + 1) * run_names.size() / groups);
+                bytes += merge_to_run(group, outputs[g].name(), block_size, counts, options_.cache_mode);
+            }
+        });
+    }
+    pool_.run_all(std::move(tasks));
+
+    stats_.intermediate_runs += groups;
+    stats_.bytes_rewritten += bytes.load();
+    return outputs;
+}
+
+// count_final: Counts the unique words of runs that fit in one pass.
+// Parameters:
+//   run_names: Paths of the runs.
+//   budget: Run descriptors that may be open at once.
+// Returns:
+//   Number of unique words.
+// Splitter words taken from the runs' block indexes cut the key space into disjoint
+// ranges, and each run's index maps every range to a slice of whole blocks. Every
+// range is then merged by its own pool task over the matching slice of each run,
+// counting only the words inside the range. A word belongs to exactly one range,
+// so the partial counts add up to the exact total.
+size_t WordCounter::count_final(const std::vector<std::string>& run_names, size_t budget) noexcept {
+    std::vector<run_format::RunIndex> indexes(run_names.size());
+    std::vector<bool> counted(run_names.size(), false);
+    size_t total_bytes = 0;
+    bool indexed = true;
+    for (size_t r = 0; r < run_names.size(); ++r) {
+        SyscallFileHandle run(run_names[r].c_str(), O_RDONLY);
+        if (!run.is_open()) {
             ssize_t res = write(STDERR_FILENO, "Error: Could not open temp file\n", 31);
             (void)res;
             _exit(1);
         }
-
-        // Read the first word from the file.
-        std::string word;
-        char c;
-        // Read until space or newline
-        while (fd->read(&c, 1) == 1 && c != ' ' && c != '\n') {
-            word += c;
+        // Runs without an index (e.g. empty files) can only be merged whole.
+        if (run_format::read_run_index(run, indexes[r])) {
+            total_bytes += static_cast<size_t>(indexes[r].data_end);
+            counted[r] = (indexes[r].flags & run_format::FLAG_COUNTS) != 0;
+        } else if (run.seek(0, SEEK_END) > 0) {
+            indexed = false;
         }
+    }
 
-        if (!word.empty()) {
-            pq.push({std::move(word), std::move(fd)});
-        }
+    std::vector<std::string> splitters;
+    if (indexed) {
+        splitters = sample_splitters(indexes, plan_partitions(run_names.size(), total_bytes, budget));
+    }
+    const size_t partitions = splitters.size() + 1;
+    const size_t block_size = reader_block_size(partitions * run_names.size(), options_.buffer_memory);
+    if (partitions == 1) {
+        std::vector<off_t> whole(run_names.size(), 0);
+        std::vector<off_t> ends(run_names.size(), std::numeric_limits<off_t>::max());
+        return merge_range(run_names, whole, ends, counted, block_size, std::string_view(), nullptr,
+                           options_.cache_mode);
     }
 
-    // Merge words from the priority queue, counting unique words.
-    while (!pq.empty()) {
-        FileWord file_word = std::move(const_cast<FileWord&>(pq.top()));
-        pq.pop();        
+    std::vector<size_t> counts(partitions, 0);
+    std::vector<std::function<void()>> tasks;
+    for (size_t p = 0; p < partitions; ++p) {
+        tasks.emplace_back([&, p]() {
+            std::vector<off_t> begins(run_names.size());
+            std::vector<off_t> ends(run_names.size());
+            for (size_t r = 0; r < run_names.size(); ++r) {
+                const auto& index = indexes[r];
+                if (index.blocks.empty()) {
+                    begins[r] = ends[r] = 0;
+                    continue;
+                }
+                begins[r] = p == 0 ? index.blocks.front().offset : slice_begin(index, splitters[p - 1]);
+                ends[r] = p + 1 == partitions ? index.data_end : slice_end(index, splitters[p]);
+            }
+            counts[p] = merge_range(run_names, begins, ends, counted, block_size,
+                                    p == 0 ? std::string_view() : std::string_view(splitters[p - 1]),
+                                    p + 1 == partitions ? nullptr : &splitters[p], options_.cache_mode);
+        });
+    }
+    pool_.run_all(std::move(tasks));
 
-        // Count unique word if it differs from the last word.
-        if (last_word != file_word.word) {
-            ++unique_count;
-            last_word = file_word.word;
+    size_t unique_count = 0;
+    for (size_t count : counts) {
+        unique_count += count;
+    }
+    return unique_count;
+}
+
+// plan_partitions: Chooses how many key ranges to merge in parallel.
+// Parameters:
+//   run_count: Number of runs.
+//   total_bytes: Combined size of the runs.
+//   budget: Run descriptors that may be open at once.
+// Returns:
+//   Partition count: the requested one, or one per pool worker while every
+//   partition still gets MIN_PARTITION_BYTES of data. Either way every partition
+//   must hold one descriptor per run within the budget.
+size_t WordCounter::plan_partitions(size_t run_count, size_t total_bytes, size_t budget) const noexcept {
+    size_t partitions = options_.partitions;
+    if (partitions == 0) {
+        partitions = std::min(pool_.size(), std::max<size_t>(1, total_bytes / MIN_PARTITION_BYTES));
+    }
+    if (run_count > 0) {
+        partitions = std::min(partitions, std::max<size_t>(1, budget / run_count));
+    }
+    return std::max<size_t>(partitions, 1);
+}
+
+// merge_to_run: Merges whole runs into one run of their distinct words.
+// Parameters:
+//   run_names: Paths of the runs.
+//   output_name: Path of the run to write.
+//   block_size: Read buffer size per run.
+//   counts: True to write a counting run with the summed counts of each word.
+//   cache_mode: Page cache use of the runs.
+// Returns:
+//   Bytes written to the output run.
+size_t WordCounter::merge_to_run(const std::vector<std::string>& run_names, const std::string& output_name,
+                                 size_t block_size, bool counts, CacheMode cache_mode) noexcept {
+    std::vector<std::unique_ptr<RunReader>> readers;
+    std::vector<RunReader*> sources;
+    open_runs(run_names, block_size, cache_mode, readers, sources);
+
+    auto output = std::make_unique<IoUringFileHandle>(output_name.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0600,
+                                                      IoUringFileHandle::RUN_QUEUE_DEPTH, RunWriter::DEFAULT_BLOCK_SIZE);
+    if (!output->is_open()) {
+        ssize_t res = write(STDERR_FILENO, "Error: Could not open temp file for writing\n", 43);
+        (void)res;
+        _exit(1);
+    }
+    output->set_cache_mode(cache_mode);
+    RunWriter writer(std::move(output), RunWriter::DEFAULT_BLOCK_SIZE, counts);
+    merge_sources(sources, writer);
+    check_readers(readers);
+    if (!writer.finish()) {
+        ssize_t res = write(STDERR_FILENO, "Error: Could not write temp file\n", 32);
+        (void)res;
+        _exit(1);
+    }
+    return writer.bytes_written();
+}
+
+// merge_range: Counts the unique words of one key range in a slice of every run.
+// Parameters:
+//   run_names: Paths of the runs.
+//   begins: Offset of the slice start in each run.
+//   ends: Offset of the slice end in each run.
+//   counted: Whether each run stores word counts.
+//   block_size: Read buffer size per run.
+//   lower: Smallest word counted.
+//   upper: Exclusive upper bound, or nullptr.
+//   cache_mode: Page cache use of the runs.
+// Returns:
+//   Number of unique words in the range.
+// Uses a loser tree over buffered run readers to merge words in sorted order,
+// counting unique occurrences.
+size_t WordCounter::merge_range(const std::vector<std::string>& run_names, const std::vector<off_t>& begins,
+                                const std::vector<off_t>& ends, const std::vector<bool>& counted,
+                                size_t block_size, std::string_view lower, const std::string* upper,
+                                CacheMode cache_mode) noexcept {
+    size_t unique_count = 0;
+    std::string last_word;
+    bool has_last = false;
+
+    // One buffered reader per run slice; the loser tree merges views into their buffers.
+    std::vector<std::unique_ptr<RunReader>> readers;
+    std::vector<RunReader*> sources;
+    readers.reserve(run_names.size());
+    sources.reserve(run_names.size());
+
+    for (size_t r = 0; r < run_names.size(); ++r) {
+        if (ends[r] <= begins[r]) {
+            continue;
         }
+        auto fd = open_run(run_names[r], block_size, cache_mode);
+        if (!fd->is_open() || fd->seek(begins[r], SEEK_SET) == -1) {
+            ssize_t res = write(STDERR_FILENO, "Error: Could not open temp file\n", 31);
+            (void)res;
+            _exit(1);
+        }
+        const size_t length = ends[r] == std::numeric_limits<off_t>::max()
+                                  ? std::numeric_limits<size_t>::max()
+                                  : static_cast<size_t>(ends[r] - begins[r]);
+        readers.push_back(std::make_unique<RunReader>(std::move(fd), block_size, length, counted[r]));
+        sources.push_back(readers.back().get());
+    }
 
-        // Read the next word from the same file.
-        std::string next_word;
-        char c;
-        while (file_word.file->read(&c, 1) == 1 && c != '\n') {
-            next_word += c;
+    // Merge words in sorted order, counting unique words.
+    LoserTree<RunReader> tree(std::move(sources));
+    while (!tree.empty()) {
+        std::string_view word = tree.top();
+        if (upper != nullptr && word >= *upper) {
+            break;
         }
-        if (!next_word.empty()) {
-            // Push the next word and its file handle back to the priority queue.
-            pq.push({std::move(next_word), std::move(file_word.file)});
+
+        // Count unique word if it differs from the last word and lies in the range.
+        if ((!has_last || last_word != word) && word >= lower) {
+            ++unique_count;
+            last_word.assign(word.data(), word.size());
+            has_last = true;
         }
+
+        // Advance the winning run; this invalidates word.
+        tree.pop();
     }
+    check_readers(readers);
 
     return unique_count;
 }
@@ -0,0 +1,312 @@
+// word_generator.cpp: Implementation of WordGenerator for synthetic test inputs.
+// This file draws the vocabulary, samples Zipf ranks with an alias table and writes
+// independently seeded blocks in parallel, in output order.
+
+#include "word_generator.hpp"
+#include "thread_pool.hpp"
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <string_view>
+#include <unordered_set>
+
+namespace {
+
+// Longest supported word; keeps the capacity arithmetic in range.
+constexpr size_t MAX_WORD_LENGTH = 64;
+
+// Odd multiplier spreading block indexes over the seed space.
+constexpr uint64_t BLOCK_SEED_STEP = 0x6a09e667f3bcc909ULL;
+
+// next_random: Advances a SplitMix64 state and returns 64 random bits.
+// SplitMix64 is defined bit for bit, unlike the std distributions, so outputs are the
+// same with every compiler and standard library.
+inline uint64_t next_random(uint64_t& state) noexcept {
+    uint64_t z = (state += 0x9e3779b97f4a7c15ULL);
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+    return z ^ (z >> 31);
+}
+
+// bounded: Random value in [0, limit) by multiply-shift.
+inline uint64_t bounded(uint64_t& state, uint64_t limit) noexcept {
+    return static_cast<uint64_t>((static_cast<unsigned __int128>(next_random(state)) * limit) >> 64);
+}
+
+// unit: Random double in [0, 1).
+inline double unit(uint64_t& state) noexcept {
+    return static_cast<double>(next_random(state) >> 11) * 0x1.0p-53;
+}
+
+// write_all: Writes a whole buffer, retrying short writes.
+bool write_all(FileHandle& output, const std::string& data) noexcept {
+    size_t offset = 0;
+    while (offset < data.size()) {
+        const ssize_t res = output.write(data.data() + offset, data.size() - offset);
+        if (res <= 0) {
+            return false;
+        }
+        offset += static_cast<size_t>(res);
+    }
+    return true;
+}
+
+} // namespace
+
+// Constructor: Draws the vocabulary and prepares the samplers.
+// Parameters:
+//   options: What to generate.
+// Vocabulary words are drawn from one stream seeded by options.seed, and duplicates
+// are redrawn, so the vocabulary depends only on the seed and the length options.
+WordGenerator::WordGenerator(Options options) noexcept
+    : options_(std::move(options)), valid_(false), words_written_(0), bytes_written_(0) {
+    const size_t lengths = options_.max_length - options_.min_length + 1;
+    if (options_.min_length == 0 || options_.max_length < options_.min_length ||
+        options_.max_length > MAX_WORD_LENGTH || options_.vocabulary == 0 || options_.vocabulary > UINT32_MAX ||
+        !(options_.skew >= 0.0) || (options_.bytes == 0 && options_.words == 0) ||
+        options_.block_size <= options_.max_length ||
+        (!options_.length_weights.empty() && options_.length_weights.size() != lengths)) {
+        return;
+    }
+    std::vector<double> length_weights = options_.length_weights;
+    if (length_weights.empty()) {
+        length_weights.assign(lengths, 1.0);
+    }
+    // Only lengths that can be drawn add distinct words; half of them must be enough,
+    // so redrawing duplicates stays cheap.
+    double capacity = 0.0;
+    double weight_sum = 0.0;
+    for (size_t i = 0; i < lengths; ++i) {
+        if (!(length_weights[i] >= 0.0)) {
+            return;
+        }
+        weight_sum += length_weights[i];
+        capacity += length_weights[i] > 0.0 ? std::pow(26.0, static_cast<double>(options_.min_length + i)) : 0.0;
+    }
+    if (weight_sum <= 0.0 || static_cast<double>(options_.vocabulary) > capacity / 2) {
+        return;
+    }
+    valid_ = true;
+
+    const AliasTable length_table = build_alias(length_weights);
+    uint64_t state = options_.seed;
+    words_.reserve(options_.vocabulary);
+    std::unordered_set<std::string_view> drawn;
+    drawn.reserve(options_.vocabulary);
+    while (words_.size() < options_.vocabulary) {
+        std::string word(options_.min_length + sample(length_table, state), 'a');
+        for (auto& c : word) {
+            c = static_cast<char>('a' + bounded(state, 26));
+        }
+        // The vocabulary was reserved, so views of earlier words stay valid.
+        words_.push_back(std::move(word));
+        if (!drawn.insert(words_.back()).second) {
+            words_.pop_back();
+        }
+    }
+
+    if (options_.skew > 0.0) {
+        std::vector<double> rank_weights(options_.vocabulary);
+        for (size_t rank = 0; rank < rank_weights.size(); ++rank) {
+            rank_weights[rank] = std::pow(static_cast<double>(rank + 1), -options_.skew);
+        }
+        ranks_ = build_alias(rank_weights);
+    }
+    marks_.reset(new std::atomic<uint64_t>[(options_.vocabulary + 63) / 64]);
+}
+
+// valid: Checks that the options can be satisfied.
+// Returns:
+//   True if the vocabulary was drawn.
+bool WordGenerator::valid() const noexcept {
+    return valid_;
+}
+
+// generate: Writes the words.
+// Parameters:
+//   output: File to append the words to.
+// Returns:
+//   True on success, false on a write error or invalid options.
+// Each round, every worker fills one block buffer while one more task writes the
+// previous round's buffers in block order, so generation overlaps the writes and two
+// sets of buffers are enough. A block's words depend only on the seed and its index.
+bool WordGenerator::generate(FileHandle& output) noexcept {
+    if (!valid_) {
+        return false;
+    }
+    for (size_t i = 0; i < (options_.vocabulary + 63) / 64; ++i) {
+        marks_[i].store(0, std::memory_order_relaxed);
+    }
+    words_written_ = 0;
+    bytes_written_ = 0;
+
+    ThreadPool pool(options_.threads);
+    const size_t workers = pool.size();
+    const size_t blocks = block_count();
+    const size_t rounds = (blocks + workers - 1) / workers;
+    std::vector<std::string> buffers(2 * workers);
+    std::vector<size_t> counts(2 * workers, 0);
+    bool written = true;
+    for (size_t round = 0; round <= rounds; ++round) {
+        std::vector<std::function<void()>> tasks;
+        const size_t slots = round % 2 * workers;
+        for (size_t i = 0; round < rounds && i < workers && round * workers + i < blocks; ++i) {
+            tasks.push_back([this, &buffers, &counts, block = round * workers + i, slot = slots + i]() {
+                counts[slot] = generate_block(block, buffers[slot]);
+            });
+        }
+        if (round > 0) {
+            const size_t previous = (round - 1) % 2 * workers;
+            const size_t filled = std::min(workers, blocks - (round - 1) * workers);
+            tasks.push_back([this, &output, &buffers, &counts, &written, previous, filled]() {
+                for (size_t i = previous; i < previous + filled && written; ++i) {
+                    written = write_all(output, buffers[i]);
+                    words_written_ += counts[i];
+                    bytes_written_ += buffers[i].size();
+                }
+            });
+        }
+        pool.run_all(std::move(tasks));
+    }
+    return written;
+}
+
+// unique_count: Distinct words in the written output.
+// Returns:
+//   Number of marked vocabulary words.
+size_t WordGenerator::unique_count() const noexcept {
+    if (!valid_) {
+        return 0;
+    }
+    size_t unique = 0;
+    for (size_t i = 0; i < (options_.vocabulary + 63) / 64; ++i) {
+        unique += static_cast<size_t>(__builtin_popcountll(marks_[i].load(std::memory_order_relaxed)));
+    }
+    return unique;
+}
+
+// words_written: Words in the written output.
+// Returns:
+//   Word count.
+size_t WordGenerator::words_written() const noexcept {
+    return words_written_;
+}
+
+// bytes_written: Bytes in the written output.
+// Returns:
+//   Byte count.
+size_t WordGenerator::bytes_written() const noexcept {
+    return bytes_written_;
+}
+
+// vocabulary: Words by Zipf rank.
+// Returns:
+//   The drawn vocabulary.
+const std::vector<std::string>& WordGenerator::vocabulary() const noexcept {
+    return words_;
+}
+
+// build_alias: Prepares a sampler for weights that need not be normalized.
+// Parameters:
+//   weights: Non-negative weights with a positive sum.
+// Returns:
+//   Alias table with one slot per weight.
+// Vose's method pairs every under-full slot with an over-full one, so a draw costs one
+// bounded random slot and one comparison, independent of the vocabulary size.
+WordGenerator::AliasTable WordGenerator::build_alias(const std::vector<double>& weights) noexcept {
+    const size_t n = weights.size();
+    double sum = 0.0;
+    for (double weight : weights) {
+        sum += weight;
+    }
+    AliasTable table;
+    table.probability.resize(n);
+    table.alias.resize(n);
+    std::vector<double> scaled(n);
+    std::vector<uint32_t> small;
+    std::vector<uint32_t> large;
+    for (size_t i = 0; i < n; ++i) {
+        scaled[i] = weights[i] * static_cast<double>(n) / sum;
+        (scaled[i] < 1.0 ? small : large).push_back(static_cast<uint32_t>(i));
+    }
+    while (!small.empty() && !large.empty()) {
+        const uint32_t under = small.back();
+        const uint32_t over = large.back();
+        small.pop_back();
+        table.probability[under] = scaled[under];
+        table.alias[under] = over;
+        scaled[over] -= 1.0 - scaled[under];
+        if (scaled[over] < 1.0) {
+            large.pop_back();
+            small.push_back(over);
+        }
+    }
+    // Leftovers are full up to rounding error.
+    for (uint32_t i : large) {
+        table.probability[i] = 1.0;
+        table.alias[i] = i;
+    }
+    for (uint32_t i : small) {
+        table.probability[i] = 1.0;
+        table.alias[i] = i;
+    }
+    return table;
+}
+
+// sample: Draws a slot from a sampler.
+// Parameters:
+//   table: Alias table.
+//   state: Random state.
+// Returns:
+//   Slot index.
+size_t WordGenerator::sample(const AliasTable& table, uint64_t& state) noexcept {
+    const size_t slot = static_cast<size_t>(bounded(state, table.probability.size()));
+    return unit(state) < table.probability[slot] ? slot : table.alias[slot];
+}
+
+// block_count: Number of blocks of the output.
+// Returns:
+//   Blocks of block_size bytes, or of block_size / 8 words for a word target.
+size_t WordGenerator::block_count() const noexcept {
+    if (options_.words != 0) {
+        const size_t block_words = std::max<size_t>(1, options_.block_size / 8);
+        return (options_.words + block_words - 1) / block_words;
+    }
+    return (options_.bytes + options_.block_size - 1) / options_.block_size;
+}
+
+// generate_block: Fills a buffer with one block's words.
+// Parameters:
+//   block: Block index.
+//   out: Buffer receiving the words, each followed by a space.
+// Returns:
+//   Number of words in the buffer.
+// A block ends with the word that reaches its byte quota, so sizes overshoot the target
+// by less than one word per block; word targets are met exactly.
+size_t WordGenerator::generate_block(size_t block, std::string& out) noexcept {
+    size_t word_quota = SIZE_MAX;
+    size_t byte_quota = SIZE_MAX;
+    if (options_.words != 0) {
+        const size_t block_words = std::max<size_t>(1, options_.block_size / 8);
+        word_quota = std::min(block_words, options_.words - block * block_words);
+    } else {
+        byte_quota = std::min(options_.block_size, options_.bytes - block * options_.block_size);
+    }
+    uint64_t state = options_.seed ^ (BLOCK_SEED_STEP * (block + 1));
+    out.clear();
+    size_t count = 0;
+    while (count < word_quota && out.size() < byte_quota) {
+        const size_t rank = ranks_.probability.empty() ? static_cast<size_t>(bounded(state, words_.size()))
+                                                       : sample(ranks_, state);
+        out += words_[rank];
+        out += ' ';
+        ++count;
+        // Hot words are read-only after their first write, so threads do not contend on them.
+        std::atomic<uint64_t>& mark = marks_[rank / 64];
+        const uint64_t bit = 1ULL << (rank % 64);
+        if ((mark.load(std::memory_order_relaxed) & bit) == 0) {
+            mark.fetch_or(bit, std::memory_order_relaxed);
+        }
+    }
+    return count;
+}
@@ -0,0 +1,50 @@
+// test_approx_counter.cpp: Unit tests for the approximate ApproxCounter mode.
+// Verifies that chunked, multi-threaded sketching matches a single sketch of the file.
+
+#include "approx_counter.hpp"
+#include "temp_file.hpp"
+#include "test_support.hpp"
+#include <gtest/gtest.h>
+#include <cmath>
+#include <string>
+
+// Test: Tiny chunks give exactly the sketch of the whole word sequence.
+TEST(ApproxCounterTest, MatchesSingleSketch) {
+    std::string content;
+    HyperLogLog expected;
+    for (size_t i = 0; i < 30000; ++i) {
+        std::string word = "w" + std::to_string(i * 7919 % 12000);
+        content += word + " ";
+        expected.add(word);
+    }
+    TempFile input;
+    const std::string& filename = write_file(input.name(), content);
+    ApproxCounter counter(std::make_unique<SyscallFileHandle>(filename.c_str(), O_RDONLY), content.size(),
+                          HyperLogLog::DEFAULT_PRECISION, 4096);
+    HyperLogLog sketch = counter.count();
+    EXPECT_DOUBLE_EQ(sketch.estimate(), expected.estimate());
+    EXPECT_LE(std::fabs(sketch.estimate() - 12000.0), 4.0 * sketch.standard_error() * 12000.0);
+}
+
+// Test: Reading the input as a stream gives the same sketch as claiming file chunks.
+TEST(ApproxCounterTest, StreamMatchesFileScan) {
+    std::string content;
+    for (size_t i = 0; i < 30000; ++i) {
+        content += "w" + std::to_string(i * 7919 % 12000) + " ";
+    }
+    TempFile input;
+    const std::string& filename = write_file(input.name(), content);
+    ApproxCounter file_counter(std::make_unique<SyscallFileHandle>(filename.c_str(), O_RDONLY), content.size(),
+                               HyperLogLog::DEFAULT_PRECISION, 4096);
+    ApproxCounter stream_counter(std::make_unique<SyscallFileHandle>(filename.c_str(), O_RDONLY), 0,
+                                 HyperLogLog::DEFAULT_PRECISION, 4096);
+    EXPECT_DOUBLE_EQ(stream_counter.count_stream().estimate(), file_counter.count().estimate());
+}
+
+// Test: An empty input estimates zero.
+TEST(ApproxCounterTest, EmptyInputEstimatesZero) {
+    TempFile input;
+    const std::string& filename = write_file(input.name(), "");
+    ApproxCounter counter(std::make_unique<SyscallFileHandle>(filename.c_str(), O_RDONLY), 0);
+    EXPECT_DOUBLE_EQ(counter.count().estimate(), 0.0);
+}
@@ -0,0 +1,69 @@
+// test_bounded_queue.cpp: Unit tests for the BoundedQueue stage hand-off.
+// Verifies FIFO order, back-pressure on a full queue, and draining after close.
+
+#include "bounded_queue.hpp"
+#include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <thread>
+#include <vector>
+
+// Test: Items come out in the order they were pushed.
+TEST(BoundedQueueTest, PreservesOrder) {
+    BoundedQueue<int> queue(4);
+    for (int i = 0; i < 4; ++i) {
+        EXPECT_TRUE(queue.push(i));
+    }
+    EXPECT_EQ(queue.size(), 4u);
+    for (int i = 0; i < 4; ++i) {
+        int item = -1;
+        ASSERT_TRUE(queue.pop(item));
+        EXPECT_EQ(item, i);
+    }
+}
+
+// Test: A producer blocks on a full queue until the consumer makes room.
+TEST(BoundedQueueTest, FullQueueBlocksProducer) {
+    BoundedQueue<int> queue(1);
+    ASSERT_TRUE(queue.push(1));
+    std::atomic<bool> pushed(false);
+    std::thread producer([&]() {
+        queue.push(2);
+        pushed = true;
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    EXPECT_FALSE(pushed.load());
+
+    int item = 0;
+    ASSERT_TRUE(queue.pop(item));
+    EXPECT_EQ(item, 1);
+    producer.join();
+    EXPECT_TRUE(pushed.load());
+    ASSERT_TRUE(queue.pop(item));
+    EXPECT_EQ(item, 2);
+}
+
+// Test: After close, queued items drain, then pop reports the end and push fails.
+TEST(BoundedQueueTest, CloseDrainsThenEnds) {
+    BoundedQueue<std::unique_ptr<int>> queue(2);
+    ASSERT_TRUE(queue.push(std::make_unique<int>(7)));
+    queue.close();
+    EXPECT_FALSE(queue.push(std::make_unique<int>(8)));
+
+    std::unique_ptr<int> item;
+    ASSERT_TRUE(queue.pop(item));
+    EXPECT_EQ(*item, 7);
+    EXPECT_FALSE(queue.pop(item));
+}
+
+// Test: Close wakes a consumer waiting on an empty queue.
+TEST(BoundedQueueTest, CloseWakesConsumer) {
+    BoundedQueue<int> queue(1);
+    std::thread consumer([&]() {
+        int item = 0;
+        EXPECT_FALSE(queue.pop(item));
+    });
+    queue.close();
+    consumer.join();
+}
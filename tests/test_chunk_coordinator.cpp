@@ -0,0 +1,180 @@
+// test_chunk_coordinator.cpp: Unit tests for ChunkCoordinator chunking and end-to-end counting.
+// Verifies that chunk boundaries never split words, so the unique count stays exact.
+
+#include "chunk_coordinator.hpp"
+#include "test_support.hpp"
+#include "word_counter.hpp"
+#include <gtest/gtest.h>
+#include <string>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+// Helper function: counts unique words in a file using the given nominal chunk size.
+static size_t count_with_chunk_size(const std::string& filename, size_t size, size_t chunk_size) {
+    ChunkCoordinator coordinator(std::make_unique<SyscallFileHandle>(filename.c_str(), O_RDONLY),
+                                 std::make_unique<SpaceSeparatedParser>(), size, chunk_size);
+    std::vector<TempFile> temp_files;
+    EXPECT_TRUE(coordinator.process_chunks(temp_files));
+    WordCounter counter(std::make_unique<SyscallFileHandle>(filename.c_str(), O_RDONLY));
+    return counter.count_unique_words(temp_files);
+}
+
+// Test: The README example yields 4 unique words.
+TEST(ChunkCoordinatorTest, CountsReadmeExample) {
+    std::string content = "a horse and a dog";
+    TempFile input;
+    const std::string& filename = write_file(input.name(), content);
+    EXPECT_EQ(count_with_chunk_size(filename, content.size(), ChunkCoordinator::DEFAULT_CHUNK_SIZE), 4u);
+}
+
+// Test: Tiny chunks that would cut through words still produce an exact count.
+TEST(ChunkCoordinatorTest, BoundariesDoNotSplitWords) {
+    std::string content = "alphabet soup alphabet zebra soup quiz alphabet";
+    TempFile input;
+    const std::string& filename = write_file(input.name(), content);
+    for (size_t chunk_size = 1; chunk_size <= content.size(); ++chunk_size) {
+        EXPECT_EQ(count_with_chunk_size(filename, content.size(), chunk_size), 4u) << "chunk_size=" << chunk_size;
+    }
+}
+
+// Test: An empty input produces no chunks and a zero count.
+TEST(ChunkCoordinatorTest, EmptyInputReturnsZero) {
+    TempFile input;
+    const std::string& filename = write_file(input.name(), "");
+    EXPECT_EQ(count_with_chunk_size(filename, 0, 4), 0u);
+}
+
+// Test: The average word length is sampled from the start offset on.
+TEST(ChunkCoordinatorTest, SamplesBytesPerWord) {
+    std::string content = "a horse and a dog ant bee cat";
+    TempFile input;
+    const std::string& filename = write_file(input.name(), content);
+    SyscallFileHandle file(filename.c_str(), O_RDONLY);
+    EXPECT_DOUBLE_EQ(ChunkCoordinator::sample_bytes_per_word(file, 0, content.size()), content.size() / 8.0);
+    EXPECT_DOUBLE_EQ(ChunkCoordinator::sample_bytes_per_word(file, 18, content.size()), 11 / 3.0);
+}
+
+// Test: Threads snapping boundaries through one shared handle do not disturb each other.
+TEST(ChunkCoordinatorTest, FindsChunkEndsThroughSharedHandle) {
+    std::string content;
+    for (int i = 0; i < 2000; ++i) {
+        content += "word" + std::to_string(i % 97) + ' ';
+    }
+    TempFile input;
+    const std::string& filename = write_file(input.name(), content);
+    SyscallFileHandle file(filename.c_str(), O_RDONLY);
+    std::vector<off_t> expected;
+    for (size_t nominal = 0; nominal < content.size(); nominal += 37) {
+        expected.push_back(static_cast<off_t>(content.find(' ', nominal)));
+    }
+    std::vector<std::vector<off_t>> found(4);
+    std::vector<std::thread> threads;
+    for (size_t t = 0; t < found.size(); ++t) {
+        threads.emplace_back([&, t]() {
+            for (int round = 0; round < 20; ++round) {
+                found[t].clear();
+                for (size_t nominal = 0; nominal < content.size(); nominal += 37) {
+                    found[t].push_back(
+                        ChunkCoordinator::find_chunk_end(file, static_cast<off_t>(nominal), content.size()));
+                }
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    for (const auto& ends : found) {
+        EXPECT_EQ(ends, expected);
+    }
+}
+
+// Test: Memory plans stay within the budget and use the largest chunks that keep workers busy.
+TEST(ChunkCoordinatorTest, PlansChunksWithinMemoryLimit) {
+    for (size_t limit : {1ULL << 20, 64ULL << 20, 1ULL << 30, 64ULL << 30}) {
+        for (double bytes_per_word : {2.0, 8.0, 40.0}) {
+            auto plan = ChunkCoordinator::plan_memory(limit, bytes_per_word, 8);
+            double cost = 1.0 + ChunkCoordinator::WORD_OVERHEAD / bytes_per_word;
+            EXPECT_LE(plan.in_flight * plan.chunk_size * cost, static_cast<double>(limit));
+            EXPECT_GE(plan.in_flight, 1u);
+            EXPECT_LE(plan.in_flight, 10u);
+            EXPECT_LE(plan.chunk_size, ChunkCoordinator::DEFAULT_CHUNK_SIZE);
+        }
+    }
+    // A generous budget keeps the default chunk size and one chunk per worker plus two.
+    auto large = ChunkCoordinator::plan_memory(64ULL << 30, 8.0, 8);
+    EXPECT_EQ(large.chunk_size, ChunkCoordinator::DEFAULT_CHUNK_SIZE);
+    EXPECT_EQ(large.in_flight, 10u);
+    // A tight budget holds fewer chunks rather than shrinking them below the minimum.
+    auto tight = ChunkCoordinator::plan_memory(100ULL << 20, 8.0, 8);
+    EXPECT_LT(tight.in_flight, 10u);
+    EXPECT_GE(tight.chunk_size, ChunkCoordinator::MIN_CHUNK_SIZE);
+}
+
+// Test: A memory-limited run still counts exactly and records its plan.
+TEST(ChunkCoordinatorTest, MemoryLimitedRunCountsExactly) {
+    std::string content;
+    for (size_t i = 0; i < 20000; ++i) {
+        content += "w" + std::to_string(i % 7000) + " ";
+    }
+    TempFile input;
+    const std::string& filename = write_file(input.name(), content);
+    ChunkCoordinator coordinator(std::make_unique<SyscallFileHandle>(filename.c_str(), O_RDONLY),
+                                 std::make_unique<SpaceSeparatedParser>(), content.size());
+    coordinator.set_memory_limit(1ULL << 20);
+    std::vector<TempFile> temp_files;
+    EXPECT_TRUE(coordinator.process_chunks(temp_files));
+    auto plan = coordinator.memory_plan();
+    EXPECT_EQ(plan.in_flight, 1u);
+    EXPECT_GT(temp_files.size(), 1u);
+    WordCounter counter(nullptr);
+    EXPECT_EQ(counter.count_unique_words(temp_files), 7000u);
+}
+
+// Test: A piped input is chunked without stat() or seeking and counts exactly under a memory limit.
+TEST(ChunkCoordinatorTest, ProcessesStreamedInput) {
+    std::string content;
+    for (size_t i = 0; i < 20000; ++i) {
+        content += "w" + std::to_string(i % 7000) + " ";
+    }
+    int fds[2];
+    ASSERT_EQ(pipe(fds), 0);
+    std::thread writer([&content, fd = fds[1]]() {
+        for (size_t offset = 0; offset < content.size(); offset += 1000) {
+            ssize_t res = write(fd, content.data() + offset, std::min<size_t>(1000, content.size() - offset));
+            (void)res;
+        }
+        close(fd);
+    });
+    ChunkCoordinator coordinator(std::make_unique<SyscallFileHandle>(fds[0]), std::make_unique<SpaceSeparatedParser>(),
+                                 0, 10000);
+    std::vector<TempFile> temp_files;
+    EXPECT_TRUE(coordinator.process_stream(temp_files));
+    writer.join();
+    EXPECT_GT(temp_files.size(), 1u);
+    WordCounter counter(nullptr);
+    EXPECT_EQ(counter.count_unique_words(temp_files), 7000u);
+}
+
+// Test: Small input files are batched into shared chunks and counted as one input.
+TEST(ChunkCoordinatorTest, BatchesSmallInputFiles) {
+    std::vector<TempFile> parts(40);
+    std::vector<InputFile> inputs;
+    std::string large;
+    for (size_t i = 0; i < 2000; ++i) {
+        large += "w" + std::to_string(i % 300) + " ";
+    }
+    for (size_t f = 0; f < 40; ++f) {
+        // Files end without a space, so a batch must not join the last and first words.
+        std::string content = f == 0 ? large : "s" + std::to_string(f) + " w" + std::to_string(f);
+        write_file(parts[f].name(), content);
+        inputs.push_back({std::make_unique<SyscallFileHandle>(parts[f].name().c_str(), O_RDONLY), content.size()});
+    }
+    ChunkCoordinator coordinator(std::move(inputs), std::make_unique<SpaceSeparatedParser>(), 4096);
+    std::vector<TempFile> temp_files;
+    EXPECT_TRUE(coordinator.process_chunks(temp_files));
+    // The large file needs a few chunks; the 39 small files and its tail share one batch.
+    EXPECT_LT(temp_files.size(), 10u);
+    WordCounter counter(nullptr);
+    EXPECT_EQ(counter.count_unique_words(temp_files), 300u + 39u);
+}
@@ -0,0 +1,105 @@
+// test_chunk_pipeline.cpp: Unit tests for the staged ChunkPipeline.
+// Verifies every chunk spills a sorted distinct run and the stage counters add up.
+
+#include "chunk_pipeline.hpp"
+#include "run_reader.hpp"
+#include "temp_file.hpp"
+#include "test_support.hpp"
+#include <gtest/gtest.h>
+#include <fcntl.h>
+#include <string>
+#include <unistd.h>
+#include <vector>
+
+// Test: Each chunk produces its own sorted distinct run.
+TEST(ChunkPipelineTest, SpillsEveryChunk) {
+    TempFile input;
+    std::string content = "pear fig pear apple fig kiwi kiwi date";
+    write_file(input.name(), content);
+    int fd = open(input.name().c_str(), O_RDONLY);
+    ASSERT_NE(fd, -1);
+
+    // Ranges cut at spaces: "pear fig pear" | " apple fig" | " kiwi kiwi date".
+    TempFile first, second, third;
+    std::vector<ChunkPipeline::Chunk> chunks = {
+        {0, 13, first.name()}, {13, 10, second.name()}, {23, content.size() - 23, third.name()}};
+    ChunkPipeline::Options options;
+    options.parse_workers = 2;
+    options.sort_workers = 2;
+    options.queue_capacity = 1;
+    ChunkPipeline pipeline(fd, options);
+    EXPECT_TRUE(pipeline.run(chunks));
+
+    EXPECT_EQ(read_run(first.name()), "fig\npear\n");
+    EXPECT_EQ(read_run(second.name()), "apple\nfig\n");
+    EXPECT_EQ(read_run(third.name()), "date\nkiwi\n");
+
+    close(fd);
+}
+
+// Test: Every stage sees every chunk and its bytes; words shrink to distinct ones.
+TEST(ChunkPipelineTest, StatsCountChunksPerStage) {
+    TempFile input;
+    std::string content;
+    for (int i = 0; i < 1000; ++i) {
+        content += "alpha beta gamma ";
+    }
+    write_file(input.name(), content);
+    int fd = open(input.name().c_str(), O_RDONLY);
+    ASSERT_NE(fd, -1);
+
+    // Four chunks of 4250 bytes each end exactly after a "gamma " triple.
+    std::vector<TempFile> runs(4);
+    std::vector<ChunkPipeline::Chunk> chunks;
+    const size_t chunk_size = content.size() / runs.size();
+    for (size_t i = 0; i < runs.size(); ++i) {
+        chunks.push_back({static_cast<off_t>(i * chunk_size), chunk_size, runs[i].name()});
+    }
+    ChunkPipeline pipeline(fd);
+    EXPECT_TRUE(pipeline.run(chunks));
+
+    auto stats = pipeline.stats();
+    ASSERT_EQ(stats.size(), 4u);
+    EXPECT_STREQ(stats[0].name, "read");
+    EXPECT_STREQ(stats[3].name, "spill");
+    for (const auto& stage : stats) {
+        EXPECT_EQ(stage.chunks, runs.size());
+        EXPECT_EQ(stage.bytes, content.size());
+        EXPECT_GE(stage.workers, 1u);
+    }
+    EXPECT_EQ(stats[1].words, 3 * runs.size());
+    EXPECT_EQ(stats[ChunkPipeline::PARSE].words_parsed, 3000u);
+    size_t run_bytes = 0;
+    for (const auto& run : runs) {
+        EXPECT_EQ(read_run(run.name()), "alpha\nbeta\ngamma\n");
+        std::ifstream in(run.name(), std::ios::binary | std::ios::ate);
+        run_bytes += static_cast<size_t>(in.tellg());
+    }
+    EXPECT_EQ(stats[ChunkPipeline::SPILL].bytes_written, run_bytes);
+
+    close(fd);
+}
+
+// Test: A run that cannot be written fails the whole run instead of leaving a gap.
+TEST(ChunkPipelineTest, FailsWhenSpillFails) {
+    TempFile input;
+    std::string content = "pear fig pear apple fig kiwi kiwi date";
+    write_file(input.name(), content);
+    int fd = open(input.name().c_str(), O_RDONLY);
+    ASSERT_NE(fd, -1);
+
+    TempFile first, third;
+    std::vector<ChunkPipeline::Chunk> chunks = {{0, 13, first.name()},
+                                                {13, 10, "missing_directory/run"},
+                                                {23, content.size() - 23, third.name()}};
+    ChunkPipeline::Options options;
+    options.max_in_flight = 1;
+    ChunkPipeline pipeline(fd, options);
+    EXPECT_FALSE(pipeline.run(chunks));
+    EXPECT_EQ(read_run(first.name()), "fig\npear\n");
+    // One chunk in flight: the third is never loaded once the second has failed.
+    EXPECT_EQ(pipeline.stats()[ChunkPipeline::SPILL].chunks, 2u);
+    EXPECT_EQ(pipeline.stats()[ChunkPipeline::READ].chunks, 2u);
+
+    close(fd);
+}
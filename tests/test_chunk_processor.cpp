@@ -0,0 +1,88 @@
+// test_chunk_processor.cpp: Unit tests for the ChunkProcessor class.
+// Verifies that a processed chunk is spilled as sorted, distinct words.
+
+#include "chunk_processor.hpp"
+#include "run_reader.hpp"
+#include "temp_file.hpp"
+#include "test_support.hpp"
+#include <gtest/gtest.h>
+#include <string>
+
+// Test: Repeated words are written once, in sorted order.
+TEST(ChunkProcessorTest, SpillsSortedDistinctWords) {
+    TempFile input;
+    write_file(input.name(), "dog cat dog ant cat dog");
+
+    TempFile run;
+    ChunkProcessor processor(std::make_unique<SyscallFileHandle>(input.name().c_str(), O_RDONLY),
+                             std::make_unique<SpaceSeparatedParser>());
+    processor.process(0, 23, run.name());
+    EXPECT_EQ(read_run(run.name()), "ant\ncat\ndog\n");
+}
+
+// Test: Counting runs store every distinct word once with its number of occurrences.
+TEST(ChunkProcessorTest, SpillsWordCounts) {
+    std::string text = "dog cat dog ant cat dog";
+    ChunkProcessor processor(nullptr, std::make_unique<SpaceSeparatedParser>());
+    std::vector<std::string_view> words;
+    ChunkProcessor::WordCounts counts;
+    processor.parse_counts(text.data(), text.size(), words, counts);
+    processor.sort(words);
+
+    TempFile run;
+    ASSERT_TRUE(ChunkProcessor::spill(words, run.name(), &counts));
+    RunReader reader(std::make_unique<SyscallFileHandle>(run.name().c_str(), O_RDONLY));
+    std::string result;
+    std::string_view word;
+    while (reader.next(word)) {
+        result += std::string(word) + "=" + std::to_string(reader.count()) + " ";
+    }
+    EXPECT_EQ(result, "ant=1 cat=2 dog=3 ");
+}
+
+// Test: Parsing replaces stale views in the output and counts every occurrence once.
+TEST(ChunkProcessorTest, ParsesIntoReusedVectors) {
+    std::string text = "dog cat dog ant cat dog";
+    ChunkProcessor processor(nullptr, std::make_unique<SpaceSeparatedParser>());
+    std::vector<std::string_view> words = {"stale", "views"};
+    processor.parse_distinct(text.data(), text.size(), words);
+    processor.sort(words);
+    EXPECT_EQ(words, (std::vector<std::string_view>{"ant", "cat", "dog"}));
+    EXPECT_EQ(processor.words_parsed(), 6u);
+
+    ChunkProcessor::WordCounts counts;
+    processor.parse_counts(text.data(), 7, words, counts);
+    EXPECT_EQ(words.size(), 2u);
+    EXPECT_EQ(counts.size(), 2u);
+    EXPECT_EQ(processor.words_parsed(), 8u);
+}
+
+// Test: Only the requested byte range is processed.
+TEST(ChunkProcessorTest, ProcessesRequestedRange) {
+    TempFile input;
+    write_file(input.name(), "zebra ant bee ant yak");
+
+    TempFile run;
+    ChunkProcessor processor(std::make_unique<SyscallFileHandle>(input.name().c_str(), O_RDONLY),
+                             std::make_unique<SpaceSeparatedParser>());
+    processor.process(5, 12, run.name());
+    EXPECT_EQ(read_run(run.name()), "ant\nbee\n");
+}
+
+// Test: Unmapped reads keep words intact across 1 MiB read blocks.
+TEST(ChunkProcessorTest, ReadPathKeepsWordsAcrossBlocks) {
+    TempFile input;
+    std::string content;
+    const char* vocabulary[] = {"apple", "banana", "cherry", "date", "elderberry"};
+    for (size_t i = 0; content.size() < (3u << 20); ++i) {
+        content += vocabulary[i % 5];
+        content += ' ';
+    }
+    write_file(input.name(), content);
+
+    TempFile run;
+    ChunkProcessor processor(std::make_unique<SyscallFileHandle>(input.name().c_str(), O_RDONLY),
+                             std::make_unique<SpaceSeparatedParser>());
+    processor.process(0, content.size(), run.name());
+    EXPECT_EQ(read_run(run.name()), "apple\nbanana\ncherry\ndate\nelderberry\n");
+}
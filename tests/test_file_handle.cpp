@@ -5,6 +5,7 @@
 #include <gtest/gtest.h>
 #include <fcntl.h>
 #include <unistd.h>
+#include <algorithm>
 #include <string>
 #include <fstream>
 
@@ -55,3 +56,210 @@ TEST(FileHandleTest, WritesToFile) {
 
     unlink(filename.c_str());
 }
+
+// Test: pread() reads at an absolute offset and leaves the file offset alone.
+TEST(FileHandleTest, PreadKeepsFileOffset) {
+    std::string filename = "pread_test.txt";
+    create_test_file(filename, "one two three");
+
+    SyscallFileHandle handle(filename.c_str(), O_RDONLY);
+    char buf[6] = {0};
+    EXPECT_EQ(handle.pread(buf, 5, 8), 5);
+    EXPECT_STREQ(buf, "three");
+    EXPECT_EQ(handle.pread(buf, 5, 13), 0);
+    EXPECT_EQ(handle.read(buf, 3), 3);
+    EXPECT_EQ(std::string(buf, 3), "one");
+
+    unlink(filename.c_str());
+}
+
+// Helper function: builds a patterned payload that reveals misplaced blocks.
+static std::string make_payload(size_t size) {
+    std::string payload(size, '\0');
+    for (size_t i = 0; i < size; ++i) {
+        payload[i] = static_cast<char>('a' + (i * 7 + i / 13) % 26);
+    }
+    return payload;
+}
+
+// Helper function: reads a handle from its current offset to the end in uneven pieces.
+static std::string read_all(FileHandle& handle) {
+    std::string result;
+    char buf[777];
+    ssize_t n;
+    while ((n = handle.read(buf, sizeof(buf))) > 0) {
+        result.append(buf, static_cast<size_t>(n));
+    }
+    EXPECT_EQ(n, 0);
+    return result;
+}
+
+// Test: DIRECT mode stages unaligned writes and serves unaligned reads through aligned buffers.
+TEST(FileHandleTest, DirectModeRoundTripsUnalignedTransfers) {
+    std::string filename = "direct_test.txt";
+    std::string payload = make_payload(3 * (1 << 20) + 1234);
+    {
+        SyscallFileHandle handle(filename.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0600);
+        if (!handle.set_cache_mode(CacheMode::DIRECT)) {
+            unlink(filename.c_str());
+            GTEST_SKIP() << "O_DIRECT is not supported here";
+        }
+        EXPECT_EQ(handle.cache_mode(), CacheMode::DIRECT);
+        for (size_t offset = 0; offset < payload.size(); offset += 1000) {
+            size_t n = std::min<size_t>(1000, payload.size() - offset);
+            EXPECT_EQ(handle.write(payload.data() + offset, n), static_cast<ssize_t>(n));
+        }
+        EXPECT_TRUE(handle.flush());
+
+        // Overwrite at an unaligned offset, then read everything back.
+        EXPECT_EQ(handle.seek(100, SEEK_SET), 100);
+        EXPECT_EQ(handle.write("XYZ", 3), 3);
+        payload.replace(100, 3, "XYZ");
+        EXPECT_EQ(handle.seek(0, SEEK_SET), 0);
+        EXPECT_EQ(read_all(handle), payload);
+
+        char buf[10];
+        EXPECT_EQ(handle.pread(buf, sizeof(buf), 5000), 10);
+        EXPECT_EQ(std::string(buf, 10), payload.substr(5000, 10));
+        EXPECT_EQ(handle.pread(buf, sizeof(buf), static_cast<off_t>(payload.size()) - 4), 4);
+        EXPECT_EQ(handle.pread(buf, sizeof(buf), static_cast<off_t>(payload.size())), 0);
+    }
+    SyscallFileHandle check(filename.c_str(), O_RDONLY);
+    EXPECT_EQ(read_all(check), payload);
+
+    unlink(filename.c_str());
+}
+
+// Test: DIRECT mode leaves the O_DIRECT flag of dup'd descriptors alone, and an unaligned
+// tail does not clear the handle's own flag.
+TEST(FileHandleTest, DirectModeKeepsSharedDescriptionFlags) {
+    std::string filename = "direct_dup_test.txt";
+    {
+        SyscallFileHandle handle(filename.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0600);
+        const int shared = ::dup(handle.get());
+        ASSERT_NE(shared, -1);
+        EXPECT_EQ(handle.write("abc", 3), 3);
+        if (!handle.set_cache_mode(CacheMode::DIRECT)) {
+            ::close(shared);
+            unlink(filename.c_str());
+            GTEST_SKIP() << "O_DIRECT is not supported here";
+        }
+        EXPECT_EQ(::fcntl(shared, F_GETFL) & O_DIRECT, 0);
+        EXPECT_EQ(handle.seek(0, SEEK_CUR), 3);
+        EXPECT_EQ(handle.write("defg", 4), 4);
+        EXPECT_TRUE(handle.flush());
+        EXPECT_NE(::fcntl(handle.get(), F_GETFL) & O_DIRECT, 0);
+        ::close(shared);
+    }
+    SyscallFileHandle check(filename.c_str(), O_RDONLY);
+    EXPECT_EQ(read_all(check), "abcdefg");
+
+    unlink(filename.c_str());
+}
+
+// Test: STREAM mode transfers the same bytes while releasing them from the page cache.
+TEST(FileHandleTest, StreamModeRoundTrips) {
+    std::string filename = "stream_test.txt";
+    std::string payload = make_payload(20 * (1 << 20) + 99);
+    {
+        SyscallFileHandle out(filename.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0600);
+        ASSERT_TRUE(out.set_cache_mode(CacheMode::STREAM));
+        for (size_t offset = 0; offset < payload.size(); offset += 1 << 20) {
+            size_t n = std::min<size_t>(1 << 20, payload.size() - offset);
+            EXPECT_EQ(out.write(payload.data() + offset, n), static_cast<ssize_t>(n));
+        }
+    }
+    SyscallFileHandle in(filename.c_str(), O_RDONLY);
+    ASSERT_TRUE(in.set_cache_mode(CacheMode::STREAM));
+    EXPECT_EQ(in.cache_mode(), CacheMode::STREAM);
+    EXPECT_EQ(read_all(in), payload);
+    char buf[5];
+    EXPECT_EQ(in.pread(buf, sizeof(buf), 12345), 5);
+    EXPECT_EQ(std::string(buf, 5), payload.substr(12345, 5));
+
+    unlink(filename.c_str());
+}
+
+// Test: A mapped window accepts STREAM but cannot bypass the page cache.
+TEST(MappedFileHandleTest, StreamModeKeepsView) {
+    std::string filename = "mapped_test.txt";
+    create_test_file(filename, "one two three");
+
+    SyscallFileHandle file(filename.c_str(), O_RDONLY);
+    MappedFileHandle mapped(file.get(), 4, 3);
+    ASSERT_TRUE(mapped.is_open());
+    EXPECT_FALSE(mapped.set_cache_mode(CacheMode::DIRECT));
+    EXPECT_TRUE(mapped.set_cache_mode(CacheMode::STREAM));
+    EXPECT_EQ(mapped.cache_mode(), CacheMode::STREAM);
+    const char* data = mapped.view(4, 3);
+    ASSERT_NE(data, nullptr);
+    EXPECT_EQ(std::string(data, 3), "two");
+
+    unlink(filename.c_str());
+}
+
+// Test: A mapped window exposes the file bytes at absolute offsets without copying.
+TEST(MappedFileHandleTest, ViewsMappedWindow) {
+    std::string filename = "mapped_test.txt";
+    create_test_file(filename, "one two three");
+
+    SyscallFileHandle file(filename.c_str(), O_RDONLY);
+    MappedFileHandle mapped(file.get(), 4, 3);
+    ASSERT_TRUE(mapped.is_open());
+    const char* data = mapped.view(4, 3);
+    ASSERT_NE(data, nullptr);
+    EXPECT_EQ(std::string(data, 3), "two");
+    EXPECT_EQ(mapped.view(0, 3), nullptr);
+    EXPECT_EQ(mapped.view(5, 3), nullptr);
+
+    unlink(filename.c_str());
+}
+
+// Test: read() and seek() on a mapped window behave like a bounded file.
+TEST(MappedFileHandleTest, ReadsAndSeeksWithinWindow) {
+    std::string filename = "mapped_test.txt";
+    create_test_file(filename, "one two three");
+
+    SyscallFileHandle file(filename.c_str(), O_RDONLY);
+    MappedFileHandle mapped(file.get(), 8, 5);
+    ASSERT_TRUE(mapped.is_open());
+    char buf[8] = {0};
+    EXPECT_EQ(mapped.read(buf, sizeof(buf)), 5);
+    EXPECT_STREQ(buf, "three");
+    EXPECT_EQ(mapped.read(buf, sizeof(buf)), 0);
+    EXPECT_EQ(mapped.seek(9, SEEK_SET), 9);
+    EXPECT_EQ(mapped.seek(0, SEEK_SET), -1);
+    EXPECT_EQ(mapped.write("x", 1), -1);
+
+    unlink(filename.c_str());
+}
+
+// Test: pread() on a mapped window uses absolute offsets and is bounded by the window.
+TEST(MappedFileHandleTest, PreadsWithinWindow) {
+    std::string filename = "mapped_test.txt";
+    create_test_file(filename, "one two three");
+
+    SyscallFileHandle file(filename.c_str(), O_RDONLY);
+    MappedFileHandle mapped(file.get(), 4, 7);
+    ASSERT_TRUE(mapped.is_open());
+    char buf[8] = {0};
+    EXPECT_EQ(mapped.pread(buf, sizeof(buf), 8), 3);
+    EXPECT_EQ(std::string(buf, 3), "thr");
+    EXPECT_EQ(mapped.pread(buf, sizeof(buf), 11), 0);
+    EXPECT_EQ(mapped.pread(buf, sizeof(buf), 0), -1);
+    EXPECT_EQ(mapped.read(buf, 3), 3);
+    EXPECT_EQ(std::string(buf, 3), "two");
+
+    unlink(filename.c_str());
+}
+
+// Test: Plain syscall handles do not expose a mapped view.
+TEST(MappedFileHandleTest, SyscallHandleHasNoView) {
+    std::string filename = "mapped_test.txt";
+    create_test_file(filename, "abc");
+
+    SyscallFileHandle handle(filename.c_str(), O_RDONLY);
+    EXPECT_EQ(handle.view(0, 3), nullptr);
+
+    unlink(filename.c_str());
+}
@@ -0,0 +1,60 @@
+// test_hyperloglog.cpp: Unit tests for the HyperLogLog cardinality sketch.
+// Checks estimates across cardinalities, duplicate insensitivity and sketch merging.
+
+#include "hyperloglog.hpp"
+#include <gtest/gtest.h>
+#include <cmath>
+#include <string>
+
+// Test: An empty sketch estimates zero.
+TEST(HyperLogLogTest, EmptySketchEstimatesZero) {
+    HyperLogLog sketch;
+    EXPECT_DOUBLE_EQ(sketch.estimate(), 0.0);
+}
+
+// Test: Estimates stay within four standard errors from tiny to large cardinalities.
+TEST(HyperLogLogTest, EstimatesWithinErrorBound) {
+    for (size_t distinct : {1u, 10u, 1000u, 20000u, 300000u}) {
+        HyperLogLog sketch;
+        for (size_t i = 0; i < distinct; ++i) {
+            sketch.add("w" + std::to_string(i));
+        }
+        const double error = std::fabs(sketch.estimate() - static_cast<double>(distinct));
+        EXPECT_LE(error, 4.0 * sketch.standard_error() * static_cast<double>(distinct) + 0.5) << distinct;
+    }
+}
+
+// Test: Adding words again does not change the estimate.
+TEST(HyperLogLogTest, DuplicatesDoNotChangeEstimate) {
+    HyperLogLog sketch;
+    for (size_t i = 0; i < 5000; ++i) {
+        sketch.add("w" + std::to_string(i));
+    }
+    const double before = sketch.estimate();
+    for (size_t i = 0; i < 5000; ++i) {
+        sketch.add("w" + std::to_string(i));
+    }
+    EXPECT_DOUBLE_EQ(sketch.estimate(), before);
+}
+
+// Test: Merging sketches of two halves equals the sketch of the whole.
+TEST(HyperLogLogTest, MergeEqualsUnion) {
+    HyperLogLog whole;
+    HyperLogLog left;
+    HyperLogLog right;
+    for (size_t i = 0; i < 10000; ++i) {
+        std::string word = "w" + std::to_string(i);
+        whole.add(word);
+        (i % 3 == 0 ? left : right).add(word);
+    }
+    EXPECT_TRUE(left.merge(right));
+    EXPECT_DOUBLE_EQ(left.estimate(), whole.estimate());
+    EXPECT_FALSE(left.merge(HyperLogLog(10)));
+}
+
+// Test: Precision is clamped to the supported range and sets the standard error.
+TEST(HyperLogLogTest, ClampsPrecision) {
+    EXPECT_EQ(HyperLogLog(0).precision(), HyperLogLog::MIN_PRECISION);
+    EXPECT_EQ(HyperLogLog(40).precision(), HyperLogLog::MAX_PRECISION);
+    EXPECT_NEAR(HyperLogLog(14).standard_error(), 1.04 / 128.0, 1e-12);
+}
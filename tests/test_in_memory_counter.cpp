@@ -0,0 +1,129 @@
+// test_in_memory_counter.cpp: Unit tests for the InMemoryCounter fast path.
+// Verifies in-memory counts and the spill-and-resume handoff to external sorting.
+
+#include "chunk_coordinator.hpp"
+#include "in_memory_counter.hpp"
+#include "test_support.hpp"
+#include "word_counter.hpp"
+#include <gtest/gtest.h>
+#include <string>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// Test: A small vocabulary is counted exactly without spilling.
+TEST(InMemoryCounterTest, CountsWithoutSpilling) {
+    std::string content = "a horse and a dog";
+    TempFile input;
+    const std::string& filename = write_file(input.name(), content);
+    InMemoryCounter counter(std::make_unique<SyscallFileHandle>(filename.c_str(), O_RDONLY), content.size(), 1ULL << 30, 4);
+    EXPECT_TRUE(counter.count());
+    EXPECT_EQ(counter.unique_count(), 4u);
+    EXPECT_EQ(counter.resume_offset(), static_cast<off_t>(content.size()));
+    EXPECT_EQ(counter.words_scanned(), 5u);
+    EXPECT_EQ(counter.bytes_scanned(), content.size());
+}
+
+// Test: Crossing the threshold spills the set and the external pass finishes exactly.
+TEST(InMemoryCounterTest, SpillsAndResumesExternally) {
+    std::string content;
+    for (size_t i = 0; i < 2000; ++i) {
+        content += "w";
+        for (size_t n = i % 500; ; n /= 26) {
+            content += static_cast<char>('a' + n % 26);
+            if (n < 26) {
+                break;
+            }
+        }
+        content += ' ';
+    }
+    TempFile input;
+    const std::string& filename = write_file(input.name(), content);
+
+    InMemoryCounter counter(std::make_unique<SyscallFileHandle>(filename.c_str(), O_RDONLY), content.size(), 64, 256);
+    ASSERT_FALSE(counter.count());
+    ASSERT_LT(counter.resume_offset(), static_cast<off_t>(content.size()));
+
+    std::vector<TempFile> temp_files;
+    temp_files.emplace_back();
+    ASSERT_TRUE(counter.spill(temp_files.back()));
+    ChunkCoordinator coordinator(std::make_unique<SyscallFileHandle>(filename.c_str(), O_RDONLY),
+                                 std::make_unique<SpaceSeparatedParser>(), content.size(), 1024);
+    std::vector<TempFile> chunk_files;
+    ASSERT_TRUE(coordinator.process_chunks(chunk_files, counter.resume_offset()));
+    for (auto& temp_file : chunk_files) {
+        temp_files.push_back(std::move(temp_file));
+    }
+    WordCounter word_counter(nullptr);
+    EXPECT_EQ(word_counter.count_unique_words(temp_files), 500u);
+}
+
+// Test: Several inputs are counted as one, and a spill resumes in the right input.
+TEST(InMemoryCounterTest, CountsSeveralInputs) {
+    std::vector<TempFile> parts(4);
+    std::vector<std::string> contents;
+    for (size_t f = 0; f < 4; ++f) {
+        std::string content;
+        for (size_t i = 0; i < 500; ++i) {
+            content += "f" + std::to_string(f) + "w" + std::to_string(i % 200) + " ";
+        }
+        write_file(parts[f].name(), content);
+        contents.push_back(content);
+    }
+    auto open_all = [&]() {
+        std::vector<InputFile> inputs;
+        for (size_t f = 0; f < parts.size(); ++f) {
+            inputs.push_back(
+                {std::make_unique<SyscallFileHandle>(parts[f].name().c_str(), O_RDONLY), contents[f].size()});
+        }
+        return inputs;
+    };
+
+    InMemoryCounter all(open_all(), 1ULL << 30, 1024);
+    EXPECT_TRUE(all.count());
+    EXPECT_EQ(all.unique_count(), 800u);
+
+    InMemoryCounter counter(open_all(), 64, 1024);
+    ASSERT_FALSE(counter.count());
+    std::vector<TempFile> temp_files;
+    temp_files.emplace_back();
+    ASSERT_TRUE(counter.spill(temp_files.back()));
+    ChunkCoordinator coordinator(open_all(), std::make_unique<SpaceSeparatedParser>(), 2048);
+    std::vector<TempFile> chunk_files;
+    ASSERT_TRUE(coordinator.process_chunks(chunk_files, counter.resume_offset(), counter.resume_input()));
+    for (auto& temp_file : chunk_files) {
+        temp_files.push_back(std::move(temp_file));
+    }
+    WordCounter word_counter(nullptr);
+    EXPECT_EQ(word_counter.count_unique_words(temp_files), 800u);
+}
+
+// Test: An unreadable chunk stops the count at that chunk instead of skipping it.
+TEST(InMemoryCounterTest, StopsAtUnreadableChunk) {
+    TempFile readable, unreadable;
+    write_file(readable.name(), "a b c ");
+    write_file(unreadable.name(), "d e f ");
+    std::vector<InputFile> inputs;
+    inputs.push_back({std::make_unique<SyscallFileHandle>(readable.name().c_str(), O_RDONLY), 6});
+    // A write-only descriptor can be neither mapped nor read.
+    inputs.push_back({std::make_unique<SyscallFileHandle>(unreadable.name().c_str(), O_WRONLY), 6});
+
+    InMemoryCounter counter(std::move(inputs), 1ULL << 30, 4);
+    EXPECT_FALSE(counter.count());
+    EXPECT_EQ(counter.unique_count(), 3u);
+    EXPECT_EQ(counter.resume_input(), 1u);
+    EXPECT_EQ(counter.resume_offset(), 0);
+}
+
+// Test: A run that cannot be opened is reported instead of being handed to the merge.
+TEST(InMemoryCounterTest, ReportsFailedSpill) {
+    TempFile input;
+    write_file(input.name(), "a b c d e f ");
+    InMemoryCounter counter(std::make_unique<SyscallFileHandle>(input.name().c_str(), O_RDONLY), 12, 1, 4);
+    EXPECT_FALSE(counter.count());
+
+    // A directory in the run's place cannot be opened for writing.
+    TempFile run;
+    ASSERT_EQ(mkdir(run.name().c_str(), 0700), 0);
+    EXPECT_FALSE(counter.spill(run));
+    rmdir(run.name().c_str());
+}
@@ -0,0 +1,101 @@
+// test_incremental_counter.cpp: Unit tests for the IncrementalCounter class.
+// Verifies dictionary creation, append-only updates and recounts of rewritten inputs.
+
+#include "incremental_counter.hpp"
+#include "temp_file.hpp"
+#include "test_support.hpp"
+#include <gtest/gtest.h>
+#include <set>
+#include <sstream>
+#include <string>
+
+// Helper function: counts an input against a dictionary.
+static size_t count_incrementally(const TempFile& input, const TempFile& dictionary, const std::string& content,
+                                  off_t& resume_offset) {
+    IncrementalCounter counter(std::make_unique<SyscallFileHandle>(input.name().c_str(), O_RDONLY), content.size(),
+                               dictionary.name());
+    EXPECT_TRUE(counter.count());
+    resume_offset = counter.resume_offset();
+    return counter.unique_count();
+}
+
+// Test: A first count creates the dictionary up to the last space and counts the last word apart.
+TEST(IncrementalCounterTest, CreatesDictionary) {
+    TempFile input, dictionary;
+    std::string content = "the cat and the hat";
+    write_file(input.name(), content);
+    off_t resume_offset;
+    EXPECT_EQ(count_incrementally(input, dictionary, content, resume_offset), 4u);
+    EXPECT_EQ(resume_offset, 0);
+
+    IncrementalCounter::State state;
+    ASSERT_TRUE(IncrementalCounter::read_state(dictionary.name(), state));
+    EXPECT_EQ(state.processed, 15u);
+    EXPECT_EQ(state.words, 3u);
+}
+
+// Test: Appends parse only the new bytes, and a last word that grows is counted once.
+TEST(IncrementalCounterTest, CountsAppendedBytes) {
+    TempFile input, dictionary;
+    std::string content = "alpha beta gam";
+    write_file(input.name(), content);
+    off_t resume_offset;
+    EXPECT_EQ(count_incrementally(input, dictionary, content, resume_offset), 3u);
+
+    write_file(input.name(), "ma delta ", true);
+    content += "ma delta ";
+    EXPECT_EQ(count_incrementally(input, dictionary, content, resume_offset), 4u);
+    EXPECT_EQ(resume_offset, 10);
+
+    write_file(input.name(), "alpha", true);
+    content += "alpha";
+    EXPECT_EQ(count_incrementally(input, dictionary, content, resume_offset), 4u);
+    EXPECT_EQ(resume_offset, 22);
+
+    // Nothing appended: the dictionary is reused as is.
+    EXPECT_EQ(count_incrementally(input, dictionary, content, resume_offset), 4u);
+    EXPECT_EQ(resume_offset, 22);
+}
+
+// Test: A rewritten or truncated input no longer matches the dictionary and is counted from the start.
+TEST(IncrementalCounterTest, RecountsRewrittenInput) {
+    TempFile input, dictionary;
+    std::string content = "one two three four five ";
+    write_file(input.name(), content);
+    off_t resume_offset;
+    EXPECT_EQ(count_incrementally(input, dictionary, content, resume_offset), 5u);
+
+    content = "six six six six six six six";
+    write_file(input.name(), content);
+    EXPECT_EQ(count_incrementally(input, dictionary, content, resume_offset), 1u);
+    EXPECT_EQ(resume_offset, 0);
+
+    content = "ten";
+    write_file(input.name(), content);
+    EXPECT_EQ(count_incrementally(input, dictionary, content, resume_offset), 1u);
+    EXPECT_EQ(resume_offset, 0);
+}
+
+// Test: Many appends of overlapping vocabularies give the same count as a full scan.
+TEST(IncrementalCounterTest, MatchesFullCountOverAppends) {
+    TempFile input, dictionary;
+    write_file(input.name(), "");
+    std::string content;
+    std::set<std::string> expected;
+    for (size_t round = 0; round < 8; ++round) {
+        std::ostringstream piece;
+        for (size_t i = 0; i < 3000; ++i) {
+            const size_t n = (round * 1237 + i * 7919) % 5000;
+            piece << 'w' << n << (i + 1 < 3000 || round % 2 == 0 ? " " : "");
+        }
+        write_file(input.name(), piece.str(), true);
+        content += piece.str();
+        std::istringstream words(content);
+        std::string word;
+        while (words >> word) {
+            expected.insert(word);
+        }
+        off_t resume_offset;
+        EXPECT_EQ(count_incrementally(input, dictionary, content, resume_offset), expected.size()) << "round " << round;
+    }
+}
@@ -0,0 +1,70 @@
+// test_input_files.cpp: Unit tests for multi-file input.
+// Verifies chunk claims across several files, glob expansion and manifest reading.
+
+#include "input_files.hpp"
+#include "temp_file.hpp"
+#include "test_support.hpp"
+#include <gtest/gtest.h>
+#include <string>
+#include <tuple>
+#include <unistd.h>
+#include <vector>
+
+// Helper function: opens files as an input list.
+static std::vector<InputFile> open_inputs(const std::vector<std::string>& names) {
+    std::vector<InputFile> inputs;
+    for (const auto& name : names) {
+        auto file = std::make_unique<SyscallFileHandle>(name.c_str(), O_RDONLY);
+        const size_t size = static_cast<size_t>(file->seek(0, SEEK_END));
+        inputs.push_back({std::move(file), size});
+    }
+    return inputs;
+}
+
+// Test: Chunks are claimed file after file, never span two files and skip empty files.
+TEST(InputFilesTest, CursorClaimsAcrossFiles) {
+    TempFile parts[3];
+    std::vector<std::string> names = {write_file(parts[0].name(), "alpha beta gamma"),
+                                      write_file(parts[1].name(), ""),
+                                      write_file(parts[2].name(), "delta epsilon")};
+    std::vector<InputFile> inputs = open_inputs(names);
+    InputCursor cursor(inputs, 6);
+    std::vector<std::tuple<size_t, off_t, size_t>> claims;
+    size_t input;
+    off_t start;
+    size_t size;
+    while (cursor.claim(input, start, size)) {
+        claims.emplace_back(input, start, size);
+    }
+    std::vector<std::tuple<size_t, off_t, size_t>> expected = {{0, 0, 10}, {0, 10, 6}, {2, 0, 13}};
+    EXPECT_EQ(claims, expected);
+    EXPECT_TRUE(cursor.done());
+    EXPECT_EQ(cursor.input(), 2u);
+    EXPECT_EQ(cursor.offset(), 13);
+
+    // A cursor resumed inside the first file continues from there.
+    InputCursor resumed(inputs, 100, 0, 10);
+    ASSERT_TRUE(resumed.claim(input, start, size));
+    EXPECT_EQ(std::make_tuple(input, start, size), std::make_tuple(size_t{0}, off_t{10}, size_t{6}));
+}
+
+// Test: Patterns expand to their sorted matches, plain names pass through and manifests list both.
+// The pattern needs known names, so these fixtures are not TempFiles and are unlinked at the end.
+TEST(InputFilesTest, ExpandsGlobsAndManifests) {
+    std::vector<std::string> parts = {write_file("input_glob_b.txt", "b"), write_file("input_glob_a.txt", "a")};
+    std::vector<std::string> names;
+    EXPECT_TRUE(expand_input_name("input_glob_*.txt", names));
+    EXPECT_TRUE(expand_input_name("plain.txt", names));
+    EXPECT_FALSE(expand_input_name("input_missing_*.txt", names));
+    EXPECT_EQ(names, (std::vector<std::string>{"input_glob_a.txt", "input_glob_b.txt", "plain.txt"}));
+
+    TempFile manifest_file;
+    const std::string& manifest = write_file(manifest_file.name(), "input_glob_b.txt\r\n\ninput_glob_?.txt\n");
+    names.clear();
+    EXPECT_TRUE(read_manifest(manifest.c_str(), names));
+    EXPECT_EQ(names, (std::vector<std::string>{"input_glob_b.txt", "input_glob_a.txt", "input_glob_b.txt"}));
+    EXPECT_FALSE(read_manifest("input_manifest_missing.txt", names));
+    for (const auto& name : parts) {
+        unlink(name.c_str());
+    }
+}
@@ -0,0 +1,168 @@
+// test_io_uring_file_handle.cpp: Unit tests for the IoUringFileHandle class.
+// Verifies read-ahead, write-behind and seeking with and without an io_uring ring.
+
+#include "io_uring_file_handle.hpp"
+#include "run_reader.hpp"
+#include "run_writer.hpp"
+#include "temp_file.hpp"
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+
+// Helper function: builds a patterned payload that reveals misplaced blocks.
+static std::string make_payload(size_t size) {
+    std::string payload(size, '\0');
+    for (size_t i = 0; i < size; ++i) {
+        payload[i] = static_cast<char>('a' + (i * 7 + i / 13) % 26);
+    }
+    return payload;
+}
+
+// Helper function: writes a payload in uneven pieces and reads it back in other pieces.
+static std::string round_trip(const std::string& payload, size_t depth, size_t block,
+                              CacheMode mode = CacheMode::BUFFERED) {
+    TempFile file;
+    {
+        IoUringFileHandle out(file.name().c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0600, depth, block);
+        EXPECT_TRUE(out.is_open());
+        EXPECT_TRUE(out.set_cache_mode(mode));
+        for (size_t offset = 0; offset < payload.size(); offset += 1000) {
+            size_t n = std::min<size_t>(1000, payload.size() - offset);
+            EXPECT_EQ(out.write(payload.data() + offset, n), static_cast<ssize_t>(n));
+        }
+        EXPECT_TRUE(out.flush());
+    }
+    IoUringFileHandle in(file.name().c_str(), O_RDONLY, 0, depth, block);
+    EXPECT_TRUE(in.set_cache_mode(mode));
+    std::string result;
+    char buffer[777];
+    ssize_t n;
+    while ((n = in.read(buffer, sizeof(buffer))) > 0) {
+        result.append(buffer, static_cast<size_t>(n));
+    }
+    EXPECT_EQ(n, 0);
+    return result;
+}
+
+// Test: Data spanning many blocks survives write-behind and read-ahead unchanged.
+TEST(IoUringFileHandleTest, RoundTripsAcrossBlocks) {
+    std::string payload = make_payload(300000);
+    EXPECT_EQ(round_trip(payload, 4, 4096), payload);
+    EXPECT_EQ(round_trip(payload, 1, 65536), payload);
+    EXPECT_EQ(round_trip(std::string(), 2, 4096), std::string());
+}
+
+// Test: Disabling io_uring falls back to blocking syscalls with the same results.
+TEST(IoUringFileHandleTest, FallsBackToSyscalls) {
+    IoUring::set_enabled(false);
+    TempFile file;
+    IoUringFileHandle handle(file.name().c_str(), O_RDWR | O_CREAT | O_TRUNC, 0600, 4, 4096);
+    EXPECT_FALSE(handle.async());
+    std::string payload = make_payload(10000);
+    IoUring::set_enabled(true);
+    EXPECT_EQ(round_trip(payload, 2, 4096), payload);
+    IoUring::set_enabled(false);
+    EXPECT_EQ(round_trip(payload, 2, 4096), payload);
+    IoUring::set_enabled(true);
+}
+
+// Test: seek() drains pending writes and restarts read-ahead at the new position.
+TEST(IoUringFileHandleTest, SeeksBetweenReadsAndWrites) {
+    if (!IoUring::available()) {
+        GTEST_SKIP() << "io_uring is not available";
+    }
+    TempFile file;
+    std::string payload = make_payload(50000);
+    IoUringFileHandle handle(file.name().c_str(), O_RDWR | O_CREAT | O_TRUNC, 0600, 3, 4096);
+    EXPECT_TRUE(handle.async());
+    EXPECT_EQ(handle.write(payload.data(), payload.size()), static_cast<ssize_t>(payload.size()));
+    EXPECT_EQ(handle.seek(0, SEEK_END), static_cast<off_t>(payload.size()));
+
+    EXPECT_EQ(handle.seek(20000, SEEK_SET), 20000);
+    char buffer[100];
+    EXPECT_EQ(handle.read(buffer, sizeof(buffer)), 100);
+    EXPECT_EQ(std::string(buffer, 100), payload.substr(20000, 100));
+    EXPECT_EQ(handle.seek(-50, SEEK_CUR), 20050);
+    EXPECT_EQ(handle.read(buffer, 10), 10);
+    EXPECT_EQ(std::string(buffer, 10), payload.substr(20050, 10));
+
+    // Overwrite in the middle, then read across the change.
+    EXPECT_EQ(handle.seek(100, SEEK_SET), 100);
+    EXPECT_EQ(handle.write("XYZ", 3), 3);
+    EXPECT_EQ(handle.seek(98, SEEK_SET), 98);
+    EXPECT_EQ(handle.read(buffer, 7), 7);
+    EXPECT_EQ(std::string(buffer, 7), payload.substr(98, 2) + "XYZ" + payload.substr(103, 2));
+}
+
+// Test: Runs written and read through io_uring handles round-trip through the run format.
+TEST(IoUringFileHandleTest, CarriesRuns) {
+    TempFile run;
+    std::vector<std::string> words;
+    for (int i = 0; i < 20000; ++i) {
+        words.push_back("word" + std::to_string(100000 + i));
+    }
+    {
+        RunWriter writer(std::make_unique<IoUringFileHandle>(run.name().c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0600,
+                                                             2, 4096),
+                         4096);
+        for (const auto& word : words) {
+            EXPECT_TRUE(writer.append(word));
+        }
+        EXPECT_TRUE(writer.finish());
+    }
+    RunReader reader(std::make_unique<IoUringFileHandle>(run.name().c_str(), O_RDONLY, 0, 2, 4096), 4096);
+    std::vector<std::string> result;
+    std::string_view word;
+    while (reader.next(word)) {
+        result.emplace_back(word);
+    }
+    EXPECT_EQ(result, words);
+}
+
+// Test: Consecutive positional reads stream through the window; jumps restart it.
+TEST(IoUringFileHandleTest, PreadsAtAbsoluteOffsets) {
+    TempFile file;
+    std::string payload = make_payload(40000);
+    {
+        SyscallFileHandle out(file.name().c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0600);
+        ASSERT_EQ(out.write(payload.data(), payload.size()), static_cast<ssize_t>(payload.size()));
+    }
+    IoUringFileHandle handle(file.name().c_str(), O_RDONLY, 0, 2, 4096);
+    std::string result;
+    char buffer[3000];
+    ssize_t n;
+    while ((n = handle.pread(buffer, sizeof(buffer), static_cast<off_t>(10000 + result.size()))) > 0) {
+        result.append(buffer, static_cast<size_t>(n));
+    }
+    EXPECT_EQ(result, payload.substr(10000));
+    EXPECT_EQ(handle.pread(buffer, 5, 123), 5);
+    EXPECT_EQ(std::string(buffer, 5), payload.substr(123, 5));
+}
+
+// Test: DIRECT and STREAM modes carry the same bytes; DIRECT reads start at aligned offsets.
+TEST(IoUringFileHandleTest, RoundTripsInCacheModes) {
+    TempFile probe;
+    SyscallFileHandle handle(probe.name().c_str(), O_RDWR | O_CREAT | O_TRUNC, 0600);
+    if (!handle.set_cache_mode(CacheMode::DIRECT)) {
+        GTEST_SKIP() << "O_DIRECT is not supported here";
+    }
+    std::string payload = make_payload(300000);
+    EXPECT_EQ(round_trip(payload, 4, 4096, CacheMode::DIRECT), payload);
+    EXPECT_EQ(round_trip(payload, 2, 5000, CacheMode::DIRECT), payload);
+    EXPECT_EQ(round_trip(payload, 2, 4096, CacheMode::STREAM), payload);
+
+    TempFile file;
+    {
+        SyscallFileHandle out(file.name().c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0600);
+        ASSERT_EQ(out.write(payload.data(), payload.size()), static_cast<ssize_t>(payload.size()));
+    }
+    IoUringFileHandle in(file.name().c_str(), O_RDONLY, 0, 2, 4096);
+    ASSERT_TRUE(in.set_cache_mode(CacheMode::DIRECT));
+    char buffer[100];
+    EXPECT_EQ(in.pread(buffer, sizeof(buffer), 12345), 100);
+    EXPECT_EQ(std::string(buffer, 100), payload.substr(12345, 100));
+    EXPECT_EQ(in.seek(299990, SEEK_SET), 299990);
+    EXPECT_EQ(in.read(buffer, sizeof(buffer)), 10);
+    EXPECT_EQ(std::string(buffer, 10), payload.substr(299990));
+    EXPECT_EQ(in.read(buffer, sizeof(buffer)), 0);
+}
@@ -0,0 +1,79 @@
+// test_loser_tree.cpp: Unit tests for the LoserTree k-way merger.
+// Verifies sorted output across uneven, empty, and duplicate-heavy sources.
+
+#include "loser_tree.hpp"
+#include <gtest/gtest.h>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// VectorSource: In-memory Source yielding words from a sorted vector.
+struct VectorSource {
+    std::vector<std::string> words;
+    size_t index = 0;
+
+    bool next(std::string_view& word) noexcept {
+        if (index == words.size()) {
+            return false;
+        }
+        word = words[index++];
+        return true;
+    }
+};
+
+// Helper function: merges the given sources and returns the output sequence.
+static std::vector<std::string> merge_all(std::vector<VectorSource>& sources) {
+    std::vector<VectorSource*> pointers;
+    for (auto& source : sources) {
+        pointers.push_back(&source);
+    }
+    LoserTree<VectorSource> tree(std::move(pointers));
+    std::vector<std::string> merged;
+    while (!tree.empty()) {
+        merged.emplace_back(tree.top());
+        tree.pop();
+    }
+    return merged;
+}
+
+// Test: No sources means an empty tree.
+TEST(LoserTreeTest, NoSourcesIsEmpty) {
+    std::vector<VectorSource> sources;
+    EXPECT_TRUE(merge_all(sources).empty());
+}
+
+// Test: A single source is passed through unchanged.
+TEST(LoserTreeTest, SingleSourcePassesThrough) {
+    std::vector<VectorSource> sources(1);
+    sources[0].words = {"ant", "bee", "cat"};
+    EXPECT_EQ(merge_all(sources), (std::vector<std::string>{"ant", "bee", "cat"}));
+}
+
+// Test: Uneven and empty sources (non-power-of-two count) merge into sorted order.
+TEST(LoserTreeTest, MergesUnevenSources) {
+    std::vector<VectorSource> sources(5);
+    sources[0].words = {"b", "d", "f"};
+    sources[1].words = {};
+    sources[2].words = {"a", "z"};
+    sources[3].words = {"c", "d", "e", "y"};
+    sources[4].words = {"d"};
+    EXPECT_EQ(merge_all(sources),
+              (std::vector<std::string>{"a", "b", "c", "d", "d", "d", "e", "f", "y", "z"}));
+}
+
+// Test: top_source identifies which source supplied the current word.
+TEST(LoserTreeTest, ReportsWinningSource) {
+    std::vector<VectorSource> sources(3);
+    sources[0].words = {"m"};
+    sources[1].words = {"a"};
+    sources[2].words = {"z"};
+    std::vector<VectorSource*> pointers = {&sources[0], &sources[1], &sources[2]};
+    LoserTree<VectorSource> tree(std::move(pointers));
+    EXPECT_EQ(tree.top_source(), 1u);
+    tree.pop();
+    EXPECT_EQ(tree.top_source(), 0u);
+    tree.pop();
+    EXPECT_EQ(tree.top_source(), 2u);
+    tree.pop();
+    EXPECT_TRUE(tree.empty());
+}
@@ -41,3 +41,78 @@ TEST(ParserTest, HandlesExtraSpaces) {
     EXPECT_EQ(words[0], "hello");
     EXPECT_EQ(words[1], "world");
 }
+
+// Test: Words spanning 64-byte SIMD blocks match a byte-by-byte reference split.
+TEST(ParserTest, MatchesReferenceAcrossBlocks) {
+    std::string input;
+    unsigned state = 12345;
+    for (size_t i = 0; i < 5000; ++i) {
+        state = state * 1103515245u + 12345u;
+        input += ((state >> 16) % 4 == 0) ? ' ' : static_cast<char>('a' + (state >> 16) % 26);
+    }
+
+    for (size_t offset : {0, 1, 63, 64, 65}) {
+        std::vector<std::string> expected;
+        std::string current;
+        for (size_t i = offset; i < input.size(); ++i) {
+            if (input[i] == ' ') {
+                if (!current.empty()) {
+                    expected.push_back(current);
+                    current.clear();
+                }
+            } else {
+                current += input[i];
+            }
+        }
+        if (!current.empty()) {
+            expected.push_back(current);
+        }
+
+        SpaceSeparatedParser parser;
+        std::vector<std::string> words;
+        parser.parse(input.data() + offset, input.size() - offset, words);
+        EXPECT_EQ(words, expected) << "offset=" << offset << " scanner=" << SpaceSeparatedParser::scanner_name();
+    }
+}
+
+// Test: A word running through several full blocks is emitted once.
+TEST(ParserTest, ParsesWordLongerThanBlock) {
+    std::string word(200, 'q');
+    std::string input = " " + word + "  x";
+    SpaceSeparatedParser parser;
+    std::vector<std::string> words;
+    parser.parse(input.data(), input.size(), words);
+    ASSERT_EQ(words.size(), 2);
+    EXPECT_EQ(words[0], word);
+    EXPECT_EQ(words[1], "x");
+}
+
+// Test: The view overload points into the input buffer instead of copying words.
+TEST(ParserTest, ParsesViewsIntoBuffer) {
+    SpaceSeparatedParser parser;
+    std::vector<std::string_view> words;
+    const char* input = " one  two three ";
+    parser.parse(input, 16, words);
+    ASSERT_EQ(words.size(), 3);
+    EXPECT_EQ(words[0], "one");
+    EXPECT_EQ(words[1], "two");
+    EXPECT_EQ(words[2], "three");
+    EXPECT_EQ(words[0].data(), input + 1);
+}
+
+// Test: The set and count overloads see every word of a buffer longer than a block.
+TEST(ParserTest, CollectsDistinctWordsAndCounts) {
+    SpaceSeparatedParser parser;
+    std::string input;
+    for (int i = 0; i < 40; ++i) {
+        input += i % 2 == 0 ? "red " : "green ";
+    }
+    std::unordered_set<std::string_view> words;
+    EXPECT_EQ(parser.parse(input.data(), input.size(), words), 40u);
+    EXPECT_EQ(words, (std::unordered_set<std::string_view>{"red", "green"}));
+
+    std::unordered_map<std::string_view, uint64_t> counts;
+    EXPECT_EQ(parser.parse(input.data(), input.size(), counts), 40u);
+    EXPECT_EQ(counts["red"], 20u);
+    EXPECT_EQ(counts["green"], 20u);
+}
@@ -0,0 +1,113 @@
+// test_run_partition.cpp: Unit tests for key-range partitioning of sorted runs.
+// Verifies block slices around splitter keys and sampled splitter order.
+
+#include "run_partition.hpp"
+#include "run_reader.hpp"
+#include "run_writer.hpp"
+#include "temp_file.hpp"
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+
+// Helper function: writes words as a run in small blocks and loads its index.
+static run_format::RunIndex write_indexed_run(const TempFile& run, const std::vector<std::string>& words) {
+    {
+        RunWriter writer(std::make_unique<SyscallFileHandle>(run.name().c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0600),
+                         32);
+        for (const auto& word : words) {
+            writer.append(word);
+        }
+    }
+    SyscallFileHandle file(run.name().c_str(), O_RDONLY);
+    run_format::RunIndex index;
+    EXPECT_TRUE(run_format::read_run_index(file, index));
+    return index;
+}
+
+// Helper function: reads the words of a run slice.
+static std::vector<std::string> read_slice(const TempFile& run, off_t begin, off_t end) {
+    auto file = std::make_unique<SyscallFileHandle>(run.name().c_str(), O_RDONLY);
+    file->seek(begin, SEEK_SET);
+    RunReader reader(std::move(file), RunReader::DEFAULT_BLOCK_SIZE, static_cast<size_t>(end - begin));
+    std::vector<std::string> words;
+    std::string_view word;
+    while (reader.next(word)) {
+        words.emplace_back(word);
+    }
+    return words;
+}
+
+// Helper function: generates sorted words k100..k999.
+static std::vector<std::string> make_words() {
+    std::vector<std::string> words;
+    for (int i = 100; i < 1000; ++i) {
+        words.push_back("k" + std::to_string(i));
+    }
+    return words;
+}
+
+// Test: The slice for [key, ...) starts early enough to hold key and every larger word.
+TEST(RunPartitionTest, SliceBeginCoversKey) {
+    TempFile run;
+    auto index = write_indexed_run(run, make_words());
+    ASSERT_GT(index.blocks.size(), 4u);
+
+    for (std::string key : {"k100", "k250", "k2505", "k999", "k9999", "a", "z"}) {
+        auto slice = read_slice(run, slice_begin(index, key), index.data_end);
+        size_t expected = 0;
+        for (const auto& word : make_words()) {
+            expected += word >= key;
+        }
+        size_t found = 0;
+        for (const auto& word : slice) {
+            found += word >= key;
+        }
+        EXPECT_EQ(found, expected) << key;
+    }
+}
+
+// Test: The slice for [..., key) ends before any block starting at or above key.
+TEST(RunPartitionTest, SliceEndExcludesOnlyLargerBlocks) {
+    TempFile run;
+    auto index = write_indexed_run(run, make_words());
+    const off_t begin = index.blocks.front().offset;
+
+    for (std::string key : {"k100", "k250", "k2505", "k999", "z"}) {
+        auto slice = read_slice(run, begin, slice_end(index, key));
+        size_t expected = 0;
+        for (const auto& word : make_words()) {
+            expected += word < key;
+        }
+        size_t found = 0;
+        for (const auto& word : slice) {
+            found += word < key;
+        }
+        EXPECT_EQ(found, expected) << key;
+    }
+    EXPECT_EQ(slice_end(index, "a"), begin);
+    EXPECT_EQ(slice_end(index, "z"), index.data_end);
+}
+
+// Test: Splitters are strictly increasing and come from inside the runs' key range.
+TEST(RunPartitionTest, SamplesIncreasingSplitters) {
+    std::vector<TempFile> runs(2);
+    std::vector<run_format::RunIndex> indexes;
+    for (size_t r = 0; r < runs.size(); ++r) {
+        std::vector<std::string> words;
+        for (const auto& word : make_words()) {
+            if ((word.back() - '0') % 2 == static_cast<int>(r)) {
+                words.push_back(word);
+            }
+        }
+        indexes.push_back(write_indexed_run(runs[r], words));
+    }
+
+    auto splitters = sample_splitters(indexes, 4);
+    ASSERT_EQ(splitters.size(), 3u);
+    for (size_t i = 1; i < splitters.size(); ++i) {
+        EXPECT_LT(splitters[i - 1], splitters[i]);
+    }
+    EXPECT_GT(splitters.front(), "k100");
+    EXPECT_LT(splitters.back(), "k999");
+    EXPECT_TRUE(sample_splitters(indexes, 1).empty());
+}
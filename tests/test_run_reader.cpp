@@ -0,0 +1,139 @@
+// test_run_reader.cpp: Unit tests for the RunReader class.
+// Verifies block-buffered word decoding, including blocks larger than the buffer.
+
+#include "run_reader.hpp"
+#include "run_writer.hpp"
+#include "temp_file.hpp"
+#include <gtest/gtest.h>
+#include <fstream>
+#include <string>
+#include <unistd.h>
+#include <vector>
+
+// Helper function: writes words as a run with the given run block size.
+static void write_run(const TempFile& run, const std::vector<std::string>& words,
+                      size_t block_size = RunWriter::DEFAULT_BLOCK_SIZE) {
+    RunWriter writer(std::make_unique<SyscallFileHandle>(run.name().c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0600),
+                     block_size);
+    for (const auto& word : words) {
+        writer.append(word);
+    }
+}
+
+// Helper function: returns a reader over a run.
+static std::unique_ptr<RunReader> make_reader(const TempFile& run, size_t block_size) {
+    return std::make_unique<RunReader>(std::make_unique<SyscallFileHandle>(run.name().c_str(), O_RDONLY), block_size);
+}
+
+// Helper function: drains a reader into a vector of words.
+static std::vector<std::string> read_all(RunReader& reader) {
+    std::vector<std::string> words;
+    std::string_view word;
+    while (reader.next(word)) {
+        words.emplace_back(word);
+    }
+    return words;
+}
+
+// Test: An empty file and a run without words both yield no words.
+TEST(RunReaderTest, EmptyRunYieldsNothing) {
+    TempFile empty_file;
+    std::ofstream(empty_file.name()).close();
+    std::string_view word;
+    EXPECT_FALSE(make_reader(empty_file, RunReader::DEFAULT_BLOCK_SIZE)->next(word));
+
+    TempFile empty_run;
+    write_run(empty_run, {});
+    EXPECT_FALSE(make_reader(empty_run, RunReader::DEFAULT_BLOCK_SIZE)->next(word));
+}
+
+// Test: Words are returned in order, rebuilt from their shared prefixes.
+TEST(RunReaderTest, ReadsWordsInOrder) {
+    TempFile run;
+    write_run(run, {"ant", "anteater", "antelope", "bee", "cat"});
+    auto reader = make_reader(run, RunReader::DEFAULT_BLOCK_SIZE);
+    EXPECT_EQ(read_all(*reader), (std::vector<std::string>{"ant", "anteater", "antelope", "bee", "cat"}));
+    EXPECT_FALSE(reader->failed());
+}
+
+// Test: A tiny buffer forces refills and growth to hold whole run blocks.
+TEST(RunReaderTest, HandlesBlocksLargerThanBuffer) {
+    TempFile run;
+    std::vector<std::string> words = {"alpha", "bravo", "charlie", "supercalifragilistic"};
+    write_run(run, words, 16);
+    auto reader = make_reader(run, 3);
+    EXPECT_EQ(read_all(*reader), words);
+}
+
+// Test: A reader positioned at a block boundary reads just its slice.
+TEST(RunReaderTest, ReadsSliceOfBlocks) {
+    TempFile run;
+    std::vector<std::string> words;
+    for (int i = 100; i < 400; ++i) {
+        words.push_back("w" + std::to_string(i));
+    }
+    write_run(run, words, 64);
+
+    SyscallFileHandle index_file(run.name().c_str(), O_RDONLY);
+    run_format::RunIndex index;
+    ASSERT_TRUE(run_format::read_run_index(index_file, index));
+    ASSERT_GT(index.blocks.size(), 3u);
+    const auto& first = index.blocks[1];
+    const auto& last = index.blocks[3];
+
+    auto file = std::make_unique<SyscallFileHandle>(run.name().c_str(), O_RDONLY);
+    file->seek(first.offset, SEEK_SET);
+    RunReader reader(std::move(file), RunReader::DEFAULT_BLOCK_SIZE, static_cast<size_t>(last.offset - first.offset));
+    auto slice = read_all(reader);
+    ASSERT_FALSE(slice.empty());
+    EXPECT_EQ(slice.front(), first.first_word);
+    EXPECT_LT(slice.back(), last.first_word);
+    EXPECT_FALSE(reader.failed());
+
+    // A slice that ends inside a block has lost the rest of that block.
+    file = std::make_unique<SyscallFileHandle>(run.name().c_str(), O_RDONLY);
+    file->seek(first.offset, SEEK_SET);
+    RunReader cut(std::move(file), RunReader::DEFAULT_BLOCK_SIZE, static_cast<size_t>(last.offset - first.offset) - 1);
+    read_all(cut);
+    EXPECT_TRUE(cut.failed());
+}
+
+// Test: A run cut short inside a block or before its end marker fails instead of ending early.
+TEST(RunReaderTest, TruncatedRunFails) {
+    TempFile run;
+    std::vector<std::string> words;
+    for (int i = 100; i < 400; ++i) {
+        words.push_back("w" + std::to_string(i));
+    }
+    write_run(run, words, 64);
+    SyscallFileHandle index_file(run.name().c_str(), O_RDONLY);
+    run_format::RunIndex index;
+    ASSERT_TRUE(run_format::read_run_index(index_file, index));
+
+    // Cut right after the last block (before the end marker), then inside the third block.
+    for (off_t length : {index.data_end, index.blocks[2].offset + 5}) {
+        ASSERT_EQ(truncate(run.name().c_str(), length), 0);
+        auto reader = make_reader(run, RunReader::DEFAULT_BLOCK_SIZE);
+        const auto read = read_all(*reader);
+        EXPECT_TRUE(reader->failed()) << "length " << length;
+        EXPECT_LE(read.size(), words.size());
+    }
+}
+
+// Test: A file in another format is rejected rather than misread.
+TEST(RunReaderTest, RejectsUnknownFormat) {
+    TempFile run;
+    {
+        std::ofstream out(run.name());
+        out << "ant\nbee\ncat\n";
+    }
+    std::string_view word;
+    EXPECT_FALSE(make_reader(run, RunReader::DEFAULT_BLOCK_SIZE)->next(word));
+}
+
+// Test: A missing file behaves as an empty run.
+TEST(RunReaderTest, MissingFileYieldsNothing) {
+    RunReader reader(std::make_unique<SyscallFileHandle>("does_not_exist.tmp", O_RDONLY));
+    std::string_view word;
+    EXPECT_FALSE(reader.next(word));
+}
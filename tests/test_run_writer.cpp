@@ -0,0 +1,183 @@
+// test_run_writer.cpp: Unit tests for the RunWriter class.
+// Verifies that front-coded runs round-trip through RunReader and are indexed.
+
+#include "run_reader.hpp"
+#include "run_writer.hpp"
+#include "temp_file.hpp"
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+
+// Helper function: writes words with a given block size and reads them back.
+static std::vector<std::string> round_trip(const std::vector<std::string>& words, size_t block_size) {
+    TempFile run;
+    {
+        RunWriter writer(std::make_unique<SyscallFileHandle>(run.name().c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0600),
+                         block_size);
+        for (const auto& word : words) {
+            EXPECT_TRUE(writer.append(word));
+        }
+    }
+    RunReader reader(std::make_unique<SyscallFileHandle>(run.name().c_str(), O_RDONLY));
+    std::vector<std::string> result;
+    std::string_view word;
+    while (reader.next(word)) {
+        result.emplace_back(word);
+    }
+    return result;
+}
+
+// Test: Words survive a round trip, including flushes mid-run and oversized words.
+TEST(RunWriterTest, RoundTripsThroughRunReader) {
+    std::vector<std::string> words = {"ant", "bee", "caterpillar", "dragonfly", "earwig"};
+    EXPECT_EQ(round_trip(words, RunWriter::DEFAULT_BLOCK_SIZE), words);
+    EXPECT_EQ(round_trip(words, 8), words);
+}
+
+// Test: bytes_written counts the file header, block header and front-coded entries.
+TEST(RunWriterTest, CountsBytesWritten) {
+    TempFile run;
+    RunWriter writer(std::make_unique<SyscallFileHandle>(run.name().c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0600));
+    writer.append("abc");
+    writer.append("abde");
+    EXPECT_EQ(writer.bytes_written(), 0u);
+    EXPECT_TRUE(writer.flush());
+    // 8 + 8 + (1 + 1 + 3) + (1 + 1 + 2): the second word shares "ab".
+    EXPECT_EQ(writer.bytes_written(), 25u);
+    EXPECT_EQ(writer.words_written(), 2u);
+}
+
+// Test: Full blocks reach the file while a later block is still open, without growing the buffer.
+TEST(RunWriterTest, WritesBlocksBeforeFinish) {
+    TempFile run;
+    std::vector<std::string> words;
+    {
+        RunWriter writer(std::make_unique<SyscallFileHandle>(run.name().c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0600),
+                         4096);
+        for (int i = 100000; i < 120000; ++i) {
+            words.push_back("word" + std::to_string(i));
+            ASSERT_TRUE(writer.append(words.back()));
+        }
+        const size_t before_finish = writer.bytes_written();
+        EXPECT_GT(before_finish, 0u);
+        EXPECT_TRUE(writer.finish());
+        // Only the open block, the end marker and the index are left for finish().
+        EXPECT_GT(before_finish, writer.bytes_written() / 2);
+    }
+    RunReader reader(std::make_unique<SyscallFileHandle>(run.name().c_str(), O_RDONLY));
+    std::string_view word;
+    size_t i = 0;
+    while (reader.next(word)) {
+        ASSERT_LT(i, words.size());
+        EXPECT_EQ(word, words[i++]);
+    }
+    EXPECT_EQ(i, words.size());
+}
+
+// Test: Sorted words with shared prefixes take far less space than plain text.
+TEST(RunWriterTest, FrontCodingShrinksSortedRuns) {
+    TempFile run;
+    size_t text_bytes = 0;
+    RunWriter writer(std::make_unique<SyscallFileHandle>(run.name().c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0600));
+    for (int i = 10000; i < 20000; ++i) {
+        std::string word = "internationalization" + std::to_string(i);
+        text_bytes += word.size() + 1;
+        writer.append(word);
+    }
+    EXPECT_TRUE(writer.finish());
+    EXPECT_LT(writer.bytes_written() * 4, text_bytes);
+}
+
+// Test: The index lists every block with its first word, in order.
+TEST(RunWriterTest, IndexesBlocks) {
+    TempFile run;
+    std::vector<std::string> words;
+    for (int i = 100; i < 200; ++i) {
+        words.push_back("k" + std::to_string(i));
+    }
+    {
+        RunWriter writer(std::make_unique<SyscallFileHandle>(run.name().c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0600),
+                         32);
+        for (const auto& word : words) {
+            writer.append(word);
+        }
+    }
+    SyscallFileHandle file(run.name().c_str(), O_RDONLY);
+    run_format::RunIndex index;
+    ASSERT_TRUE(run_format::read_run_index(file, index));
+    ASSERT_GT(index.blocks.size(), 1u);
+    EXPECT_EQ(index.blocks.front().first_word, words.front());
+    EXPECT_EQ(index.blocks.front().offset, static_cast<off_t>(run_format::FILE_HEADER_SIZE));
+    for (size_t i = 1; i < index.blocks.size(); ++i) {
+        EXPECT_LT(index.blocks[i - 1].offset, index.blocks[i].offset);
+        EXPECT_LT(index.blocks[i - 1].first_word, index.blocks[i].first_word);
+    }
+    EXPECT_GT(index.data_end, index.blocks.back().offset);
+}
+
+// Test: A writer without an open file reports failure.
+TEST(RunWriterTest, ReportsUnopenedFile) {
+    RunWriter writer(std::make_unique<SyscallFileHandle>());
+    writer.append("abc");
+    EXPECT_FALSE(writer.flush());
+}
+
+// Test: Counting runs store each word's count, flag it in the header and index,
+// and decode from a block slice as well as from the start.
+TEST(RunWriterTest, RoundTripsWordCounts) {
+    TempFile run;
+    {
+        RunWriter writer(std::make_unique<SyscallFileHandle>(run.name().c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0600),
+                         64, true);
+        for (uint64_t i = 0; i < 200; ++i) {
+            writer.append("word" + std::to_string(1000 + i), i * i + 1);
+        }
+    }
+    RunReader reader(std::make_unique<SyscallFileHandle>(run.name().c_str(), O_RDONLY));
+    std::string_view word;
+    for (uint64_t i = 0; i < 200; ++i) {
+        ASSERT_TRUE(reader.next(word));
+        EXPECT_EQ(word, "word" + std::to_string(1000 + i));
+        EXPECT_EQ(reader.count(), i * i + 1);
+    }
+    EXPECT_FALSE(reader.next(word));
+
+    SyscallFileHandle file(run.name().c_str(), O_RDONLY);
+    run_format::RunIndex index;
+    ASSERT_TRUE(run_format::read_run_index(file, index));
+    EXPECT_EQ(index.flags, run_format::FLAG_COUNTS);
+    ASSERT_GT(index.blocks.size(), 2u);
+    auto slice = std::make_unique<SyscallFileHandle>(run.name().c_str(), O_RDONLY);
+    slice->seek(index.blocks[1].offset, SEEK_SET);
+    RunReader slice_reader(std::move(slice), 1024, static_cast<size_t>(index.data_end - index.blocks[1].offset), true);
+    ASSERT_TRUE(slice_reader.next(word));
+    EXPECT_EQ(word, index.blocks[1].first_word);
+    const uint64_t i = std::stoull(std::string(word.substr(4))) - 1000;
+    EXPECT_EQ(slice_reader.count(), i * i + 1);
+}
+
+// Test: A footer is stored between the index and the trailer, and readers skip it.
+TEST(RunWriterTest, StoresFooter) {
+    TempFile run;
+    {
+        RunWriter writer(std::make_unique<SyscallFileHandle>(run.name().c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0600));
+        writer.append("apple");
+        writer.append("pear");
+        EXPECT_TRUE(writer.finish("owner state"));
+    }
+    SyscallFileHandle file(run.name().c_str(), O_RDONLY);
+    run_format::RunIndex index;
+    ASSERT_TRUE(run_format::read_run_index(file, index));
+    ASSERT_EQ(index.blocks.size(), 1u);
+    std::string footer;
+    ASSERT_TRUE(run_format::read_run_footer(file, index, footer));
+    EXPECT_EQ(footer, "owner state");
+
+    RunReader reader(std::make_unique<SyscallFileHandle>(run.name().c_str(), O_RDONLY));
+    std::string_view word;
+    ASSERT_TRUE(reader.next(word));
+    EXPECT_EQ(word, "apple");
+    ASSERT_TRUE(reader.next(word));
+    EXPECT_EQ(word, "pear");
+    EXPECT_FALSE(reader.next(word));
+}
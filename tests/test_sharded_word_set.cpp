@@ -0,0 +1,63 @@
+// test_sharded_word_set.cpp: Unit tests for the ShardedWordSet class.
+// Verifies exact deduplication under concurrent inserts and memory tracking.
+
+#include "sharded_word_set.hpp"
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Test: Duplicate words within and across batches are stored once.
+TEST(ShardedWordSetTest, DeduplicatesAcrossBatches) {
+    ShardedWordSet set;
+    set.insert_batch({"a", "horse", "and", "a"});
+    set.insert_batch({"dog", "horse"});
+    EXPECT_EQ(set.size(), 4u);
+    auto words = set.words();
+    std::sort(words.begin(), words.end());
+    EXPECT_EQ(words, (std::vector<std::string_view>{"a", "and", "dog", "horse"}));
+}
+
+// Test: Stored words are copies and survive the caller's buffer.
+TEST(ShardedWordSetTest, CopiesInsertedWords) {
+    ShardedWordSet set;
+    {
+        std::string temporary = "ephemeral";
+        set.insert_batch({temporary});
+    }
+    EXPECT_EQ(set.words().front(), "ephemeral");
+    EXPECT_GT(set.memory_usage(), 0u);
+}
+
+// Test: Concurrent threads inserting overlapping vocabularies yield the exact union.
+TEST(ShardedWordSetTest, ConcurrentInsertsAreExact) {
+    ShardedWordSet set;
+    std::vector<std::string> vocabulary;
+    for (size_t i = 0; i < 5000; ++i) {
+        vocabulary.push_back("w" + std::to_string(i));
+    }
+    std::vector<std::thread> threads;
+    for (size_t t = 0; t < 4; ++t) {
+        threads.emplace_back([&set, &vocabulary, t]() {
+            std::vector<std::string_view> batch;
+            for (size_t i = t * 1000; i < t * 1000 + 2000; ++i) {
+                batch.emplace_back(vocabulary[i]);
+            }
+            set.insert_batch(batch);
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    EXPECT_EQ(set.size(), 5000u);
+}
+
+// Test: clear() empties the set and resets its memory estimate.
+TEST(ShardedWordSetTest, ClearReleasesWords) {
+    ShardedWordSet set;
+    set.insert_batch({"one", "two"});
+    set.clear();
+    EXPECT_EQ(set.size(), 0u);
+    EXPECT_EQ(set.memory_usage(), 0u);
+}
@@ -0,0 +1,97 @@
+// test_stats_report.cpp: Unit tests for the StatsReport class.
+// Verifies phases are credited with component counters and the JSON carries every section.
+
+#include "chunk_coordinator.hpp"
+#include "stats_report.hpp"
+#include "test_support.hpp"
+#include "word_counter.hpp"
+#include <gtest/gtest.h>
+#include <string>
+
+// Helper function: counts a file through the external path while recording phases.
+static size_t count_with_stats(const std::string& content, StatsReport& stats) {
+    TempFile input;
+    write_file(input.name(), content);
+    std::vector<TempFile> temp_files;
+    stats.begin_phase("chunks");
+    {
+        ChunkCoordinator coordinator(std::make_unique<SyscallFileHandle>(input.name().c_str(), O_RDONLY),
+                                     std::make_unique<SpaceSeparatedParser>(), content.size(), 64);
+        EXPECT_TRUE(coordinator.process_chunks(temp_files));
+        stats.add_pipeline(coordinator.stage_stats(), coordinator.planning_time());
+    }
+    stats.add_runs(temp_files);
+    stats.begin_phase("merge");
+    WordCounter counter(nullptr);
+    const size_t unique = counter.count_unique_words(temp_files);
+    stats.set_merge(counter.merge_stats());
+    stats.end_phase();
+    return unique;
+}
+
+// Test: The pipeline's bytes, words and runs and the merge's reads land in their phases.
+TEST(StatsReportTest, CreditsPhasesWithComponentCounters) {
+    std::string content;
+    for (int i = 0; i < 100; ++i) {
+        content += "red green blue ";
+    }
+    StatsReport stats;
+    EXPECT_EQ(count_with_stats(content, stats), 3u);
+
+    const auto& phases = stats.phases();
+    ASSERT_EQ(phases.size(), 2u);
+    EXPECT_EQ(phases[0].name, "chunks");
+    EXPECT_EQ(phases[0].bytes_read, content.size());
+    EXPECT_EQ(phases[0].words, 300u);
+    EXPECT_GE(phases[0].wall.count(), 0);
+
+    const StatsReport::RunStats runs = stats.runs();
+    EXPECT_GT(runs.count, 1u);
+    EXPECT_EQ(phases[0].bytes_written, runs.total_bytes);
+    EXPECT_LE(runs.min_bytes, runs.max_bytes);
+    EXPECT_EQ(phases[1].name, "merge");
+    EXPECT_EQ(phases[1].bytes_read, runs.total_bytes);
+    EXPECT_EQ(phases[1].bytes_written, 0u);
+}
+
+// Test: The JSON report is one balanced object with every section and the recorded phases.
+TEST(StatsReportTest, RendersEverySection) {
+    StatsReport stats;
+    count_with_stats("one two three two one ", stats);
+    const std::string json = stats.to_json(ThreadPool::shared().stats());
+
+    ASSERT_FALSE(json.empty());
+    EXPECT_EQ(json.front(), '{');
+    EXPECT_EQ(json.substr(json.size() - 2), "}\n");
+    int depth = 0;
+    for (char c : json) {
+        depth += (c == '{' || c == '[') - (c == '}' || c == ']');
+        EXPECT_GE(depth, 0);
+    }
+    EXPECT_EQ(depth, 0);
+    for (const char* key : {"\"wall_seconds\"", "\"cpu_seconds\"", "\"peak_rss_bytes\"", "\"phases\"", "\"pipeline\"",
+                            "\"planning_seconds\"", "\"stages\"", "\"runs\"", "\"merge\"", "\"threads\"",
+                            "\"utilization\"", "\"words_parsed\"", "\"bytes_rewritten\""}) {
+        EXPECT_NE(json.find(key), std::string::npos) << key;
+    }
+    EXPECT_NE(json.find("\"name\": \"chunks\""), std::string::npos);
+    EXPECT_NE(json.find("\"name\": \"spill\""), std::string::npos);
+    EXPECT_GT(StatsReport::peak_rss(), 0u);
+}
+
+// Test: Ending a phase twice keeps its first times, and the process CPU clock advances.
+TEST(StatsReportTest, EndsPhasesOnce) {
+    StatsReport stats;
+    const auto cpu_start = StatsReport::cpu_time();
+    stats.begin_phase("busy");
+    volatile size_t sum = 0;
+    for (size_t i = 0; i < 10000000; ++i) {
+        sum = sum + i;
+    }
+    stats.end_phase();
+    const auto wall = stats.phases().back().wall;
+    stats.end_phase();
+    EXPECT_EQ(stats.phases().back().wall, wall);
+    EXPECT_GT(stats.phases().back().cpu.count(), 0);
+    EXPECT_GT(StatsReport::cpu_time(), cpu_start);
+}
@@ -0,0 +1,92 @@
+// test_stream_chunker.cpp: Unit tests for the StreamChunker class.
+// Verifies that streams are cut into word-aligned chunks that add up to the whole input.
+
+#include "stream_chunker.hpp"
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <string>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+// Helper function: feeds content through a pipe in pieces of `piece` bytes.
+// Returns: A handle on the read end; the writer thread is joined by the caller.
+static SyscallFileHandle pipe_content(const std::string& content, size_t piece, std::thread& writer) {
+    int fds[2];
+    EXPECT_EQ(pipe(fds), 0);
+    writer = std::thread([content, piece, fd = fds[1]]() {
+        for (size_t offset = 0; offset < content.size(); offset += piece) {
+            ssize_t res = write(fd, content.data() + offset, std::min(piece, content.size() - offset));
+            (void)res;
+        }
+        close(fd);
+    });
+    return SyscallFileHandle(fds[0]);
+}
+
+// Helper function: reads every chunk and returns them in order.
+static std::vector<std::string> read_chunks(StreamChunker& chunker) {
+    std::vector<std::string> chunks;
+    WordArena arena;
+    size_t size = 0;
+    while (const char* data = chunker.next(arena, size)) {
+        chunks.emplace_back(data, size);
+    }
+    return chunks;
+}
+
+// Helper function: checks that the chunks add up to content and that no boundary splits a word.
+static void expect_word_aligned(const std::vector<std::string>& chunks, const std::string& content) {
+    std::string joined;
+    for (size_t i = 0; i < chunks.size(); ++i) {
+        EXPECT_FALSE(chunks[i].empty());
+        joined += chunks[i];
+        if (i + 1 < chunks.size()) {
+            EXPECT_TRUE(joined.back() == ' ' || content[joined.size()] == ' ') << "boundary " << joined.size();
+        }
+    }
+    EXPECT_EQ(joined, content);
+}
+
+// Test: Every chunk size, down to one byte, cuts only between words.
+TEST(StreamChunkerTest, ChunksAreWordAligned) {
+    std::string content = "alphabet soup alphabet zebra soup quiz alphabet";
+    for (size_t chunk_size = 1; chunk_size <= content.size() + 1; ++chunk_size) {
+        std::thread writer;
+        SyscallFileHandle input = pipe_content(content, content.size(), writer);
+        StreamChunker chunker(input, chunk_size);
+        expect_word_aligned(read_chunks(chunker), content);
+        EXPECT_FALSE(chunker.failed());
+        EXPECT_EQ(chunker.bytes_consumed(), content.size());
+        writer.join();
+    }
+}
+
+// Test: Short pipe reads and words longer than a chunk still produce whole words.
+TEST(StreamChunkerTest, ReadsShortPiecesAndLongWords) {
+    std::string content = "a " + std::string(200000, 'x') + " bb " + std::string(70000, 'y');
+    std::thread writer;
+    SyscallFileHandle input = pipe_content(content, 3001, writer);
+    StreamChunker chunker(input, 100);
+    std::vector<std::string> chunks = read_chunks(chunker);
+    expect_word_aligned(chunks, content);
+    writer.join();
+}
+
+// Test: peek() reads ahead without consuming, and an empty stream yields no chunks.
+TEST(StreamChunkerTest, PeeksWithoutConsuming) {
+    std::string content = "one two three four";
+    std::thread writer;
+    SyscallFileHandle input = pipe_content(content, 5, writer);
+    StreamChunker chunker(input, 8);
+    EXPECT_EQ(chunker.peek(6), "one tw");
+    EXPECT_EQ(chunker.peek(100), content);
+    expect_word_aligned(read_chunks(chunker), content);
+    writer.join();
+
+    std::thread empty_writer;
+    SyscallFileHandle empty = pipe_content("", 1, empty_writer);
+    StreamChunker empty_chunker(empty, 8);
+    EXPECT_TRUE(read_chunks(empty_chunker).empty());
+    empty_writer.join();
+}
@@ -0,0 +1,54 @@
+// test_string_sort.cpp: Unit tests for the string sorting engines.
+// Verifies that the MSD radix sort agrees with std::sort on varied inputs.
+
+#include "string_sort.hpp"
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <string>
+#include <vector>
+
+// Helper function: sorts a copy with each engine and checks they agree.
+static void expect_same_order(const std::vector<std::string>& input) {
+    std::vector<std::string_view> expected(input.begin(), input.end());
+    std::vector<std::string_view> actual(input.begin(), input.end());
+    sort_words(expected, SortAlgorithm::Std);
+    sort_words(actual, SortAlgorithm::MsdRadix);
+    EXPECT_EQ(actual, expected);
+}
+
+// Test: Empty and single-element inputs are left unchanged.
+TEST(StringSortTest, HandlesTrivialInputs) {
+    expect_same_order({});
+    expect_same_order({"solo"});
+}
+
+// Test: Prefixes, duplicates and shared stems sort like std::sort.
+TEST(StringSortTest, SortsPrefixesAndDuplicates) {
+    expect_same_order({"b", "ab", "a", "abc", "ab", "", "abd", "b", "ba", "aaaa", "aaa"});
+}
+
+// Test: A large random a-z input exercises the distribution passes.
+TEST(StringSortTest, MatchesStdSortOnRandomWords) {
+    std::vector<std::string> input;
+    unsigned state = 7;
+    for (size_t i = 0; i < 20000; ++i) {
+        std::string word;
+        state = state * 1103515245u + 12345u;
+        size_t length = 1 + (state >> 16) % 8;
+        for (size_t j = 0; j < length; ++j) {
+            state = state * 1103515245u + 12345u;
+            word += static_cast<char>('a' + (state >> 16) % 4);
+        }
+        input.push_back(word);
+    }
+    expect_same_order(input);
+}
+
+// Test: Words outside the a-z alphabet (e.g. "word17") still sort correctly.
+TEST(StringSortTest, FallsBackOutsideAlphabet) {
+    std::vector<std::string> input;
+    for (size_t i = 0; i < 500; ++i) {
+        input.push_back("word" + std::to_string((i * 37) % 1000));
+    }
+    expect_same_order(input);
+}
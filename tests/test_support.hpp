@@ -0,0 +1,42 @@
+#ifndef TEST_SUPPORT_HPP
+#define TEST_SUPPORT_HPP
+
+// test_support.hpp: Helpers shared by the unit tests.
+// Writes input fixtures and decodes runs back into text.
+
+#include "file_handle.hpp"
+#include "run_reader.hpp"
+#include <fcntl.h>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <string_view>
+
+// write_file: Writes content to a file.
+// Parameters:
+//   name: File to write, usually a TempFile's name so the fixture is deleted with it.
+//   content: Bytes to write.
+//   append: True to append instead of replacing the file.
+// Returns: The file name.
+inline const std::string& write_file(const std::string& name, const std::string& content, bool append = false) {
+    std::ofstream out(name, append ? std::ios::app : std::ios::trunc);
+    out << content;
+    return name;
+}
+
+// read_run: Decodes a run into newline-terminated words.
+// Parameters:
+//   name: Run file.
+// Returns: The run's words in file order, each followed by '\n'.
+inline std::string read_run(const std::string& name) {
+    RunReader reader(std::make_unique<SyscallFileHandle>(name.c_str(), O_RDONLY));
+    std::string words;
+    std::string_view word;
+    while (reader.next(word)) {
+        words.append(word.data(), word.size());
+        words += '\n';
+    }
+    return words;
+}
+
+#endif // TEST_SUPPORT_HPP
@@ -0,0 +1,71 @@
+// test_thread_pool.cpp: Unit tests for the ThreadPool class.
+// Verifies batch completion, work distribution, and statistics.
+
+#include "thread_pool.hpp"
+#include <gtest/gtest.h>
+#include <atomic>
+#include <thread>
+
+// Test: run_all returns only after every task in the batch has run.
+TEST(ThreadPoolTest, RunAllWaitsForBatch) {
+    ThreadPool pool(4);
+    std::atomic<size_t> sum{0};
+    std::vector<std::function<void()>> tasks;
+    for (size_t i = 1; i <= 100; ++i) {
+        tasks.emplace_back([&sum, i]() { sum += i; });
+    }
+    pool.run_all(std::move(tasks));
+    EXPECT_EQ(sum.load(), 5050u);
+}
+
+// Test: An empty batch returns immediately.
+TEST(ThreadPoolTest, RunAllEmptyBatch) {
+    ThreadPool pool(2);
+    pool.run_all({});
+    SUCCEED();
+}
+
+// Test: Statistics account for every executed task.
+TEST(ThreadPoolTest, StatsCountTasks) {
+    ThreadPool pool(3);
+    pool.run_all(std::vector<std::function<void()>>(30, []() {}));
+    auto stats = pool.stats();
+    ASSERT_EQ(stats.size(), 3u);
+    size_t executed = 0;
+    for (const auto& worker : stats) {
+        executed += worker.tasks_executed;
+        EXPECT_LE(worker.tasks_stolen, worker.tasks_executed);
+    }
+    EXPECT_EQ(executed, 30u);
+}
+
+// Test: Idle workers steal from a busy worker's deque.
+TEST(ThreadPoolTest, IdleWorkersSteal) {
+    ThreadPool pool(2);
+    std::atomic<size_t> done{0};
+    // Task 0 blocks worker 0 until every other task has finished elsewhere.
+    std::vector<std::function<void()>> tasks;
+    tasks.emplace_back([&]() {
+        while (done.load() < 9) {
+            std::this_thread::yield();
+        }
+    });
+    for (size_t i = 0; i < 9; ++i) {
+        tasks.emplace_back([&]() { ++done; });
+    }
+    pool.run_all(std::move(tasks));
+    auto stats = pool.stats();
+    EXPECT_GT(stats[0].tasks_stolen + stats[1].tasks_stolen, 0u);
+}
+
+// Test: Tasks submitted without a batch still run before the pool is destroyed.
+TEST(ThreadPoolTest, DestructorDrainsSubmittedTasks) {
+    std::atomic<size_t> count{0};
+    {
+        ThreadPool pool(2);
+        for (size_t i = 0; i < 50; ++i) {
+            pool.submit([&count]() { ++count; });
+        }
+    }
+    EXPECT_EQ(count.load(), 50u);
+}
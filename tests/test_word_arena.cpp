@@ -0,0 +1,38 @@
+// test_word_arena.cpp: Unit tests for the WordArena class.
+// Verifies that allocations stay valid and blocks are reused or added as needed.
+
+#include "word_arena.hpp"
+#include <gtest/gtest.h>
+#include <cstring>
+#include <string>
+
+// Test: Consecutive small allocations share one block and keep their contents.
+TEST(WordArenaTest, SmallAllocationsShareBlock) {
+    WordArena arena(64);
+    char* first = arena.allocate(5);
+    std::memcpy(first, "hello", 5);
+    char* second = arena.allocate(5);
+    std::memcpy(second, "world", 5);
+    EXPECT_EQ(second, first + 5);
+    EXPECT_EQ(std::string(first, 5), "hello");
+    EXPECT_EQ(arena.bytes_reserved(), 64u);
+}
+
+// Test: Requests larger than the block size get their own block.
+TEST(WordArenaTest, LargeAllocationGetsOwnBlock) {
+    WordArena arena(16);
+    arena.allocate(8);
+    char* large = arena.allocate(100);
+    std::memset(large, 'x', 100);
+    EXPECT_EQ(arena.bytes_reserved(), 116u);
+}
+
+// Test: Moving the arena keeps previously returned pointers valid.
+TEST(WordArenaTest, MovePreservesAllocations) {
+    WordArena arena(32);
+    char* data = arena.allocate(3);
+    std::memcpy(data, "abc", 3);
+    WordArena moved = std::move(arena);
+    EXPECT_EQ(std::string(data, 3), "abc");
+    EXPECT_EQ(moved.bytes_reserved(), 32u);
+}
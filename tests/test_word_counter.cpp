@@ -5,10 +5,32 @@
 #include "word_counter.hpp"
 #include "temp_file.hpp"
 #include "file_handle.hpp"
+#include "run_writer.hpp"
 #include <fstream>
 #include <string>
 #include <vector>
 #include <memory>
+#include <map>
+#include <set>
+
+// Helper function to write sorted words as a run.
+static void write_run(const TempFile& run, const std::vector<std::string>& words,
+                      size_t block_size = RunWriter::DEFAULT_BLOCK_SIZE) {
+    RunWriter writer(std::make_unique<SyscallFileHandle>(run.name().c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0600),
+                     block_size);
+    for (const auto& word : words) {
+        writer.append(word);
+    }
+}
+
+// Helper function to write sorted (word, count) pairs as a counting run.
+static void write_counted_run(const TempFile& run, const std::vector<std::pair<std::string, uint64_t>>& entries) {
+    RunWriter writer(std::make_unique<SyscallFileHandle>(run.name().c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0600),
+                     256, true);
+    for (const auto& entry : entries) {
+        writer.append(entry.first, entry.second);
+    }
+}
 
 // Helper function to write content to a temp file for test setup.
 static std::string write_test_file(const std::string& content) {
@@ -39,9 +61,7 @@ TEST(WordCounterTest, AllSameWordsReturnsOne) {
     std::string filename = write_test_file("dog\ndog\ndog\n");
     std::vector<TempFile> temp_files;
     TempFile temp;
-    std::ofstream out(temp.name());
-    out << "dog\ndog\ndog\n";
-    out.close();
+    write_run(temp, {"dog", "dog", "dog"});
     temp_files.push_back(std::move(temp));
 
     auto fd = std::make_unique<SyscallFileHandle>(filename.c_str(), O_RDONLY);
@@ -61,3 +81,141 @@ TEST(WordCounterTest, CannotOpenFile) {
     // We would mock this in advanced test setups.
     SUCCEED(); // Placeholder to show intent.
 }
+
+// Test case 4: Merging in parallel key ranges gives the same count as one merge.
+TEST(WordCounterTest, PartitionedMergeMatchesSingleMerge) {
+    // Three overlapping sorted runs over a shared vocabulary, in small blocks so the
+    // key ranges cut through the middle of runs.
+    std::vector<TempFile> temp_files(3);
+    std::set<std::string> all_words;
+    for (size_t r = 0; r < temp_files.size(); ++r) {
+        std::set<std::string> words;
+        for (size_t i = r; i < 3000; i += r + 1) {
+            words.insert("w" + std::to_string(i * 7919 % 5000));
+        }
+        write_run(temp_files[r], std::vector<std::string>(words.begin(), words.end()), 256);
+        all_words.insert(words.begin(), words.end());
+    }
+
+    for (size_t partitions : {1u, 2u, 3u, 8u, 64u}) {
+        WordCounter::Options options;
+        options.partitions = partitions;
+        WordCounter wc(nullptr, options);
+        EXPECT_EQ(wc.count_unique_words(temp_files), all_words.size()) << partitions << " partitions";
+    }
+}
+
+// Helper function to write overlapping sorted runs; returns their distinct words.
+static std::set<std::string> write_overlapping_runs(std::vector<TempFile>& temp_files) {
+    std::set<std::string> all_words;
+    for (size_t r = 0; r < temp_files.size(); ++r) {
+        std::set<std::string> words;
+        for (size_t i = r; i < 2000; i += r % 4 + 1) {
+            words.insert("w" + std::to_string(i * 7919 % 3000));
+        }
+        write_run(temp_files[r], std::vector<std::string>(words.begin(), words.end()), 256);
+        all_words.insert(words.begin(), words.end());
+    }
+    return all_words;
+}
+
+// Test case 5: More runs than the fan-in are merged in intermediate passes.
+TEST(WordCounterTest, CascadingMergeRespectsFanIn) {
+    std::vector<TempFile> temp_files(9);
+    std::set<std::string> all_words = write_overlapping_runs(temp_files);
+
+    WordCounter::Options options;
+    options.max_fan_in = 2;
+    WordCounter wc(nullptr, options);
+    EXPECT_EQ(wc.count_unique_words(temp_files), all_words.size());
+    // 9 -> 5 -> 3 -> 2 runs, then the final pass.
+    EXPECT_EQ(wc.merge_stats().runs, 9u);
+    EXPECT_EQ(wc.merge_stats().passes, 4u);
+    EXPECT_EQ(wc.merge_stats().intermediate_runs, 10u);
+    EXPECT_GT(wc.merge_stats().bytes_rewritten, 0u);
+    // Every pass reads its input runs: the originals, then each generation written.
+    EXPECT_GT(wc.merge_stats().bytes_read, wc.merge_stats().bytes_rewritten);
+}
+
+// Test case 6: A descriptor budget below the run count forces intermediate passes.
+TEST(WordCounterTest, CascadingMergeRespectsDescriptorBudget) {
+    std::vector<TempFile> temp_files(7);
+    std::set<std::string> all_words = write_overlapping_runs(temp_files);
+
+    WordCounter::Options options;
+    options.fd_budget = 3;
+    WordCounter wc(nullptr, options);
+    EXPECT_EQ(wc.count_unique_words(temp_files), all_words.size());
+    EXPECT_GT(wc.merge_stats().passes, 1u);
+}
+
+// Test case 7: Runs within the fan-in are counted in a single pass.
+TEST(WordCounterTest, RunsWithinFanInMergeInOnePass) {
+    std::vector<TempFile> temp_files(5);
+    std::set<std::string> all_words = write_overlapping_runs(temp_files);
+
+    WordCounter wc(nullptr);
+    EXPECT_EQ(wc.count_unique_words(temp_files), all_words.size());
+    EXPECT_EQ(wc.merge_stats().passes, 1u);
+    EXPECT_EQ(wc.merge_stats().bytes_rewritten, 0u);
+    size_t run_bytes = 0;
+    for (const auto& temp_file : temp_files) {
+        std::ifstream in(temp_file.name(), std::ios::binary | std::ios::ate);
+        run_bytes += static_cast<size_t>(in.tellg());
+    }
+    EXPECT_EQ(wc.merge_stats().bytes_read, run_bytes);
+}
+
+// Test case 8: Counts of a word are summed across runs, and the top-K list is ordered
+// by count with ties in word order.
+TEST(WordCounterTest, CountsFrequenciesAndTopK) {
+    std::vector<TempFile> temp_files(3);
+    write_counted_run(temp_files[0], {{"ant", 2}, {"bee", 5}, {"cat", 1}});
+    write_counted_run(temp_files[1], {{"bee", 1}, {"dog", 4}});
+    write_counted_run(temp_files[2], {{"ant", 2}, {"eel", 6}});
+
+    WordCounter wc(nullptr);
+    std::string visited;
+    auto report = wc.count_frequencies(temp_files, 3, [&](std::string_view word, uint64_t count) {
+        visited += std::string(word) + "=" + std::to_string(count) + " ";
+    });
+    EXPECT_EQ(visited, "ant=4 bee=6 cat=1 dog=4 eel=6 ");
+    EXPECT_EQ(report.unique_words, 5u);
+    EXPECT_EQ(report.total_words, 21u);
+    ASSERT_EQ(report.top.size(), 3u);
+    EXPECT_EQ(report.top[0].word, "bee");
+    EXPECT_EQ(report.top[0].count, 6u);
+    EXPECT_EQ(report.top[1].word, "eel");
+    EXPECT_EQ(report.top[2].word, "ant");
+    EXPECT_EQ(report.top[2].count, 4u);
+}
+
+// Test case 9: Intermediate passes keep the summed counts.
+TEST(WordCounterTest, CascadingMergeKeepsCounts) {
+    std::vector<TempFile> temp_files(7);
+    std::map<std::string, uint64_t> expected;
+    for (size_t r = 0; r < temp_files.size(); ++r) {
+        std::map<std::string, uint64_t> run;
+        for (size_t i = r; i < 500; i += r + 1) {
+            run["w" + std::to_string(i % 300)] += i % 7 + 1;
+        }
+        write_counted_run(temp_files[r], std::vector<std::pair<std::string, uint64_t>>(run.begin(), run.end()));
+        for (const auto& entry : run) {
+            expected[entry.first] += entry.second;
+        }
+    }
+
+    WordCounter::Options options;
+    options.max_fan_in = 2;
+    WordCounter wc(nullptr, options);
+    std::map<std::string, uint64_t> totals;
+    auto report = wc.count_frequencies(temp_files, 1, [&](std::string_view word, uint64_t count) {
+        totals[std::string(word)] = count;
+    });
+    EXPECT_GT(wc.merge_stats().passes, 1u);
+    EXPECT_EQ(totals, expected);
+    EXPECT_EQ(report.unique_words, expected.size());
+    // Counting runs still give the exact unique count through the partitioned merge.
+    options.partitions = 4;
+    EXPECT_EQ(WordCounter(nullptr, options).count_unique_words(temp_files), expected.size());
+}
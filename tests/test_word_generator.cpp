@@ -0,0 +1,119 @@
+// test_word_generator.cpp: Unit tests for the WordGenerator class.
+// Verifies reproducible output, exact unique counts, length limits and Zipf skew.
+
+#include "temp_file.hpp"
+#include "word_generator.hpp"
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <fstream>
+#include <map>
+#include <sstream>
+#include <string>
+
+// Helper function: generates into a file and returns its content.
+static std::string generate_content(WordGenerator& generator) {
+    TempFile file;
+    {
+        SyscallFileHandle output(file.name().c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0600);
+        EXPECT_TRUE(generator.generate(output));
+    }
+    std::ifstream in(file.name());
+    std::stringstream content;
+    content << in.rdbuf();
+    return content.str();
+}
+
+// Helper function: small options split into many blocks.
+static WordGenerator::Options small_options() {
+    WordGenerator::Options options;
+    options.vocabulary = 5000;
+    options.bytes = 1 << 20;
+    options.block_size = 16 << 10;
+    options.skew = 1.0;
+    return options;
+}
+
+// Test: The same seed writes the same bytes with any thread count; another seed does not.
+TEST(WordGeneratorTest, IsReproducibleAcrossThreadCounts) {
+    WordGenerator::Options options = small_options();
+    options.threads = 1;
+    WordGenerator single(options);
+    ASSERT_TRUE(single.valid());
+    const std::string expected = generate_content(single);
+    options.threads = 4;
+    WordGenerator parallel(options);
+    EXPECT_EQ(generate_content(parallel), expected);
+    options.seed = 2;
+    WordGenerator reseeded(options);
+    EXPECT_NE(generate_content(reseeded), expected);
+}
+
+// Test: The reported unique, word and byte counts match the written words, which stay within the lengths.
+TEST(WordGeneratorTest, ReportsExactCounts) {
+    WordGenerator::Options options = small_options();
+    options.min_length = 2;
+    options.max_length = 4;
+    options.length_weights = {0.0, 1.0, 3.0};
+    WordGenerator generator(options);
+    ASSERT_TRUE(generator.valid());
+    const std::string content = generate_content(generator);
+    EXPECT_EQ(content.find("  "), std::string::npos);
+    std::map<std::string, size_t> counts;
+    std::istringstream words(content);
+    std::string word;
+    size_t total = 0;
+    while (words >> word) {
+        EXPECT_GE(word.size(), 3u);
+        EXPECT_LE(word.size(), 4u);
+        EXPECT_TRUE(std::all_of(word.begin(), word.end(), [](char c) { return c >= 'a' && c <= 'z'; }));
+        ++counts[word];
+        ++total;
+    }
+    EXPECT_EQ(generator.unique_count(), counts.size());
+    EXPECT_EQ(generator.words_written(), total);
+    EXPECT_EQ(generator.bytes_written(), content.size());
+    EXPECT_GE(content.size(), options.bytes);
+    EXPECT_LT(content.size(), options.bytes + 64 * 5);
+}
+
+// Test: Word targets are met exactly, and skew concentrates the output on the top ranks.
+TEST(WordGeneratorTest, SkewsTowardsTopRanks) {
+    WordGenerator::Options options = small_options();
+    options.words = 100000;
+    options.skew = 1.2;
+    WordGenerator skewed(options);
+    const std::string content = generate_content(skewed);
+    EXPECT_EQ(skewed.words_written(), 100000u);
+    std::map<std::string, size_t> counts;
+    std::istringstream words(content);
+    std::string word;
+    while (words >> word) {
+        ++counts[word];
+    }
+    const auto& top = skewed.vocabulary();
+    EXPECT_GT(counts[top[0]], counts[top[1]]);
+    EXPECT_GT(counts[top[1]], counts[top[9]]);
+    // Rank 1 takes 1 / H(5000, 1.2) of the words, about 22%.
+    EXPECT_NEAR(static_cast<double>(counts[top[0]]) / 100000, 0.22, 0.02);
+    EXPECT_LT(skewed.unique_count(), options.vocabulary);
+
+    options.skew = 0.0;
+    WordGenerator uniform(options);
+    generate_content(uniform);
+    EXPECT_EQ(uniform.unique_count(), options.vocabulary);
+}
+
+// Test: Options the lengths cannot satisfy, or mismatched weights, are rejected.
+TEST(WordGeneratorTest, RejectsUnsatisfiableOptions) {
+    WordGenerator::Options options = small_options();
+    options.min_length = 1;
+    options.max_length = 1;
+    options.vocabulary = 14;
+    EXPECT_FALSE(WordGenerator(options).valid());
+    options.vocabulary = 13;
+    EXPECT_TRUE(WordGenerator(options).valid());
+    options.length_weights = {1.0, 2.0};
+    EXPECT_FALSE(WordGenerator(options).valid());
+    options.length_weights = {0.0};
+    EXPECT_FALSE(WordGenerator(options).valid());
+}